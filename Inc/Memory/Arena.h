@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <new>
+
+namespace Memory
+{
+	static constexpr std::size_t c_ArenaChunkSize = 64 * 1024;
+
+	// Bump pointer allocator, memory is only given back by rewinding to a marker or resetting the whole arena.
+	// Chunks are kept across rewinds, so an arena reused for the same work stops touching the heap after the first round.
+	struct Arena
+	{
+	public:
+		struct Marker
+		{
+			void*       Chunk;
+			std::size_t Used;
+		};
+
+	public:
+		explicit Arena(std::size_t chunkSize = c_ArenaChunkSize) noexcept
+			: m_ChunkSize(chunkSize),
+			  m_First(nullptr),
+			  m_Current(nullptr) {}
+
+		~Arena() noexcept;
+
+		Arena(const Arena&)            = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		// Returns nullptr when out of memory
+		void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+		Marker Mark() const noexcept;
+		// Frees everything allocated since marker was taken
+		void Rewind(const Marker& marker) noexcept;
+		void Reset() noexcept;
+		// Frees the chunks that are currently unused
+		void Trim() noexcept;
+
+		// Bytes held in chunks, used or not
+		std::size_t Capacity() const noexcept;
+
+	private:
+		struct Chunk;
+
+	private:
+		std::size_t m_ChunkSize;
+		Chunk*      m_First;
+		Chunk*      m_Current;
+	};
+
+	// Rewinds the arena to where it was when the scope was entered
+	struct ArenaScope
+	{
+	public:
+		explicit ArenaScope(Arena& arena) noexcept
+			: m_Arena(arena),
+			  m_Marker(arena.Mark()) {}
+
+		~ArenaScope() noexcept { m_Arena.Rewind(m_Marker); }
+
+		ArenaScope(const ArenaScope&)            = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+	private:
+		Arena&        m_Arena;
+		Arena::Marker m_Marker;
+	};
+
+	// Arena owned by the calling thread, meant for scratch memory that does not outlive the call using it
+	Arena& ThreadArena() noexcept;
+
+	// Standard allocator on top of an arena, deallocation is left to the arena
+	template <class T>
+	struct ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+	public:
+		ArenaAllocator(Arena& arena) noexcept
+			: m_Arena(&arena) {}
+
+		template <class U>
+		ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+			: m_Arena(other.GetArena()) {}
+
+		T* allocate(std::size_t count)
+		{
+			void* ptr = m_Arena->Allocate(count * sizeof(T), alignof(T));
+			if (!ptr)
+				throw std::bad_alloc {};
+			return static_cast<T*>(ptr);
+		}
+
+		void deallocate(T*, std::size_t) noexcept {}
+
+		Arena* GetArena() const noexcept { return m_Arena; }
+
+		template <class U>
+		bool operator==(const ArenaAllocator<U>& other) const noexcept
+		{
+			return m_Arena == other.GetArena();
+		}
+
+	private:
+		Arena* m_Arena;
+	};
+} // namespace Memory
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Memory
+{
+	// Alignments have to be powers of two
+	constexpr std::uintptr_t AlignCeil(std::uintptr_t address, std::size_t alignment) noexcept
+	{
+		return (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+	}
+
+	constexpr std::uintptr_t AlignFloor(std::uintptr_t address, std::size_t alignment) noexcept
+	{
+		return address & ~static_cast<std::uintptr_t>(alignment - 1);
+	}
+
+	// Returns nullptr when out of memory, the block has to be released with AlignedFree using the same alignment
+	void* AlignedMalloc(std::size_t alignment, std::size_t size) noexcept;
+	void  AlignedFree(void* ptr, std::size_t alignment) noexcept;
+} // namespace Memory
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <new>
+
+namespace Memory
+{
+	static constexpr std::size_t  c_PoolMinSize    = 16;
+	static constexpr std::size_t  c_PoolMaxSize    = 4096;
+	static constexpr std::size_t  c_PoolSlabSize   = 64 * 1024;
+	static constexpr std::uint8_t c_PoolClassCount = 9;
+
+	// Size class allocator, every power of two from c_PoolMinSize to c_PoolMaxSize has a free list that is refilled a slab at a time.
+	// Blocks are aligned to their class size up to 64 bytes, larger requests go straight to AlignedMalloc. Not thread safe.
+	struct Pool
+	{
+	public:
+		Pool() noexcept;
+		~Pool() noexcept;
+
+		Pool(const Pool&)            = delete;
+		Pool& operator=(const Pool&) = delete;
+
+		// Returns nullptr when out of memory
+		void* Allocate(std::size_t size) noexcept;
+		// size has to be the one the block was allocated with
+		void Deallocate(void* ptr, std::size_t size) noexcept;
+
+	private:
+		struct FreeBlock;
+		struct Slab;
+
+	private:
+		FreeBlock* m_FreeLists[c_PoolClassCount];
+		Slab*      m_Slabs;
+	};
+
+	// Standard allocator on top of a pool
+	template <class T>
+	struct PoolAllocator
+	{
+	public:
+		using value_type = T;
+
+	public:
+		PoolAllocator(Pool& pool) noexcept
+			: m_Pool(&pool) {}
+
+		template <class U>
+		PoolAllocator(const PoolAllocator<U>& other) noexcept
+			: m_Pool(other.GetPool()) {}
+
+		T* allocate(std::size_t count)
+		{
+			static_assert(alignof(T) <= 64, "Pool blocks are aligned to at most 64 bytes");
+			void* ptr = m_Pool->Allocate(count * sizeof(T));
+			if (!ptr)
+				throw std::bad_alloc {};
+			return static_cast<T*>(ptr);
+		}
+
+		void deallocate(T* ptr, std::size_t count) noexcept { m_Pool->Deallocate(ptr, count * sizeof(T)); }
+
+		Pool* GetPool() const noexcept { return m_Pool; }
+
+		template <class U>
+		bool operator==(const PoolAllocator<U>& other) const noexcept
+		{
+			return m_Pool == other.GetPool();
+		}
+
+	private:
+		Pool* m_Pool;
+	};
+} // namespace Memory
\ No newline at end of file
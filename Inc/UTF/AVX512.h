@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Base.h"
+
+namespace UTF::AVX512
+{
+#if defined(__x86_64__) || defined(_M_X64)
+	static constexpr bool c_Supported = true;
+#else
+	static constexpr bool c_Supported = false;
+#endif
+
+	EError CalcReqSize8To16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize8To32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize16To8(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize16To32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize32To8(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize32To16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+
+	EError ConvBlock8To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock8To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock16To8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock16To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock32To8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock32To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+
+	EError ConvBuffer8To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer8To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+} // namespace UTF::AVX512
\ No newline at end of file
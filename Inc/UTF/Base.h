@@ -2,7 +2,12 @@
 
 #include "Build.h"
 
+#include <algorithm>
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <string>
 
 namespace UTF
 {
@@ -10,10 +15,12 @@ namespace UTF
 	{
 		UTF8 = 0,
 		UTF16,
-		UTF32
+		UTF32,
+		Latin1,
+		ASCII
 	};
 
-	static constexpr std::uint8_t c_EncodingCount = 3;
+	static constexpr std::uint8_t c_EncodingCount = 5;
 
 	enum class EError
 	{
@@ -21,7 +28,20 @@ namespace UTF
 		MissingImpl,
 		OOB,
 		InvalidLeading,
-		InvalidContinuation
+		InvalidContinuation,
+		OutputTooSmall,
+		FileError,
+		OutOfMemory
+	};
+
+	// Units of the single byte encodings. They are types of their own, so byte buffers aren't taken for Latin-1 or ASCII text.
+	// A Latin-1 unit is the codepoint itself, ASCII units from 0x80 on are invalid.
+	enum class Latin1Unit : unsigned char
+	{
+	};
+
+	enum class AsciiUnit : unsigned char
+	{
 	};
 
 	struct alignas(64) InputBlock
@@ -54,6 +74,18 @@ namespace UTF
 			using Type = char32_t;
 		};
 
+		template <>
+		struct CharType<EEncoding::Latin1>
+		{
+			using Type = Latin1Unit;
+		};
+
+		template <>
+		struct CharType<EEncoding::ASCII>
+		{
+			using Type = AsciiUnit;
+		};
+
 		template <EEncoding Encoding>
 		using CharTypeT = typename CharType<Encoding>::Type;
 
@@ -91,7 +123,139 @@ namespace UTF
 			static constexpr EEncoding Value = EEncoding::UTF32;
 		};
 
+		template <>
+		struct EncodingType<Latin1Unit>
+		{
+			static constexpr EEncoding Value = EEncoding::Latin1;
+		};
+
+		template <>
+		struct EncodingType<AsciiUnit>
+		{
+			static constexpr EEncoding Value = EEncoding::ASCII;
+		};
+
 		template <class C>
 		static constexpr EEncoding EncodingTypeV = EncodingType<C>::Value;
+
+		// Bits of a 64 bit word of Size byte units that are all clear when every unit is ASCII
+		template <std::size_t Size>
+		static constexpr std::uint64_t c_NonAsciiBits = Size == 1 ? 0x8080'8080'8080'8080 : (Size == 2 ? 0xFF80'FF80'FF80'FF80 : 0xFFFF'FF80'FFFF'FF80);
+
+		// Bits of a 64 bit word of Size byte units that are all clear when every unit is below Limit, a power of two.
+		// Zero when every unit of Size bytes is, which leaves nothing to check.
+		template <std::size_t Size, char32_t Limit>
+		static constexpr std::uint64_t c_LimitBits = (~0ULL >> (64 - 8 * Size) & ~static_cast<std::uint64_t>(Limit - 1)) * (~0ULL / (~0ULL >> (64 - 8 * Size)));
+
+		// Moves the ASCII units of word from lanes of From bytes to lanes of To bytes with shifts and masks.
+		// Widening reads the units from the low 8 * From / To bytes, narrowing leaves them in the low 8 * To / From bytes.
+		template <std::size_t From, std::size_t To>
+		constexpr std::uint64_t ResizeAsciiLanes(std::uint64_t word)
+		{
+			if constexpr (From == 1 && To == 2)
+			{
+				word = (word | word << 16) & 0x0000'FFFF'0000'FFFF;
+				return (word | word << 8) & 0x00FF'00FF'00FF'00FF;
+			}
+			else if constexpr (From == 1 && To == 4)
+			{
+				return (word | word << 24) & 0x0000'00FF'0000'00FF;
+			}
+			else if constexpr (From == 2 && To == 4)
+			{
+				return (word | word << 16) & 0x0000'FFFF'0000'FFFF;
+			}
+			else if constexpr (From == 2 && To == 1)
+			{
+				word = (word | word >> 8) & 0x0000'FFFF'0000'FFFF;
+				return (word | word >> 16) & 0xFFFF'FFFF;
+			}
+			else if constexpr (From == 4 && To == 1)
+			{
+				return (word | word >> 24) & 0xFFFF;
+			}
+			else
+			{
+				return (word | word >> 16) & 0xFFFF'FFFF;
+			}
+		}
+
+		// Character traits of the single byte units, units compare by their value
+		template <class C>
+		struct UnitTraits
+		{
+			using char_type           = C;
+			using int_type            = int;
+			using off_type            = std::streamoff;
+			using pos_type            = std::streampos;
+			using state_type          = std::mbstate_t;
+			using comparison_category = std::strong_ordering;
+
+			static constexpr void assign(char_type& lhs, const char_type& rhs) noexcept { lhs = rhs; }
+			static constexpr bool eq(char_type lhs, char_type rhs) noexcept { return lhs == rhs; }
+			static constexpr bool lt(char_type lhs, char_type rhs) noexcept { return lhs < rhs; }
+
+			static constexpr int compare(const char_type* lhs, const char_type* rhs, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					if (lhs[i] != rhs[i])
+						return lhs[i] < rhs[i] ? -1 : 1;
+				}
+				return 0;
+			}
+
+			static constexpr std::size_t length(const char_type* str) noexcept
+			{
+				std::size_t size = 0;
+				while (str[size] != char_type {})
+					++size;
+				return size;
+			}
+
+			static constexpr const char_type* find(const char_type* str, std::size_t count, const char_type& value) noexcept
+			{
+				const char_type* found = std::find(str, str + count, value);
+				return found != str + count ? found : nullptr;
+			}
+
+			static constexpr char_type* move(char_type* dest, const char_type* src, std::size_t count) noexcept
+			{
+				if (std::less<> {}(dest, src))
+					std::copy(src, src + count, dest);
+				else
+					std::copy_backward(src, src + count, dest + count);
+				return dest;
+			}
+
+			static constexpr char_type* copy(char_type* dest, const char_type* src, std::size_t count) noexcept
+			{
+				std::copy(src, src + count, dest);
+				return dest;
+			}
+
+			static constexpr char_type* assign(char_type* dest, std::size_t count, char_type value) noexcept
+			{
+				std::fill_n(dest, count, value);
+				return dest;
+			}
+
+			static constexpr char_type to_char_type(int_type value) noexcept { return static_cast<char_type>(value); }
+			static constexpr int_type  to_int_type(char_type value) noexcept { return static_cast<int_type>(value); }
+			static constexpr bool      eq_int_type(int_type lhs, int_type rhs) noexcept { return lhs == rhs; }
+			static constexpr int_type  eof() noexcept { return -1; }
+			static constexpr int_type  not_eof(int_type value) noexcept { return value == eof() ? 0 : value; }
+		};
 	} // namespace Details
-} // namespace UTF
\ No newline at end of file
+} // namespace UTF
+
+// std::char_traits is only provided for the standard character types
+template <>
+struct std::char_traits<UTF::Latin1Unit> : UTF::Details::UnitTraits<UTF::Latin1Unit>
+{
+};
+
+template <>
+struct std::char_traits<UTF::AsciiUnit> : UTF::Details::UnitTraits<UTF::AsciiUnit>
+{
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Base.h"
+
+namespace UTF::DFA
+{
+	EError CalcReqSize8To16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize8To32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+
+	EError ConvBlock8To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock8To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+
+	EError ConvBuffer8To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer8To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+} // namespace UTF::DFA
\ No newline at end of file
@@ -10,6 +10,30 @@ namespace UTF::Generic
 	EError CalcReqSize16To32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
 	EError CalcReqSize32To8(const void* input, std::size_t inputSize, std::size_t& requiredSize);
 	EError CalcReqSize32To16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	// Latin-1 and ASCII. ASCII is the same in both and in UTF-8, so AsciiTo8 also converts ASCII to Latin-1 and UTF-8 to ASCII.
+	EError CalcReqSizeLatin1To8(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize8ToLatin1(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeAsciiTo8(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeLatin1ToAscii(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeLatin1To16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeLatin1To32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeAsciiTo16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeAsciiTo32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize16ToLatin1(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize16ToAscii(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize32ToLatin1(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize32ToAscii(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+
+	// Lengths in output units without validating, a partial unit at the end is ignored. Invalid input gets a length that only depends on
+	// every unit on its own, the same on every impl.
+	EError Length8To16(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length8To32(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length16To8(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length16To32(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length32To8(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length32To16(const void* input, std::size_t inputSize, std::size_t& length);
+	// The other lengths from and to Latin-1 and ASCII are a unit per unit or the codepoint count
+	EError LengthLatin1To8(const void* input, std::size_t inputSize, std::size_t& length);
 
 	EError ConvBlock8To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
 	EError ConvBlock8To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
@@ -17,4 +41,51 @@ namespace UTF::Generic
 	EError ConvBlock16To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
 	EError ConvBlock32To8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
 	EError ConvBlock32To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockLatin1To8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock8ToLatin1(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockAsciiTo8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockLatin1ToAscii(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockLatin1To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockLatin1To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockAsciiTo16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockAsciiTo32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock16ToLatin1(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock16ToAscii(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock32ToLatin1(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock32ToAscii(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+
+	EError ConvBuffer8To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer8To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferLatin1To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer8ToLatin1(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferAsciiTo8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferLatin1ToAscii(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferLatin1To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferLatin1To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferAsciiTo16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferAsciiTo32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16ToLatin1(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16ToAscii(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32ToLatin1(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32ToAscii(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+
+	// Strict checks, overlong encodings, surrogates and codepoints past U+10FFFF are rejected. errorOffset is the byte offset of the first invalid sequence.
+	EError Validate8(const void* input, std::size_t inputSize, std::size_t& errorOffset);
+	EError Validate16(const void* input, std::size_t inputSize, std::size_t& errorOffset);
+	EError Validate32(const void* input, std::size_t inputSize, std::size_t& errorOffset);
+	// Every byte is Latin-1, ASCII rejects the bytes from 0x80 on
+	EError ValidateLatin1(const void* input, std::size_t inputSize, std::size_t& errorOffset);
+	EError ValidateAscii(const void* input, std::size_t inputSize, std::size_t& errorOffset);
+
+	// Adds stripes of 16 codepoints to the 8 lanes of the codepoint hash, round is how many stripes ago the lanes were last scrambled
+	EError HashStripes(std::uint64_t* lanes, const char32_t* codepoints, std::size_t stripes, std::size_t& round);
+
+	// Units at the start of narrow and wide that are the same ASCII character, size is the units each of them holds
+	EError AsciiMatch8To16(const void* narrow, const void* wide, std::size_t size, std::size_t& matched);
+	EError AsciiMatch8To32(const void* narrow, const void* wide, std::size_t size, std::size_t& matched);
+	EError AsciiMatch16To32(const void* narrow, const void* wide, std::size_t size, std::size_t& matched);
 } // namespace UTF::Generic
\ No newline at end of file
@@ -4,7 +4,11 @@
 
 namespace UTF::SIMD
 {
+#if defined(__x86_64__) || defined(_M_X64)
+	static constexpr bool c_Supported = true;
+#else
 	static constexpr bool c_Supported = false;
+#endif
 
 	EError CalcReqSize8To16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
 	EError CalcReqSize8To32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
@@ -12,6 +16,28 @@ namespace UTF::SIMD
 	EError CalcReqSize16To32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
 	EError CalcReqSize32To8(const void* input, std::size_t inputSize, std::size_t& requiredSize);
 	EError CalcReqSize32To16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	// Same pairs as the Generic Latin-1 and ASCII kernels
+	EError CalcReqSizeLatin1To8(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize8ToLatin1(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeAsciiTo8(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeLatin1ToAscii(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeLatin1To16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeLatin1To32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeAsciiTo16(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSizeAsciiTo32(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize16ToLatin1(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize16ToAscii(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize32ToLatin1(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	EError CalcReqSize32ToAscii(const void* input, std::size_t inputSize, std::size_t& requiredSize);
+
+	// Same lengths as Generic::Length8To16 and the others
+	EError Length8To16(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length8To32(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length16To8(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length16To32(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length32To8(const void* input, std::size_t inputSize, std::size_t& length);
+	EError Length32To16(const void* input, std::size_t inputSize, std::size_t& length);
+	EError LengthLatin1To8(const void* input, std::size_t inputSize, std::size_t& length);
 
 	EError ConvBlock8To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
 	EError ConvBlock8To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
@@ -19,4 +45,47 @@ namespace UTF::SIMD
 	EError ConvBlock16To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
 	EError ConvBlock32To8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
 	EError ConvBlock32To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockLatin1To8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock8ToLatin1(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockAsciiTo8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockLatin1ToAscii(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockLatin1To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockLatin1To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockAsciiTo16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlockAsciiTo32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock16ToLatin1(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock16ToAscii(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock32ToLatin1(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	EError ConvBlock32ToAscii(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+
+	EError ConvBuffer8To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer8To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferLatin1To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer8ToLatin1(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferAsciiTo8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferLatin1ToAscii(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferLatin1To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferLatin1To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferAsciiTo16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBufferAsciiTo32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16ToLatin1(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer16ToAscii(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32ToLatin1(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	EError ConvBuffer32ToAscii(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+
+	// Same strict checks as Generic::Validate8 and Generic::ValidateAscii
+	EError Validate8(const void* input, std::size_t inputSize, std::size_t& errorOffset);
+	EError ValidateAscii(const void* input, std::size_t inputSize, std::size_t& errorOffset);
+
+	// Same hash as Generic::HashStripes
+	EError HashStripes(std::uint64_t* lanes, const char32_t* codepoints, std::size_t stripes, std::size_t& round);
+
+	// Same matches as Generic::AsciiMatch8To16 and the others
+	EError AsciiMatch8To16(const void* narrow, const void* wide, std::size_t size, std::size_t& matched);
+	EError AsciiMatch8To32(const void* narrow, const void* wide, std::size_t size, std::size_t& matched);
+	EError AsciiMatch16To32(const void* narrow, const void* wide, std::size_t size, std::size_t& matched);
 } // namespace UTF::SIMD
\ No newline at end of file
@@ -1,22 +1,32 @@
 #pragma once
 
-#if false
+#include "AVX512.h"
+#include "Base.h"
+#include "DFA.h"
+#include "Generic.h"
+#include "Memory/Arena.h"
+#include "Memory/Memory.h"
+#include "SIMD.h"
 
-	#include "Base.h"
-	#include "Generic.h"
-	#include "Memory/Memory.h"
-	#include "SIMD.h"
-
-	#include <concepts>
-	#include <string>
-	#include <string_view>
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace UTF
 {
 	namespace Details
 	{
 		template <class T, class C>
-		concept String = std::same_as<T, std::basic_string<C>>;
+		concept String = std::same_as<T, std::basic_string<C, std::char_traits<C>, typename T::allocator_type>>;
 		template <class T, class C>
 		concept StringView = std::same_as<T, std::basic_string_view<C>>;
 
@@ -45,23 +55,99 @@ namespace UTF
 
 	using CalcReqSizeImplF = EError (*)(const void* input, std::size_t inputSize, std::size_t& requiredSize);
 	using ConvBlockImplF   = EError (*)(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+	using ConvBufferImplF  = EError (*)(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize);
+	using LengthImplF      = EError (*)(const void* input, std::size_t inputSize, std::size_t& length);
+	using ValidateImplF    = EError (*)(const void* input, std::size_t inputSize, std::size_t& errorOffset);
+	using HashImplF        = EError (*)(std::uint64_t* lanes, const char32_t* codepoints, std::size_t stripes, std::size_t& round);
+	using AsciiMatchImplF  = EError (*)(const void* narrow, const void* wide, std::size_t size, std::size_t& matched);
 
+	// DFA is not a tier Fastest picks from, it decodes UTF-8 with a state machine instead of classifying whole vectors of it.
+	// Conversions from the other encodings use the Generic kernels under it. Every impl rejects the same input.
 	enum class EImpl : std::uint8_t
 	{
 		Generic = 0,
 		SIMD    = 1,
+		AVX512  = 2,
+		DFA     = 3,
 		Fastest
 	};
 
-	static constexpr std::uint8_t c_ImplCount = 2;
+	// TwoPass runs CalcReqSize first to allocate the exact output, SinglePass allocates for the worst case and skips it.
+	// Parallel splits the input at codepoint boundaries and runs both passes over the chunks on separate threads.
+	enum class EConvertPolicy : std::uint8_t
+	{
+		Auto = 0,
+		TwoPass,
+		SinglePass,
+		Parallel
+	};
+
+	// Error stops at the first invalid sequence, Replace converts every maximal subpart of one to U+FFFD the way the WHATWG decoders do.
+	// Overlong encodings, surrogates and codepoints past U+10FFFF are invalid in every encoding they can appear in.
+	// Codepoints Latin-1 or ASCII can't hold are OOB errors converting to them, Replace converts them to '?' as there is no U+FFFD either.
+	enum class EErrorPolicy : std::uint8_t
+	{
+		Error = 0,
+		Replace
+	};
+
+	// Auto converts inputs shorter than this many bytes without the kernels, below one InputBlock they cost more to set up than they save.
+	// ASCII is copied a word at a time, past the ASCII prefix at most c_SmallMaxDecodeSize bytes are decoded one sequence at a time.
+	static constexpr std::size_t c_SmallMaxSize       = sizeof(InputBlock);
+	static constexpr std::size_t c_SmallMaxDecodeSize = 32;
+	// Auto converts inputs up to this many bytes in a single pass, past that the unused part of the worst case allocation gets too large
+	static constexpr std::size_t c_SinglePassMaxSize = 1024 * 1024;
+	// Auto converts inputs from this many bytes on in parallel, each thread gets at least c_ParallelChunkSize bytes
+	static constexpr std::size_t c_ParallelMinSize   = 4 * 1024 * 1024;
+	static constexpr std::size_t c_ParallelChunkSize = 1024 * 1024;
+	// ConvertFile converts this many input bytes at a time, which bounds both the output buffer and the mapped input kept resident
+	static constexpr std::size_t c_FileWindowSize = 4 * 1024 * 1024;
+	// ConvertBatch stages short inputs in buffers of this many bytes, inputs longer than c_BatchMaxStagedSize are converted on their own
+	static constexpr std::size_t c_BatchStageSize     = 16 * 1024;
+	static constexpr std::size_t c_BatchMaxStagedSize = 512;
+	// With EErrorPolicy::Replace, CalcReqSize sizes input the kernel rejected this many bytes at a time and only the chunks with errors a sequence at a time
+	static constexpr std::size_t c_ReplaceChunkSize = 1024;
+	// OffsetIndex samples the counts every this many bytes by default, which bounds what a translation counts after its binary search
+	static constexpr std::size_t c_OffsetSampleSize = 4096;
+
+	static constexpr std::uint8_t c_ImplCount = 4;
 	extern CalcReqSizeImplF       s_CalcReqSizeImpls[c_EncodingCount][c_EncodingCount][c_ImplCount];
 	extern ConvBlockImplF         s_ConvBlockImpls[c_EncodingCount][c_EncodingCount][c_ImplCount];
+	extern ConvBufferImplF        s_ConvBufferImpls[c_EncodingCount][c_EncodingCount][c_ImplCount];
+	extern LengthImplF            s_LengthImpls[c_EncodingCount][c_EncodingCount][c_ImplCount];
+	extern ValidateImplF          s_ValidateImpls[c_EncodingCount][c_ImplCount];
+	extern HashImplF              s_HashImpls[c_ImplCount];
+	extern AsciiMatchImplF        s_AsciiMatchImpls[c_EncodingCount][c_EncodingCount][c_ImplCount]; // Only from the narrower encoding to the wider one
 
 	EImpl GetFastestImpl();
+	// Highest tier the CPU supports, explicitly requested higher tiers run its kernels instead
+	EImpl GetSupportedImpl();
+
+	namespace Details
+	{
+		using ParallelTaskF = void (*)(void* userdata, std::size_t index);
+
+		std::size_t HardwareThreads();
+		// Calls task for every index below count on a pool of up to HardwareThreads() - 1 workers kept across calls and on the calling thread
+		void ParallelFor(std::size_t count, ParallelTaskF task, void* userdata);
+
+		template <class F>
+		void ParallelFor(std::size_t count, F& func)
+		{
+			ParallelFor(
+				count,
+				[](void* userdata, std::size_t index) { (*static_cast<F*>(userdata))(index); },
+				&func);
+		}
+
+		// Sizes input the way EErrorPolicy::Replace converts it, defined further down with the decoder it falls back to
+		template <EEncoding From, EEncoding To>
+		EError CalcReplacedSize(CalcReqSizeImplF callback, const void* input, std::size_t inputSize, std::size_t& requiredSize);
+	} // namespace Details
 
 	template <EEncoding From, EEncoding To>
 	requires(From != To)
-	EError CalcReqSize(const void* input, std::size_t inputSize, std::size_t& requiredSize, EImpl impl = EImpl::Fastest)
+	EError CalcReqSize(const void* input, std::size_t inputSize, std::size_t& requiredSize, EImpl impl = EImpl::Fastest, EErrorPolicy errorPolicy = EErrorPolicy::Error)
 	{
 		if (impl == EImpl::Fastest)
 			impl = GetFastestImpl();
@@ -69,7 +155,11 @@ namespace UTF
 		auto callback = s_CalcReqSizeImpls[static_cast<std::uint8_t>(From)][static_cast<std::uint8_t>(To)][static_cast<std::uint8_t>(impl)];
 		if (!callback)
 			return EError::MissingImpl;
-		return callback(input, inputSize, requiredSize);
+		// Valid input costs a single call either way
+		EError error = callback(input, inputSize, requiredSize);
+		if (error == EError::Success || errorPolicy == EErrorPolicy::Error)
+			return error;
+		return Details::CalcReplacedSize<From, To>(callback, input, inputSize, requiredSize);
 	}
 
 	template <EEncoding From, EEncoding To>
@@ -85,108 +175,1454 @@ namespace UTF
 		return callback(input, output, inputSize, outputSize);
 	}
 
+	// Converts inputSize / alignof(InputBlock) consecutive blocks in one call, input has to be aligned to alignof(InputBlock).
+	// readableSize is how many bytes can be read from input, output needs room for the converted blocks plus one OutputBlock.
+	// consumed and outputSize cover the blocks before the one that failed, so the caller can pick up from there.
+	template <EEncoding From, EEncoding To>
+	requires(From != To)
+	EError ConvBuffer(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize, EImpl impl = EImpl::Fastest)
+	{
+		if (impl == EImpl::Fastest)
+			impl = GetFastestImpl();
+
+		auto callback = s_ConvBufferImpls[static_cast<std::uint8_t>(From)][static_cast<std::uint8_t>(To)][static_cast<std::uint8_t>(impl)];
+		if (!callback)
+			return EError::MissingImpl;
+		return callback(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	// Length of input in To units once converted, without converting it. inputSize is in bytes, a partial unit at the end is ignored.
+	// Nothing is validated, invalid input gets a length that only depends on every unit on its own and is the same on every impl.
+	template <EEncoding From, EEncoding To>
+	std::size_t Length(const void* input, std::size_t inputSize, EImpl impl = EImpl::Fastest)
+	{
+		// Latin-1 and ASCII units are a codepoint each, only Latin-1 to UTF-8 and UTF-8 or UTF-16 to them need counting
+		constexpr bool c_FromByte = From == EEncoding::Latin1 || From == EEncoding::ASCII;
+		constexpr bool c_ToByte   = To == EEncoding::Latin1 || To == EEncoding::ASCII;
+		if constexpr (From == To || (c_FromByte && (To != EEncoding::UTF8 || From == EEncoding::ASCII)) || (c_ToByte && From == EEncoding::UTF32))
+		{
+			return inputSize / sizeof(Details::CharTypeT<From>);
+		}
+		else
+		{
+			if (impl == EImpl::Fastest)
+				impl = GetFastestImpl();
+
+			auto callback = s_LengthImpls[static_cast<std::uint8_t>(From)][static_cast<std::uint8_t>(To)][static_cast<std::uint8_t>(impl)];
+			if (!callback)
+				return 0;
+			std::size_t length = 0;
+			if (callback(input, inputSize, length) != EError::Success)
+				return 0;
+			return length;
+		}
+	}
+
+	template <class C1, class C2>
+	std::size_t Length(std::basic_string_view<C2> input, EImpl impl = EImpl::Fastest)
+	{
+		return Length<Details::EncodingTypeV<C2>, Details::EncodingTypeV<C1>>(input.data(), input.size() * sizeof(C2), impl);
+	}
+
+	// Codepoints in input, the same as its length in UTF-32
+	template <EEncoding Encoding>
+	std::size_t CountCodepoints(const void* input, std::size_t inputSize, EImpl impl = EImpl::Fastest)
+	{
+		return Length<Encoding, EEncoding::UTF32>(input, inputSize, impl);
+	}
+
+	template <class C>
+	std::size_t CountCodepoints(std::basic_string_view<C> input, EImpl impl = EImpl::Fastest)
+	{
+		return CountCodepoints<Details::EncodingTypeV<C>>(input.data(), input.size() * sizeof(C), impl);
+	}
+
+	struct ValidateResult
+	{
+		bool        Valid       = false;
+		std::size_t ErrorOffset = 0; // Byte offset of the first invalid sequence, inputSize when the input is valid
+	};
+
+	// Checks input without converting it, it rejects the same input the conversions reject
+	template <EEncoding Encoding>
+	ValidateResult Validate(const void* input, std::size_t inputSize, EImpl impl = EImpl::Fastest)
+	{
+		if (impl == EImpl::Fastest)
+			impl = GetFastestImpl();
+
+		auto callback = s_ValidateImpls[static_cast<std::uint8_t>(Encoding)][static_cast<std::uint8_t>(impl)];
+		if (!callback)
+			return {};
+		ValidateResult result;
+		result.Valid = callback(input, inputSize, result.ErrorOffset) == EError::Success;
+		return result;
+	}
+
+	namespace Details
+	{
+		std::uint64_t HashCodepoints(EEncoding encoding, const void* input, std::size_t inputSize, EImpl impl);
+	} // namespace Details
+
+	// Hash of the codepoints input decodes to, so the same text hashes the same in every encoding without being converted first.
+	// Invalid sequences hash as the U+FFFD EErrorPolicy::Replace converts them to. Not meant to hold up against collisions someone picks.
+	template <EEncoding Encoding>
+	std::uint64_t Hash(const void* input, std::size_t inputSize, EImpl impl = EImpl::Fastest)
+	{
+		return Details::HashCodepoints(Encoding, input, inputSize, impl);
+	}
+
+	template <class C>
+	std::uint64_t Hash(std::basic_string_view<C> input, EImpl impl = EImpl::Fastest)
+	{
+		return Hash<Details::EncodingTypeV<C>>(input.data(), input.size() * sizeof(C), impl);
+	}
+
+	namespace Details
+	{
+		int CompareCodepoints(EEncoding lhsEncoding, const void* lhs, std::size_t lhsSize, EEncoding rhsEncoding, const void* rhs, std::size_t rhsSize, EImpl impl);
+	} // namespace Details
+
+	// Orders lhs and rhs by the codepoints they decode to, without converting either of them. That is the order of UTF-8 and UTF-32 units,
+	// UTF-16 units order differently past the surrogates. Invalid sequences compare as the U+FFFD EErrorPolicy::Replace converts them to,
+	// so texts Equal says are the same also Hash the same.
+	template <EEncoding LhsEncoding, EEncoding RhsEncoding>
+	std::strong_ordering Compare(const void* lhs, std::size_t lhsSize, const void* rhs, std::size_t rhsSize, EImpl impl = EImpl::Fastest)
+	{
+		return Details::CompareCodepoints(LhsEncoding, lhs, lhsSize, RhsEncoding, rhs, rhsSize, impl) <=> 0;
+	}
+
+	template <class C1, class C2>
+	std::strong_ordering Compare(std::basic_string_view<C1> lhs, std::basic_string_view<C2> rhs, EImpl impl = EImpl::Fastest)
+	{
+		return Compare<Details::EncodingTypeV<C1>, Details::EncodingTypeV<C2>>(lhs.data(), lhs.size() * sizeof(C1), rhs.data(), rhs.size() * sizeof(C2), impl);
+	}
+
+	template <EEncoding LhsEncoding, EEncoding RhsEncoding>
+	bool Equal(const void* lhs, std::size_t lhsSize, const void* rhs, std::size_t rhsSize, EImpl impl = EImpl::Fastest)
+	{
+		return Details::CompareCodepoints(LhsEncoding, lhs, lhsSize, RhsEncoding, rhs, rhsSize, impl) == 0;
+	}
+
+	template <class C1, class C2>
+	bool Equal(std::basic_string_view<C1> lhs, std::basic_string_view<C2> rhs, EImpl impl = EImpl::Fastest)
+	{
+		return Equal<Details::EncodingTypeV<C1>, Details::EncodingTypeV<C2>>(lhs.data(), lhs.size() * sizeof(C1), rhs.data(), rhs.size() * sizeof(C2), impl);
+	}
+
+	namespace Details
+	{
+		// Largest output inputSize bytes of From can convert to, each unit is assumed to start a codepoint taking the most room in To
+		template <EEncoding From, EEncoding To>
+		constexpr std::size_t MaxOutputSize(std::size_t inputSize)
+		{
+			std::size_t units = (inputSize + sizeof(CharTypeT<From>) - 1) / sizeof(CharTypeT<From>);
+			if constexpr (To == EEncoding::Latin1 || To == EEncoding::ASCII)
+				return units;
+			else if constexpr (To == EEncoding::UTF32 || From == EEncoding::UTF32)
+				return 4 * units;
+			else if constexpr (To == EEncoding::UTF8 && (From == EEncoding::UTF16 || From == EEncoding::ASCII))
+				return 3 * units;
+			else
+				return 2 * units;
+		}
+
+		// Bytes at the start that finish a sequence begun before them, the kernels skip these
+		template <EEncoding From>
+		std::size_t LeadingTail(const std::uint8_t* bytes, std::size_t size)
+		{
+			std::size_t tail = 0;
+			if constexpr (From == EEncoding::UTF8)
+			{
+				while (tail < 3 && tail < size && (bytes[tail] & 0xC0) == 0x80)
+					++tail;
+			}
+			else if constexpr (From == EEncoding::UTF16)
+			{
+				char16_t unit = 0;
+				if (size >= sizeof(unit))
+					std::memcpy(&unit, bytes, sizeof(unit));
+				if ((unit & 0xFC00) == 0xDC00)
+					tail = sizeof(unit);
+			}
+			return tail;
+		}
+
+		// Moves bound back to the start of the sequence it cuts through, input has to be readable at bound
+		template <class C>
+		std::size_t SequenceStart(const C* input, std::size_t bound)
+		{
+			if constexpr (EncodingTypeV<C> == EEncoding::UTF8)
+			{
+				for (std::size_t back = 0; back < 3 && (input[bound] & 0xC0) == 0x80; ++back)
+					--bound;
+			}
+			else if constexpr (EncodingTypeV<C> == EEncoding::UTF16)
+			{
+				if ((input[bound] & 0xFC00) == 0xDC00)
+					--bound;
+			}
+			return bound;
+		}
+
+		// Units in the sequence started by unit, units that can't start one count as complete and are left for the kernels to reject
+		template <class C>
+		std::size_t SequenceLength(C unit)
+		{
+			if constexpr (EncodingTypeV<C> == EEncoding::UTF8)
+			{
+				if ((unit & 0xE0) == 0xC0)
+					return 2;
+				if ((unit & 0xF0) == 0xE0)
+					return 3;
+				if ((unit & 0xF8) == 0xF0)
+					return 4;
+				return 1;
+			}
+			else if constexpr (EncodingTypeV<C> == EEncoding::UTF16)
+			{
+				return (unit & 0xFC00) == 0xD800 ? 2 : 1;
+			}
+			else
+			{
+				return 1;
+			}
+		}
+
+		// Units at the end of input that belong to a sequence continuing past it
+		template <class C>
+		std::size_t IncompleteTail(std::basic_string_view<C> input)
+		{
+			for (std::size_t tail = 1; tail <= std::min<std::size_t>(input.size(), 3); ++tail)
+			{
+				C unit = input[input.size() - tail];
+				if constexpr (EncodingTypeV<C> == EEncoding::UTF8)
+				{
+					if ((unit & 0xC0) == 0x80)
+						continue;
+				}
+				return SequenceLength(unit) > tail ? tail : 0;
+			}
+			return 0;
+		}
+
+		// Units at the start of input below 0x80. Eight bytes are read at a time, the last read overlaps the one before it instead of reading past size.
+		template <class C>
+		std::size_t AsciiPrefix(const C* input, std::size_t size)
+		{
+			const std::uint8_t* bytes    = reinterpret_cast<const std::uint8_t*>(input);
+			std::size_t         byteSize = size * sizeof(C);
+			if (byteSize < 8)
+			{
+				std::size_t units = 0;
+				while (units < size && static_cast<std::make_unsigned_t<C>>(input[units]) < 0x80)
+					++units;
+				return units;
+			}
+			for (std::size_t offset = 0;; offset += 8)
+			{
+				std::size_t   at = std::min(offset, byteSize - 8);
+				std::uint64_t word;
+				std::memcpy(&word, bytes + at, 8);
+				word &= c_NonAsciiBits<sizeof(C)>;
+				if (word)
+					return (at + std::countr_zero(word) / 8) / sizeof(C);
+				if (at == byteSize - 8)
+					return size;
+			}
+		}
+
+		// Copies size ASCII units from input to output, a 64 bit word of the wider type at a time with the last word overlapping the one before it
+		template <class C1, class C2>
+		void CopyAscii(const C2* input, C1* output, std::size_t size)
+		{
+			constexpr std::size_t c_Step = 8 / std::max(sizeof(C1), sizeof(C2));
+
+			if constexpr (sizeof(C1) == sizeof(C2))
+			{
+				std::memcpy(output, input, size * sizeof(C1));
+				return;
+			}
+			if (size < c_Step)
+			{
+				for (std::size_t i = 0; i < size; ++i)
+					output[i] = static_cast<C1>(input[i]);
+				return;
+			}
+			for (std::size_t offset = 0;; offset += c_Step)
+			{
+				std::size_t   at   = std::min(offset, size - c_Step);
+				std::uint64_t word = 0;
+				std::memcpy(&word, input + at, c_Step * sizeof(C2));
+				word = ResizeAsciiLanes<sizeof(C2), sizeof(C1)>(word);
+				std::memcpy(output + at, &word, c_Step * sizeof(C1));
+				if (at == size - c_Step)
+					return;
+			}
+		}
+
+		// Whether codepoint has a unit in the encoding of C, only the single byte encodings end before U+10FFFF
+		template <class C>
+		constexpr bool Encodable(char32_t codepoint)
+		{
+			if constexpr (EncodingTypeV<C> == EEncoding::Latin1)
+				return codepoint < 0x100;
+			else if constexpr (EncodingTypeV<C> == EEncoding::ASCII)
+				return codepoint < 0x80;
+			else
+				return true;
+		}
+
+		// Encodes codepoint at output and returns the units written, output needs room for the longest sequence.
+		// Codepoints the single byte encodings can't hold are written as '?', which is what Replace converts them to.
+		template <class C>
+		std::size_t EncodeCodepoint(char32_t codepoint, C* output)
+		{
+			if constexpr (EncodingTypeV<C> == EEncoding::UTF8)
+			{
+				if (codepoint < 0x80)
+				{
+					output[0] = static_cast<C>(codepoint);
+					return 1;
+				}
+				if (codepoint < 0x800)
+				{
+					output[0] = static_cast<C>(0xC0 | (codepoint >> 6));
+					output[1] = static_cast<C>(0x80 | (codepoint & 0x3F));
+					return 2;
+				}
+				if (codepoint < 0x1'0000)
+				{
+					output[0] = static_cast<C>(0xE0 | (codepoint >> 12));
+					output[1] = static_cast<C>(0x80 | ((codepoint >> 6) & 0x3F));
+					output[2] = static_cast<C>(0x80 | (codepoint & 0x3F));
+					return 3;
+				}
+				output[0] = static_cast<C>(0xF0 | ((codepoint >> 18) & 0x07));
+				output[1] = static_cast<C>(0x80 | ((codepoint >> 12) & 0x3F));
+				output[2] = static_cast<C>(0x80 | ((codepoint >> 6) & 0x3F));
+				output[3] = static_cast<C>(0x80 | (codepoint & 0x3F));
+				return 4;
+			}
+			else if constexpr (EncodingTypeV<C> == EEncoding::UTF16)
+			{
+				if (codepoint < 0x1'0000)
+				{
+					output[0] = static_cast<C>(codepoint);
+					return 1;
+				}
+				codepoint -= 0x1'0000;
+				output[0]  = static_cast<C>(0xD800 | ((codepoint >> 10) & 0x3FF));
+				output[1]  = static_cast<C>(0xDC00 | (codepoint & 0x3FF));
+				return 2;
+			}
+			else
+			{
+				output[0] = static_cast<C>(Encodable<C>(codepoint) ? codepoint : U'?');
+				return 1;
+			}
+		}
+
+		// Decodes the codepoint starting at index and moves index past it, rejecting the same input the kernels reject. An invalid sequence
+		// decodes to U+FFFD with index moved past its maximal subpart, a leading unit with the units after it that could still have completed
+		// it or else a single unit. Overlong encodings, surrogates and codepoints past U+10FFFF are rejected on the byte after the leading byte.
+		template <class C>
+		EError DecodeSubpart(const C* input, std::size_t size, std::size_t& index, char32_t& codepoint)
+		{
+			using U = std::make_unsigned_t<C>;
+
+			U unit    = static_cast<U>(input[index++]);
+			codepoint = 0xFFFD;
+			if constexpr (EncodingTypeV<C> == EEncoding::UTF8)
+			{
+				if (unit < 0x80)
+				{
+					codepoint = unit;
+					return EError::Success;
+				}
+
+				std::size_t length = SequenceLength<C>(unit);
+				U           lower  = 0x80;
+				U           upper  = 0xBF;
+				if (length == 1 || unit < 0xC2 || unit > 0xF4)
+					return EError::InvalidLeading;
+				if (unit == 0xE0)
+					lower = 0xA0;
+				else if (unit == 0xED)
+					upper = 0x9F;
+				else if (unit == 0xF0)
+					lower = 0x90;
+				else if (unit == 0xF4)
+					upper = 0x8F;
+
+				char32_t decoded = unit & (0x7F >> length);
+				for (std::size_t i = 1; i < length; ++i)
+				{
+					// The unit that breaks the sequence is not part of the subpart, it is decoded again on its own
+					if (index >= size)
+						return EError::InvalidContinuation;
+					U continuation = static_cast<U>(input[index]);
+					if (continuation < lower || continuation > upper)
+						return EError::InvalidContinuation;
+					decoded = decoded << 6 | (continuation & 0x3F);
+					lower   = 0x80;
+					upper   = 0xBF;
+					++index;
+				}
+				codepoint = decoded;
+			}
+			else if constexpr (EncodingTypeV<C> == EEncoding::UTF16)
+			{
+				if ((unit & 0xFC00) == 0xDC00)
+					return EError::InvalidLeading;
+				if ((unit & 0xFC00) == 0xD800)
+				{
+					if (index >= size || (static_cast<U>(input[index]) & 0xFC00) != 0xDC00)
+						return EError::InvalidContinuation;
+					codepoint = ((unit & 0x3FF) << 10 | (static_cast<U>(input[index++]) & 0x3FF)) + 0x1'0000;
+				}
+				else
+				{
+					codepoint = unit;
+				}
+			}
+			else if constexpr (EncodingTypeV<C> == EEncoding::Latin1)
+			{
+				codepoint = unit;
+			}
+			else if constexpr (EncodingTypeV<C> == EEncoding::ASCII)
+			{
+				if (unit >= 0x80)
+					return EError::InvalidLeading;
+				codepoint = unit;
+			}
+			else
+			{
+				if (unit >= 0x11'0000 || (unit & 0xFFFF'F800) == 0xD800)
+					return EError::OOB;
+				codepoint = unit;
+			}
+			return EError::Success;
+		}
+
+		// The same as DecodeSubpart, except that index stays where an invalid sequence starts
+		template <class C>
+		EError DecodeCodepoint(const C* input, std::size_t size, std::size_t& index, char32_t& codepoint)
+		{
+			std::size_t start = index;
+			EError      error = DecodeSubpart(input, size, index, codepoint);
+			if (error != EError::Success)
+				index = start;
+			return error;
+		}
+
+		template <class C1, class C2>
+		using ConvertRangeF = EError (*)(const C2* input, std::size_t size, std::size_t& index, std::size_t end, C1* output, std::size_t& written);
+
+		// Converts a block the kernel rejected a sequence at a time, from index up to the last sequence starting before end.
+		// Replace converts invalid sequences to U+FFFD, and the units at end the kernel skips when it converts the block after it get one each.
+		// Otherwise index stops on the first invalid sequence, which may also be one of those units, or on a codepoint C1 can't hold.
+		// output needs room for every unit.
+		template <class C1, class C2, bool Replace>
+		EError ConvertRange(const C2* input, std::size_t size, std::size_t& index, std::size_t end, C1* output, std::size_t& written)
+		{
+			written = 0;
+			while (index < end)
+			{
+				std::size_t start     = index;
+				char32_t    codepoint = 0;
+				EError      error     = DecodeSubpart(input, size, index, codepoint);
+				if (!Replace && error == EError::Success && !Encodable<C1>(codepoint))
+					error = EError::OOB;
+				if (!Replace && error != EError::Success)
+				{
+					index = start;
+					return error;
+				}
+				written += EncodeCodepoint(codepoint, output + written);
+			}
+
+			std::size_t skipped = end + LeadingTail<EncodingTypeV<C2>>(reinterpret_cast<const std::uint8_t*>(input + end), (size - end) * sizeof(C2)) / sizeof(C2);
+			if (!Replace && index < skipped)
+				return EError::InvalidLeading;
+			for (; index < skipped; ++index)
+				written += EncodeCodepoint(char32_t { 0xFFFD }, output + written);
+			return EError::Success;
+		}
+
+		// Moves bound forward to a unit no maximal subpart continues into, input split there converts the same with replacements
+		template <class C>
+		std::size_t ReplaceBoundary(const C* input, std::size_t size, std::size_t bound)
+		{
+			if constexpr (EncodingTypeV<C> == EEncoding::UTF8)
+			{
+				while (bound < size && (input[bound] & 0xC0) == 0x80)
+					++bound;
+			}
+			else if constexpr (EncodingTypeV<C> == EEncoding::UTF16)
+			{
+				// A low surrogate after this one has no high surrogate in front of it either way
+				if (bound < size && (input[bound] & 0xFC00) == 0xDC00)
+					++bound;
+			}
+			return bound;
+		}
+
+		// Sizes c_ReplaceChunkSize bytes at a time, only the chunks callback rejects are sized a sequence at a time
+		template <EEncoding From, EEncoding To>
+		EError CalcReplacedSize(CalcReqSizeImplF callback, const void* input, std::size_t inputSize, std::size_t& requiredSize)
+		{
+			using C1 = CharTypeT<To>;
+			using C2 = CharTypeT<From>;
+
+			const C2*   units = static_cast<const C2*>(input);
+			std::size_t size  = inputSize / sizeof(C2);
+			requiredSize      = 0;
+			for (std::size_t offset = 0; offset < size;)
+			{
+				std::size_t end       = ReplaceBoundary(units, size, std::min(offset + c_ReplaceChunkSize / sizeof(C2), size));
+				std::size_t chunkSize = 0;
+				if (callback(units + offset, (end - offset) * sizeof(C2), chunkSize) != EError::Success)
+				{
+					C1 sequence[4 / sizeof(C1)];
+					chunkSize = 0;
+					for (std::size_t index = offset; index < end;)
+					{
+						char32_t codepoint = 0;
+						DecodeSubpart(units, end, index, codepoint);
+						chunkSize += EncodeCodepoint(codepoint, sequence) * sizeof(C1);
+					}
+				}
+				requiredSize += chunkSize;
+				offset        = end;
+			}
+			return EError::Success;
+		}
+
+		// Units valid input converts to, counted directly so it is cheap for short inputs where CalcReqSize costs more to set up.
+		// UTF-8 is read eight bytes at a time, input has to stay readable up to the next multiple of eight bytes past size.
+		template <EEncoding From, EEncoding To>
+		std::size_t OutputUnits(const CharTypeT<From>* input, std::size_t size)
+		{
+			std::size_t units = 0;
+			if constexpr (From == EEncoding::UTF8)
+			{
+				// Eight bytes at a time, every byte but a continuation byte (10xxxxxx) starts a codepoint and four byte leads (11110xxx)
+				// take a surrogate pair. The flags are summed with a multiply, without a popcnt target std::popcount is a library call.
+				auto count = [](std::uint64_t word, std::uint64_t mask) -> std::size_t {
+					std::uint64_t flags = (~word | (word << 1)) >> 7 & mask;
+					if constexpr (To == EEncoding::UTF16)
+						flags += (word & (word << 1) & (word << 2) & (word << 3)) >> 7 & mask;
+					return (flags * 0x0101'0101'0101'0101) >> 56;
+				};
+
+				std::size_t offset = 0;
+				for (; offset + 8 <= size; offset += 8)
+				{
+					std::uint64_t word;
+					std::memcpy(&word, input + offset, 8);
+					units += count(word, 0x0101'0101'0101'0101);
+				}
+				if (offset < size)
+				{
+					std::uint64_t word;
+					std::memcpy(&word, input + offset, 8);
+					units += count(word, 0x0101'0101'0101'0101 >> (64 - 8 * (size - offset)));
+				}
+			}
+			else if constexpr (From == EEncoding::UTF16)
+			{
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					char16_t unit = input[i];
+					if constexpr (To == EEncoding::UTF8)
+						units += unit < 0x80 ? 1 : (unit < 0x800 || (unit & 0xF800) == 0xD800 ? 2 : 3);
+					else
+						units += (unit & 0xFC00) != 0xDC00;
+				}
+			}
+			else
+			{
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					char32_t codepoint = static_cast<std::make_unsigned_t<CharTypeT<From>>>(input[i]);
+					if constexpr (To == EEncoding::UTF8)
+						units += codepoint < 0x80 ? 1 : (codepoint < 0x800 ? 2 : (codepoint < 0x10000 ? 3 : 4));
+					else
+						units += codepoint < 0x10000 ? 1 : 2;
+				}
+			}
+			return units;
+		}
+
+		// Converts as much of the input as fits in outputCapacity bytes, consumed ends on the first byte that was not converted.
+		// Kernels store whole vectors, so blocks only go straight to outputBuf while a whole OutputBlock still fits behind them.
+		// Blocks the kernels reject are converted again by convertRange, which either replaces the invalid sequences or stops on the
+		// first of them. In that case consumed is where it starts and outputSize covers everything in front of it.
+		template <EEncoding From, EEncoding To>
+		EError ConvertBlocks(ConvBlockImplF convBlock, ConvBufferImplF convBuffer, ConvertRangeF<CharTypeT<To>, CharTypeT<From>> convertRange, const void* inputBuf, std::size_t inputSize, void* outputBuf, std::size_t outputCapacity, std::size_t& consumed, std::size_t& outputSize)
+		{
+			using C1 = CharTypeT<To>;
+			using C2 = CharTypeT<From>;
+
+			const std::uint8_t* input       = static_cast<const std::uint8_t*>(inputBuf);
+			std::uint8_t*       output      = static_cast<std::uint8_t*>(outputBuf);
+			std::size_t         errorOffset = inputSize;
+			consumed                        = 0;
+			outputSize                      = 0;
+
+			// Converts from begin up to end and the units at end the next block skips, all byte offsets into input.
+			// That is at most a block and the tail after it, so the result is built on the stack before it is checked against the room left.
+			auto rangeBlock = [&](std::size_t begin, std::size_t end) {
+				C1          buffer[MaxOutputSize<From, To>(alignof(InputBlock) + 3 * sizeof(C2)) / sizeof(C1)];
+				std::size_t index   = begin / sizeof(C2);
+				std::size_t written = 0;
+				EError      error   = convertRange(reinterpret_cast<const C2*>(input), inputSize / sizeof(C2), index, end / sizeof(C2), buffer, written);
+				if (written * sizeof(C1) > outputCapacity - outputSize)
+					return EError::OutputTooSmall;
+				std::memcpy(output + outputSize, buffer, written * sizeof(C1));
+				outputSize += written * sizeof(C1);
+				if (error != EError::Success)
+					errorOffset = index * sizeof(C2);
+				return error;
+			};
+			// The sequences in front of the one the kernel rejected are converted again along with the rest of the block
+			auto retryBlock = [&](std::size_t offset, std::size_t size) {
+				return rangeBlock(offset + LeadingTail<From>(input + offset, inputSize - offset), offset + size);
+			};
+
+			// The input has no previous block for a skipped tail to belong to
+			if (LeadingTail<From>(input, inputSize))
+			{
+				EError error = rangeBlock(0, 0);
+				if (error != EError::Success)
+					return error;
+			}
+
+			std::size_t firstBytes, lastBytes;
+			CalcIters(reinterpret_cast<std::uintptr_t>(inputBuf), inputSize, alignof(InputBlock), firstBytes, lastBytes);
+			std::size_t fastEnd = inputSize - lastBytes;
+
+			auto stagedBlock = [&](std::size_t offset, std::size_t size) {
+				// Sequences may continue past the block, so the kernel gets to see the bytes following it as well
+				InputBlock  inputBlock;
+				OutputBlock outputBlock;
+				std::size_t readable = std::min<std::size_t>(inputSize - offset, sizeof(InputBlock));
+				std::memcpy(&inputBlock, input + offset, readable);
+				std::memset(reinterpret_cast<std::uint8_t*>(&inputBlock) + readable, 0, sizeof(inputBlock) - readable);
+
+				std::size_t bytesWritten = 0;
+				if (convBlock(inputBlock, outputBlock, size, bytesWritten) != EError::Success)
+					return retryBlock(offset, size);
+				if (bytesWritten > outputCapacity - outputSize)
+					return EError::OutputTooSmall;
+				std::memcpy(output + outputSize, &outputBlock, bytesWritten);
+				outputSize += bytesWritten;
+				return EError::Success;
+			};
+
+			std::size_t offset = 0;
+			EError      error  = EError::Success;
+			if (firstBytes > 0)
+			{
+				error = stagedBlock(0, firstBytes);
+				if (error == EError::Success)
+					offset = firstBytes;
+			}
+			while (error == EError::Success && offset < fastEnd)
+			{
+				// Every block that is sure to fit goes through a single call
+				std::size_t room   = outputCapacity - outputSize;
+				std::size_t blocks = room > sizeof(OutputBlock) ? (room - sizeof(OutputBlock)) / MaxOutputSize<From, To>(alignof(InputBlock)) : 0;
+				blocks             = std::min<std::size_t>(blocks, (fastEnd - offset) / alignof(InputBlock));
+				if (blocks > 0)
+				{
+					std::size_t bytesConsumed = 0;
+					std::size_t bytesWritten  = 0;
+					error                     = convBuffer(input + offset, blocks * alignof(InputBlock), inputSize - offset, output + outputSize, bytesConsumed, bytesWritten);
+					offset                   += bytesConsumed;
+					outputSize               += bytesWritten;
+					// Only the block that failed is retried, the blocks after it go back to the kernel
+					if (error != EError::Success)
+					{
+						error = retryBlock(offset, alignof(InputBlock));
+						if (error == EError::Success)
+							offset += alignof(InputBlock);
+					}
+				}
+				else
+				{
+					error = stagedBlock(offset, alignof(InputBlock));
+					if (error == EError::Success)
+						offset += alignof(InputBlock);
+				}
+			}
+			if (error == EError::Success && lastBytes > 0)
+			{
+				error = stagedBlock(offset, lastBytes);
+				if (error == EError::Success)
+					offset += lastBytes;
+			}
+
+			// The last converted sequence may have ended inside the block that stopped the conversion
+			if (errorOffset < inputSize)
+				consumed = errorOffset;
+			else
+				consumed = offset < inputSize ? offset + LeadingTail<From>(input + offset, inputSize - offset) : inputSize;
+			return error;
+		}
+	} // namespace Details
+
+	struct ConvertResult
+	{
+		std::size_t Consumed = 0; // Input units that were converted, always ends on a codepoint boundary. On invalid input this is where the first invalid sequence starts.
+		std::size_t Written  = 0; // Output units that were stored, the conversion of all input units before Consumed
+		EError      Error    = EError::Success;
+	};
+
+	// Converts into caller provided memory without allocating. Returns OutputTooSmall when the rest does not fit, the conversion can be resumed from Consumed.
+	// On invalid input output holds the conversion of everything in front of it, so the caller can resume past it the same way.
 	template <class C1, class C2>
-	Details::String<C1> auto Convert(Details::StringView<C2> auto str, EImpl impl = EImpl::Fastest)
+	ConvertResult ConvertInto(std::span<const C2> input, std::span<C1> output, EImpl impl = EImpl::Fastest, EErrorPolicy errorPolicy = EErrorPolicy::Error)
 	{
 		constexpr EEncoding From = Details::EncodingTypeV<C2>;
 		constexpr EEncoding To   = Details::EncodingTypeV<C1>;
 
+		ConvertResult result;
 		if constexpr (From == To)
 		{
-			std::basic_string<C1> result(str.size(), '\0');
-			std::memcpy(result.data(), str.data(), str.size() * sizeof(C1));
+			result.Consumed = std::min(input.size(), output.size());
+			result.Written  = result.Consumed;
+			std::memcpy(output.data(), input.data(), result.Written * sizeof(C1));
+			if (result.Consumed < input.size())
+				result.Error = EError::OutputTooSmall;
+		}
+		else
+		{
+			// Resolve the kernels once, instead of going through the tables for every block
+			if (impl == EImpl::Fastest)
+				impl = GetFastestImpl();
+			ConvBlockImplF  convBlock  = s_ConvBlockImpls[static_cast<std::uint8_t>(From)][static_cast<std::uint8_t>(To)][static_cast<std::uint8_t>(impl)];
+			ConvBufferImplF convBuffer = s_ConvBufferImpls[static_cast<std::uint8_t>(From)][static_cast<std::uint8_t>(To)][static_cast<std::uint8_t>(impl)];
+			if (!convBlock || !convBuffer)
+			{
+				result.Error = EError::MissingImpl;
+				return result;
+			}
+			// Blocks the kernels reject are converted again a sequence at a time, the valid blocks around them stay on the kernels
+			Details::ConvertRangeF<C1, C2> convertRange = errorPolicy == EErrorPolicy::Replace ? &Details::ConvertRange<C1, C2, true> : &Details::ConvertRange<C1, C2, false>;
+
+			std::size_t consumed = 0;
+			std::size_t written  = 0;
+			result.Error         = Details::ConvertBlocks<From, To>(convBlock, convBuffer, convertRange, input.data(), input.size_bytes(), output.data(), output.size_bytes(), consumed, written);
+			result.Consumed      = consumed / sizeof(C2);
+			result.Written       = written / sizeof(C1);
+		}
+		return result;
+	}
+
+	namespace Details
+	{
+		// Converts input shorter than c_SmallMaxSize bytes that starts with ascii ASCII units without going through the kernels.
+		// Pure ASCII is widened or narrowed straight into output, anything else is decoded into a buffer on the stack first,
+		// so output only grows by what was written and short results stay in its SSO buffer. Invalid input appends what is in front of it.
+		template <class C1, class C2, class Alloc>
+		ConvertResult ConvertSmall(std::basic_string_view<C2> input, std::size_t ascii, std::basic_string<C1, std::char_traits<C1>, Alloc>& output, EErrorPolicy errorPolicy)
+		{
+			constexpr EEncoding From = EncodingTypeV<C2>;
+			constexpr EEncoding To   = EncodingTypeV<C1>;
+
+			if (ascii == input.size())
+			{
+				std::size_t offset = output.size();
+				output.resize(offset + input.size());
+				CopyAscii(input.data(), output.data() + offset, input.size());
+				return ConvertResult { .Consumed = input.size(), .Written = input.size() };
+			}
+
+			C1 buffer[MaxOutputSize<From, To>(c_SmallMaxSize) / sizeof(C1)];
+			CopyAscii(input.data(), buffer, ascii);
+
+			ConvertResult result { .Consumed = ascii, .Written = ascii };
+			while (result.Consumed < input.size())
+			{
+				// ASCII between the other sequences is copied without going through the decoder
+				auto unit = static_cast<std::make_unsigned_t<C2>>(input[result.Consumed]);
+				if (unit < 0x80)
+				{
+					buffer[result.Written++] = static_cast<C1>(unit);
+					++result.Consumed;
+					continue;
+				}
+
+				char32_t codepoint = 0;
+				if (errorPolicy == EErrorPolicy::Replace)
+				{
+					DecodeSubpart(input.data(), input.size(), result.Consumed, codepoint);
+				}
+				else
+				{
+					std::size_t start = result.Consumed;
+					result.Error      = DecodeCodepoint(input.data(), input.size(), result.Consumed, codepoint);
+					if (result.Error == EError::Success && !Encodable<C1>(codepoint))
+					{
+						result.Consumed = start;
+						result.Error    = EError::OOB;
+					}
+					if (result.Error != EError::Success)
+						break;
+				}
+				result.Written += EncodeCodepoint(codepoint, buffer + result.Written);
+			}
+			output.append(buffer, result.Written);
+			return result;
+		}
+
+		template <class T>
+		using ScratchVector = std::vector<T, Memory::ArenaAllocator<T>>;
+
+		// Output buffer taken from scratch and given back when it goes out of scope. Buffers past an arena chunk get a chunk of their own,
+		// which is freed right away, otherwise ThreadArena would keep the largest buffer a call on its thread ever took.
+		template <class C>
+		struct ScratchBuffer
+		{
+		public:
+			ScratchBuffer(Memory::Arena& scratch, std::size_t size) noexcept
+				: m_Scratch(scratch),
+				  m_Marker(scratch.Mark()),
+				  m_Size(size),
+				  m_Data(static_cast<C*>(scratch.Allocate(size, alignof(OutputBlock)))) {}
+
+			~ScratchBuffer() noexcept
+			{
+				m_Scratch.Rewind(m_Marker);
+				if (m_Size > Memory::c_ArenaChunkSize)
+					m_Scratch.Trim();
+			}
+
+			ScratchBuffer(const ScratchBuffer&)            = delete;
+			ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+			C*          Data() const noexcept { return m_Data; }
+			std::size_t Units() const noexcept { return m_Size / sizeof(C); }
+
+		private:
+			Memory::Arena&        m_Scratch;
+			Memory::Arena::Marker m_Marker;
+			std::size_t           m_Size;
+			C*                    m_Data;
+		};
+
+		// Converts c_SinglePassMaxSize bytes at a time into a buffer taken from scratch and appends each result, up to the first invalid sequence.
+		// This is what input the sizing pass rejected goes through, as CalcReqSize does not tell where the error is.
+		template <class C1, class C2, class Alloc>
+		ConvertResult ConvertWindows(std::basic_string_view<C2> input, std::basic_string<C1, std::char_traits<C1>, Alloc>& output, EImpl impl, Memory::Arena& scratch)
+		{
+			constexpr EEncoding From = EncodingTypeV<C2>;
+			constexpr EEncoding To   = EncodingTypeV<C1>;
+
+			std::size_t       windowUnits = std::min(input.size(), c_SinglePassMaxSize / sizeof(C2));
+			ScratchBuffer<C1> buffer(scratch, MaxOutputSize<From, To>(windowUnits * sizeof(C2)));
+			if (!buffer.Data())
+				return ConvertResult { .Error = EError::OutOfMemory };
+
+			ConvertResult result;
+			while (result.Consumed < input.size())
+			{
+				std::size_t   end    = input.size() - result.Consumed > windowUnits ? SequenceStart(input.data(), result.Consumed + windowUnits) : input.size();
+				ConvertResult window = ConvertInto<C1, C2>(std::span<const C2>(input).subspan(result.Consumed, end - result.Consumed), std::span<C1>(buffer.Data(), buffer.Units()), impl);
+				output.append(buffer.Data(), window.Written);
+				result.Consumed += window.Consumed;
+				result.Written  += window.Written;
+				result.Error     = window.Error;
+				if (window.Error != EError::Success)
+					break;
+			}
+			return result;
+		}
+
+		template <class C1, class C2, class Alloc>
+		ConvertResult ConvertParallel(std::basic_string_view<C2> input, std::basic_string<C1, std::char_traits<C1>, Alloc>& output, EImpl impl, EErrorPolicy errorPolicy, Memory::Arena& scratch)
+		{
+			constexpr EEncoding From = EncodingTypeV<C2>;
+			constexpr EEncoding To   = EncodingTypeV<C1>;
+
+			Memory::ArenaScope         scope(scratch);
+			std::size_t                chunkCount = std::clamp<std::size_t>(input.size() * sizeof(C2) / c_ParallelChunkSize, 1, HardwareThreads());
+			ScratchVector<std::size_t> bounds(chunkCount + 1, input.size(), scratch);
+			bounds[0] = 0;
+			// Replacing chunks have to be split where no maximal subpart crosses them, splitting a valid sequence is an error anyway
+			for (std::size_t index = 1; index < chunkCount; ++index)
+			{
+				std::size_t bound = input.size() * index / chunkCount;
+				bounds[index]     = errorPolicy == EErrorPolicy::Replace ? ReplaceBoundary(input.data(), input.size(), bound) : SequenceStart(input.data(), bound);
+			}
+
+			ScratchVector<std::size_t> sizes(chunkCount + 1, 0, scratch);
+			ScratchVector<EError>      errors(chunkCount, EError::Success, scratch);
+			auto                       calcReqSize = [&](std::size_t index) {
+				errors[index] = CalcReqSize<From, To>(input.data() + bounds[index], (bounds[index + 1] - bounds[index]) * sizeof(C2), sizes[index + 1], impl, errorPolicy);
+			};
+			ParallelFor(chunkCount, calcReqSize);
+			// The chunks from the first one the sizing pass rejected on are converted in windows, which stops right on the error
+			std::size_t sized = 0;
+			for (; sized < chunkCount && errors[sized] == EError::Success; ++sized)
+				sizes[sized + 1] = sizes[sized] + sizes[sized + 1] / sizeof(C1);
+
+			// Every chunk converts into exactly the part of output its size was calculated for
+			std::size_t offset = output.size();
+			output.resize(offset + sizes[sized]);
+			ScratchVector<ConvertResult> results(sized, scratch);
+			auto                         convert = [&](std::size_t index) {
+				results[index] = ConvertInto<C1, C2>(std::span<const C2>(input).subspan(bounds[index], bounds[index + 1] - bounds[index]),
+													 std::span<C1>(output).subspan(offset + sizes[index], sizes[index + 1] - sizes[index]),
+													 impl,
+													 errorPolicy);
+			};
+			if (sized > 0)
+				ParallelFor(sized, convert);
+
+			ConvertResult result;
+			for (auto& chunk : results)
+			{
+				result.Consumed += chunk.Consumed;
+				result.Written  += chunk.Written;
+				result.Error     = chunk.Error;
+				if (chunk.Error != EError::Success)
+					break;
+			}
+			output.resize(offset + result.Written);
+			if (result.Error == EError::Success && sized < chunkCount)
+			{
+				ConvertResult rest  = ConvertWindows<C1, C2>(input.substr(bounds[sized]), output, impl, scratch);
+				result.Consumed    += rest.Consumed;
+				result.Written     += rest.Written;
+				result.Error        = rest.Error;
+			}
+			return result;
+		}
+
+		// Appends the conversion of input up to the first invalid sequence to output. SinglePass converts into a worst case sized buffer
+		// taken from scratch and appends the exact result, TwoPass grows output by the CalcReqSize result and converts in place.
+		template <class C1, class C2, class Alloc>
+		ConvertResult ConvertAppend(std::basic_string_view<C2> input, std::basic_string<C1, std::char_traits<C1>, Alloc>& output, EImpl impl, EConvertPolicy policy, EErrorPolicy errorPolicy, Memory::Arena& scratch)
+		{
+			constexpr EEncoding From = EncodingTypeV<C2>;
+			constexpr EEncoding To   = EncodingTypeV<C1>;
+
+			if constexpr (From == To)
+			{
+				output.append(reinterpret_cast<const C1*>(input.data()), input.size());
+				return ConvertResult { .Consumed = input.size(), .Written = input.size() };
+			}
+			else
+			{
+				std::size_t inputSize = input.size() * sizeof(C2);
+				if (policy == EConvertPolicy::Auto && inputSize < c_SmallMaxSize)
+				{
+					std::size_t ascii = AsciiPrefix(input.data(), input.size());
+					if ((input.size() - ascii) * sizeof(C2) <= c_SmallMaxDecodeSize)
+						return ConvertSmall<C1, C2>(input, ascii, output, errorPolicy);
+				}
+
+				if (impl == EImpl::Fastest)
+					impl = GetFastestImpl();
+				if (policy == EConvertPolicy::Auto)
+				{
+					if (inputSize >= c_ParallelMinSize && HardwareThreads() > 1)
+						policy = EConvertPolicy::Parallel;
+					else
+						policy = inputSize <= c_SinglePassMaxSize ? EConvertPolicy::SinglePass : EConvertPolicy::TwoPass;
+				}
+				if (policy == EConvertPolicy::Parallel)
+					return ConvertParallel<C1, C2>(input, output, impl, errorPolicy, scratch);
+
+				if (policy == EConvertPolicy::SinglePass)
+				{
+					// The block kernels validate as they go, so the sizing pass is only needed to keep the allocation exact.
+					// A U+FFFD takes no more room than the longest sequence its unit could start, so the bound holds with replacements too.
+					ScratchBuffer<C1> buffer(scratch, MaxOutputSize<From, To>(inputSize));
+					if (!buffer.Data())
+						return ConvertResult { .Error = EError::OutOfMemory };
+
+					ConvertResult result = ConvertInto<C1, C2>(std::span<const C2>(input), std::span<C1>(buffer.Data(), buffer.Units()), impl, errorPolicy);
+					output.append(buffer.Data(), result.Written);
+					return result;
+				}
+
+				std::size_t growth = 0;
+				if (CalcReqSize<From, To>(input.data(), inputSize, growth, impl, errorPolicy) != EError::Success)
+					return ConvertWindows<C1, C2>(input, output, impl, scratch);
+				// Room for one OutputBlock behind the result lets all full blocks be converted in place
+				growth += sizeof(OutputBlock);
+
+				std::size_t   offset = output.size();
+				output.resize(offset + growth / sizeof(C1));
+				ConvertResult result = ConvertInto<C1, C2>(std::span<const C2>(input), std::span<C1>(output).subspan(offset), impl, errorPolicy);
+				output.resize(offset + result.Written);
+				return result;
+			}
+		}
+	} // namespace Details
+
+	// Appends to output, on invalid input output is left as it was. Consumed and Written still tell where the error is, see ConvertPrefix.
+	// Scratch memory is given back before returning.
+	template <class C1, class C2, class Alloc>
+	ConvertResult ConvertInto(std::basic_string_view<C2> input, std::basic_string<C1, std::char_traits<C1>, Alloc>& output, EImpl impl = EImpl::Fastest, EConvertPolicy policy = EConvertPolicy::Auto, EErrorPolicy errorPolicy = EErrorPolicy::Error, Memory::Arena& scratch = Memory::ThreadArena())
+	{
+		std::size_t   offset = output.size();
+		ConvertResult result = Details::ConvertAppend<C1, C2>(input, output, impl, policy, errorPolicy, scratch);
+		if (result.Error != EError::Success)
+			output.resize(offset);
+		return result;
+	}
+
+	// Appends the conversion of everything in front of the first invalid sequence, which starts at Consumed.
+	// The caller can deal with it and resume after it, without the valid part being converted again.
+	template <class C1, class C2, class Alloc>
+	ConvertResult ConvertPrefix(std::basic_string_view<C2> input, std::basic_string<C1, std::char_traits<C1>, Alloc>& output, EImpl impl = EImpl::Fastest, EConvertPolicy policy = EConvertPolicy::Auto, Memory::Arena& scratch = Memory::ThreadArena())
+	{
+		return Details::ConvertAppend<C1, C2>(input, output, impl, policy, EErrorPolicy::Error, scratch);
+	}
+
+	// The result is allocated with allocator, scratch memory comes from the calling thread's arena
+	template <class C1, class C2, class Alloc = std::allocator<C1>>
+	Details::String<C1> auto Convert(Details::StringView<C2> auto str, EImpl impl = EImpl::Fastest, EConvertPolicy policy = EConvertPolicy::Auto, EErrorPolicy errorPolicy = EErrorPolicy::Error, const Alloc& allocator = Alloc {})
+	{
+		std::basic_string<C1, std::char_traits<C1>, Alloc> output(allocator);
+		if (ConvertInto<C1, C2>(str, output, impl, policy, errorPolicy).Error != EError::Success)
+			output.clear();
+		return output;
+	}
+
+	template <class C1, class C2, class Alloc = std::allocator<C1>>
+	Details::String<C1> auto Convert(const Details::String<C2> auto& str, EImpl impl = EImpl::Fastest, EConvertPolicy policy = EConvertPolicy::Auto, EErrorPolicy errorPolicy = EErrorPolicy::Error, const Alloc& allocator = Alloc {})
+	{
+		return Convert<C1, C2, Alloc>(std::basic_string_view<C2>(str), impl, policy, errorPolicy, allocator);
+	}
+
+	struct BatchResult
+	{
+		std::size_t Converted = 0; // Inputs that were converted, output and offsets are valid up to this one
+		EError      Error     = EError::Success;
+	};
+
+	// Converts many short strings in one go, the result of inputs[i] is appended to output and ends up in [offsets[i], offsets[i + 1]).
+	// Short inputs are packed back to back into a staging buffer taken from scratch, so the kernels run over full blocks instead of
+	// being set up once per input. Longer inputs and ones that don't end on a sequence boundary are converted on their own.
+	template <class C1, class C2, class Alloc, class OffsetAlloc>
+	BatchResult ConvertBatch(std::span<const std::basic_string_view<C2>> inputs, std::basic_string<C1, std::char_traits<C1>, Alloc>& output, std::vector<std::size_t, OffsetAlloc>& offsets, EImpl impl = EImpl::Fastest, Memory::Arena& scratch = Memory::ThreadArena())
+	{
+		constexpr EEncoding From = Details::EncodingTypeV<C2>;
+		constexpr EEncoding To   = Details::EncodingTypeV<C1>;
+
+		std::size_t totalSize = 0;
+		for (auto& input : inputs)
+			totalSize += input.size();
+		output.reserve(output.size() + totalSize);
+		offsets.resize(inputs.size() + 1);
+		offsets[0] = output.size();
+
+		BatchResult result;
+		if constexpr (From == To)
+		{
+			for (auto& input : inputs)
+			{
+				output.append(reinterpret_cast<const C1*>(input.data()), input.size());
+				offsets[++result.Converted] = output.size();
+			}
 			return result;
 		}
 		else
 		{
-			const void* inputBuf  = str.data();
-			std::size_t inputSize = str.size() * sizeof(Details::CharTypeT<From>);
-			std::size_t inputOff  = 0;
+			if (impl == EImpl::Fastest)
+				impl = GetFastestImpl();
+			if (!s_ConvBlockImpls[static_cast<std::uint8_t>(From)][static_cast<std::uint8_t>(To)][static_cast<std::uint8_t>(impl)])
+			{
+				result.Error = EError::MissingImpl;
+				return result;
+			}
 
-			std::size_t outputSize = 0;
-			EError      error      = CalcReqSize<From, To>(inputBuf, inputSize, outputSize, impl);
-			if (error != EError::Success)
-				return std::basic_string<C1> {};
+			// OutputUnits reads the staged inputs eight bytes at a time, the padding keeps the last one readable
+			Memory::ArenaScope scope(scratch);
+			std::uint8_t*      staged     = static_cast<std::uint8_t*>(scratch.Allocate(c_BatchStageSize + 8, alignof(InputBlock)));
+			std::size_t        stagedSize = 0;
+			if (!staged)
+			{
+				result.Error = EError::OutOfMemory;
+				return result;
+			}
 
-			void*       outputBuf = Memory::AlignedMalloc(alignof(OutputBlock), outputSize);
-			std::size_t outputOff = 0;
-			if (!outputBuf)
-				return std::basic_string<C1> {};
+			auto convertOne = [&](std::size_t index) {
+				result.Error = ConvertInto<C1, C2>(inputs[index], output, impl).Error;
+				if (result.Error != EError::Success)
+					return false;
+				offsets[++result.Converted] = output.size();
+				return true;
+			};
+			// The offsets of staged inputs are counted up front, should the kernels disagree the inputs are converted one by one instead
+			auto flush = [&](std::size_t end) {
+				if (stagedSize == 0)
+				{
+					result.Converted = end;
+					return true;
+				}
 
-			std::size_t firstBytes, lastBytes;
-			Details::CalcIters(reinterpret_cast<std::uintptr_t>(inputBuf), inputSize, alignof(InputBlock), firstBytes, lastBytes);
-			std::size_t fastIters = (inputSize - firstBytes - lastBytes) / alignof(InputBlock);
+				std::size_t start    = output.size();
+				std::size_t expected = offsets[end] - start;
+				output.resize(start + expected + sizeof(OutputBlock) / sizeof(C1));
+				ConvertResult converted = ConvertInto<C1, C2>(std::span<const C2>(reinterpret_cast<const C2*>(staged), stagedSize / sizeof(C2)), std::span<C1>(output).subspan(start), impl);
+				stagedSize              = 0;
+				if (converted.Error == EError::Success && converted.Written == expected)
+				{
+					output.resize(start + expected);
+					result.Converted = end;
+					return true;
+				}
+				output.resize(start);
+				while (result.Converted < end)
+				{
+					if (!convertOne(result.Converted))
+						return false;
+				}
+				return true;
+			};
 
-			InputBlock  inputBlock;
-			OutputBlock outputBlock;
-			std::size_t bytesWritten = 0;
-			if (firstBytes > 0)
+			for (std::size_t index = 0; index < inputs.size(); ++index)
 			{
-				std::size_t firstPadded = firstBytes;
-				if (fastIters + lastBytes > 0)
+				auto        input = inputs[index];
+				std::size_t size  = input.size() * sizeof(C2);
+				// Only inputs made of whole sequences can be staged, a cut off sequence could be completed by its neighbour
+				bool stageable = size <= c_BatchMaxStagedSize &&
+								 !Details::LeadingTail<From>(reinterpret_cast<const std::uint8_t*>(input.data()), size) &&
+								 !Details::IncompleteTail(input);
+				if (!stageable || stagedSize + size > c_BatchStageSize)
 				{
-					if constexpr (From == EEncoding::UTF8)
-						firstPadded += std::min<std::size_t>(3, fastIters + lastBytes);
-					else if constexpr (From == EEncoding::UTF16)
-						firstPadded += std::min<std::size_t>(2, fastIters + lastBytes);
+					if (!flush(index))
+						return result;
 				}
-				std::memcpy(&inputBlock, reinterpret_cast<const std::uint8_t*>(inputBuf) + inputOff, firstPadded);
-				std::memset(reinterpret_cast<std::uint8_t*>(&inputBlock) + firstPadded, 0, sizeof(inputBlock) - firstPadded);
-				error = ConvBlock<From, To>(inputBlock, outputBlock, firstBytes, bytesWritten, impl);
-				if (error != EError::Success)
+				if (!stageable)
 				{
-					Memory::AlignedFree(outputBuf, alignof(OutputBlock));
-					return std::basic_string<C1> {};
+					if (!convertOne(index))
+						return result;
+					continue;
 				}
-				std::memcpy(reinterpret_cast<std::uint8_t*>(outputBuf) + outputOff, &outputBlock, bytesWritten);
-				inputOff  += firstBytes;
-				outputOff += bytesWritten;
+
+				std::memcpy(staged + stagedSize, input.data(), size);
+				offsets[index + 1]  = offsets[index] + Details::OutputUnits<From, To>(reinterpret_cast<const C2*>(staged + stagedSize), input.size());
+				stagedSize         += size;
 			}
+			flush(inputs.size());
+			return result;
+		}
+	}
 
-			for (std::size_t i = 0; i < fastIters; ++i)
+	// Converts text that arrives in chunks of any size, a sequence cut off at the end of a chunk is held back until the next one completes it.
+	template <EEncoding From, EEncoding To>
+	requires(From != To)
+	struct Transcoder
+	{
+	public:
+		using InputChar  = Details::CharTypeT<From>;
+		using OutputChar = Details::CharTypeT<To>;
+
+	public:
+		explicit Transcoder(EImpl impl = EImpl::Fastest)
+			: m_Impl(impl == EImpl::Fastest ? GetFastestImpl() : impl),
+			  m_PendingSize(0) {}
+
+		// Appends the conversion of every complete sequence to output
+		EError Feed(std::basic_string_view<InputChar> input, std::basic_string<OutputChar>& output)
+		{
+			if (m_PendingSize > 0)
 			{
-				error = ConvBlock<From, To>(*reinterpret_cast<const InputBlock*>(reinterpret_cast<const std::uint8_t*>(inputBuf) + inputOff),
-											*reinterpret_cast<OutputBlock*>(reinterpret_cast<std::uint8_t*>(outputBuf) + outputOff),
-											alignof(InputBlock),
-											bytesWritten,
-											impl);
-				if (error != EError::Success)
+				std::size_t needed = Details::SequenceLength(m_Pending[0]) - m_PendingSize;
+				std::size_t taken  = std::min(needed, input.size());
+				std::copy_n(input.data(), taken, m_Pending + m_PendingSize);
+				m_PendingSize += taken;
+				input.remove_prefix(taken);
+				if (taken < needed)
+					return EError::Success;
+
+				std::size_t pendingSize = m_PendingSize;
+				m_PendingSize           = 0;
+				ConvertResult result    = ConvertInto<OutputChar, InputChar>(std::basic_string_view<InputChar>(m_Pending, pendingSize), output, m_Impl);
+				if (result.Error != EError::Success)
+					return result.Error;
+			}
+
+			std::size_t   complete = input.size() - Details::IncompleteTail(input);
+			ConvertResult result   = ConvertInto<OutputChar, InputChar>(input.substr(0, complete), output, m_Impl);
+			if (result.Error != EError::Success)
+				return result.Error;
+			std::copy(input.begin() + complete, input.end(), m_Pending);
+			m_PendingSize = input.size() - complete;
+			return EError::Success;
+		}
+
+		// Ends the stream, which fails when it stopped inside a sequence
+		EError Finish()
+		{
+			bool incomplete = m_PendingSize > 0;
+			m_PendingSize   = 0;
+			return incomplete ? EError::InvalidContinuation : EError::Success;
+		}
+
+		void Reset() { m_PendingSize = 0; }
+
+		std::size_t PendingSize() const { return m_PendingSize; }
+
+	private:
+		EImpl       m_Impl;
+		InputChar   m_Pending[4];
+		std::size_t m_PendingSize;
+	};
+
+	namespace Details
+	{
+		// Iterator of the views that convert into a buffer of their own a block at a time, it walks the buffer and has the view refill it
+		template <class View, class T>
+		struct BufferIterator
+		{
+		public:
+			using value_type      = T;
+			using difference_type = std::ptrdiff_t;
+
+		public:
+			BufferIterator() = default;
+			explicit BufferIterator(View* view)
+				: m_View(view),
+				  m_Unit(view->m_Buffer),
+				  m_End(view->m_Buffer + view->m_Count) {}
+
+			T operator*() const { return *m_Unit; }
+
+			BufferIterator& operator++()
+			{
+				if (++m_Unit == m_End)
 				{
-					Memory::AlignedFree(outputBuf, alignof(OutputBlock));
-					return std::basic_string<C1> {};
+					m_View->Refill();
+					m_Unit = m_View->m_Buffer;
+					m_End  = m_View->m_Buffer + m_View->m_Count;
 				}
-				inputOff  += alignof(InputBlock);
-				outputOff += bytesWritten;
+				return *this;
 			}
 
-			if (lastBytes > 0)
+			void operator++(int) { ++*this; }
+
+			bool operator==(std::default_sentinel_t) const { return m_Unit == m_End; }
+
+		private:
+			View*    m_View = nullptr;
+			const T* m_Unit = nullptr;
+			const T* m_End  = nullptr;
+		};
+	} // namespace Details
+
+	// Decodes text to codepoints while it is iterated, a block of alignof(InputBlock) bytes at a time with the ConvBlock kernels.
+	// Invalid sequences come out as U+FFFD the way EErrorPolicy::Replace converts them. The view only refers to the text, and it is
+	// an input range, the buffer the block is decoded into lives in the view, so it can only be iterated once at a time.
+	template <class C>
+	struct CodepointView : std::ranges::view_interface<CodepointView<C>>
+	{
+	public:
+		using Iterator = Details::BufferIterator<CodepointView, char32_t>;
+
+	public:
+		CodepointView() = default;
+		explicit CodepointView(std::basic_string_view<C> input, EImpl impl = EImpl::Fastest)
+			: m_Input(input)
+		{
+			if (impl == EImpl::Fastest)
+				impl = GetFastestImpl();
+			if constexpr (Details::EncodingTypeV<C> != EEncoding::UTF32)
+				m_ConvBlock = s_ConvBlockImpls[static_cast<std::uint8_t>(Details::EncodingTypeV<C>)][static_cast<std::uint8_t>(EEncoding::UTF32)][static_cast<std::uint8_t>(impl)];
+			m_ConvertRange = &Details::ConvertRange<char32_t, C, true>;
+		}
+
+		Iterator begin()
+		{
+			// The text has no previous block for a skipped tail to belong to
+			std::size_t index = 0;
+			m_Position        = 0;
+			m_ConvertRange(m_Input.data(), m_Input.size(), index, 0, m_Buffer, m_Count);
+			if (m_Count == 0)
+				Refill();
+			return Iterator(this);
+		}
+
+		std::default_sentinel_t end() const { return std::default_sentinel; }
+
+	private:
+		friend Iterator;
+
+		static constexpr std::size_t c_BlockUnits = alignof(InputBlock) / sizeof(C);
+
+	private:
+		// Decodes blocks until one of them holds a codepoint or the text runs out, the same way ConvertBlocks converts them
+		void Refill()
+		{
+			m_Count = 0;
+			while (m_Count == 0 && m_Position < m_Input.size())
 			{
-				std::memcpy(&inputBlock, reinterpret_cast<const std::uint8_t*>(inputBuf) + inputOff, lastBytes);
-				std::memset(reinterpret_cast<std::uint8_t*>(&inputBlock) + lastBytes, 0, sizeof(inputBlock) - lastBytes);
-				error = ConvBlock<From, To>(inputBlock, outputBlock, lastBytes, bytesWritten, impl);
-				if (error != EError::Success)
+				std::size_t size     = std::min(m_Input.size() - m_Position, c_BlockUnits);
+				std::size_t readable = std::min(m_Input.size() - m_Position, sizeof(InputBlock) / sizeof(C)) * sizeof(C);
+				std::memcpy(&m_Staged, m_Input.data() + m_Position, readable);
+				std::memset(m_Staged.Bytes + readable, 0, sizeof(InputBlock) - readable);
+
+				std::size_t outputSize = 0;
+				if (m_ConvBlock && m_ConvBlock(m_Staged, *reinterpret_cast<OutputBlock*>(m_Buffer), size * sizeof(C), outputSize) == EError::Success)
 				{
-					Memory::AlignedFree(outputBuf, alignof(OutputBlock));
-					return std::basic_string<C1> {};
+					m_Count = outputSize / sizeof(char32_t);
 				}
-				std::memcpy(reinterpret_cast<std::uint8_t*>(outputBuf) + outputOff, &outputBlock, bytesWritten);
-				inputOff  += lastBytes;
-				outputOff += bytesWritten;
+				else
+				{
+					std::size_t index = m_Position + Details::LeadingTail<Details::EncodingTypeV<C>>(m_Staged.Bytes, readable) / sizeof(C);
+					m_ConvertRange(m_Input.data(), m_Input.size(), index, m_Position + size, m_Buffer, m_Count);
+				}
+				m_Position += size;
 			}
+		}
+
+	private:
+		std::basic_string_view<C>           m_Input;
+		ConvBlockImplF                      m_ConvBlock    = nullptr;
+		Details::ConvertRangeF<char32_t, C> m_ConvertRange = nullptr;
+		std::size_t                         m_Position     = 0;
+		std::size_t                         m_Count        = 0;
+		InputBlock                          m_Staged {};
+		// A block the kernel rejected also gets a codepoint for each unit of the tail the next block skips
+		alignas(OutputBlock) char32_t m_Buffer[sizeof(OutputBlock) / sizeof(char32_t) + 3] {};
+	};
+
+	// Encodes the codepoints of range while it is iterated, alignof(InputBlock) / 4 codepoints at a time with the ConvBlock kernels.
+	// Surrogates and codepoints past U+10FFFF come out as U+FFFD, or as '?' when To can't hold them, like the rest of the views it is an input range.
+	template <EEncoding To, std::ranges::input_range R>
+	requires(To != EEncoding::UTF32 && std::ranges::view<R> && std::convertible_to<std::ranges::range_reference_t<R>, char32_t>)
+	struct EncodeView : std::ranges::view_interface<EncodeView<To, R>>
+	{
+	public:
+		using OutputChar = Details::CharTypeT<To>;
+		using Iterator   = Details::BufferIterator<EncodeView, OutputChar>;
+
+	public:
+		EncodeView() = default;
+		explicit EncodeView(R range, EImpl impl = EImpl::Fastest)
+			: m_Range(std::move(range))
+		{
+			if (impl == EImpl::Fastest)
+				impl = GetFastestImpl();
+			m_ConvBlock    = s_ConvBlockImpls[static_cast<std::uint8_t>(EEncoding::UTF32)][static_cast<std::uint8_t>(To)][static_cast<std::uint8_t>(impl)];
+			m_ConvertRange = &Details::ConvertRange<OutputChar, char32_t, true>;
+		}
+
+		Iterator begin()
+		{
+			m_Current = std::ranges::begin(m_Range);
+			Refill();
+			return Iterator(this);
+		}
+
+		std::default_sentinel_t end() const { return std::default_sentinel; }
 
-			std::basic_string<C1> output;
-			output.resize(outputSize / sizeof(Details::CharTypeT<To>));
-			std::memcpy(output.data(), outputBuf, outputSize);
-			Memory::AlignedFree(outputBuf, alignof(OutputBlock));
-			return output;
+	private:
+		friend Iterator;
+
+		static constexpr std::size_t c_BlockCodepoints = alignof(InputBlock) / sizeof(char32_t);
+
+	private:
+		void Refill()
+		{
+			char32_t*   codepoints = reinterpret_cast<char32_t*>(m_Staged.Bytes);
+			std::size_t count      = 0;
+			for (; count < c_BlockCodepoints && m_Current != std::ranges::end(m_Range); ++m_Current)
+				codepoints[count++] = static_cast<char32_t>(*m_Current);
+			std::memset(codepoints + count, 0, sizeof(InputBlock) - count * sizeof(char32_t));
+
+			m_Count                = 0;
+			std::size_t outputSize = 0;
+			if (count == 0)
+				return;
+			if (m_ConvBlock && m_ConvBlock(m_Staged, *reinterpret_cast<OutputBlock*>(m_Buffer), count * sizeof(char32_t), outputSize) == EError::Success)
+			{
+				m_Count = outputSize / sizeof(OutputChar);
+			}
+			else
+			{
+				std::size_t index = 0;
+				m_ConvertRange(codepoints, count, index, count, m_Buffer, m_Count);
+			}
 		}
+
+	private:
+		R                                            m_Range;
+		std::ranges::iterator_t<R>                   m_Current {};
+		ConvBlockImplF                               m_ConvBlock    = nullptr;
+		Details::ConvertRangeF<OutputChar, char32_t> m_ConvertRange = nullptr;
+		std::size_t                                  m_Count        = 0;
+		InputBlock                                   m_Staged {};
+		alignas(OutputBlock) OutputChar m_Buffer[sizeof(OutputBlock) / sizeof(OutputChar)] {};
+	};
+
+	template <class C>
+	CodepointView<C> Codepoints(std::basic_string_view<C> input, EImpl impl = EImpl::Fastest)
+	{
+		return CodepointView<C>(input, impl);
 	}
 
-	template <class C1, class C2>
-	Details::String<C1> auto Convert(const Details::String<C2> auto& str, EImpl impl = EImpl::Fastest)
+	template <class C, class Traits, class Alloc>
+	CodepointView<C> Codepoints(const std::basic_string<C, Traits, Alloc>& input, EImpl impl = EImpl::Fastest)
 	{
-		return Convert<C1, C2>(std::basic_string_view<C2>(str), impl);
+		return CodepointView<C>(std::basic_string_view<C>(input), impl);
 	}
-} // namespace UTF
 
-#endif
\ No newline at end of file
+	template <EEncoding To, std::ranges::viewable_range R>
+	EncodeView<To, std::views::all_t<R>> Encode(R&& range, EImpl impl = EImpl::Fastest)
+	{
+		return EncodeView<To, std::views::all_t<R>>(std::views::all(std::forward<R>(range)), impl);
+	}
+
+	// Translates offsets into UTF-8 text between UTF-8 bytes, UTF-16 units and codepoints, which are UTF-32, Latin-1 and ASCII units. The counts are sampled every
+	// sampleSize bytes, so a translation is a binary search and a count over about sampleSize bytes. The index does not keep the text,
+	// every call takes the text it was built on or last updated with. Counts are taken the way Length takes them, without validating.
+	struct OffsetIndex
+	{
+	public:
+		explicit OffsetIndex(std::size_t sampleSize = c_OffsetSampleSize, EImpl impl = EImpl::Fastest);
+
+		void Build(std::u8string_view text);
+		// Catches up with an edit that replaced removed bytes at offset with inserted bytes, text is the text after the edit.
+		// Only the bytes between the samples around the edit are counted again, the samples past it are moved along.
+		void Update(std::u8string_view text, std::size_t offset, std::size_t removed, std::size_t inserted);
+
+		// Offsets inside a sequence or a surrogate pair are moved back to where it starts, offsets past the end to the end
+		std::size_t Translate(std::u8string_view text, std::size_t offset, EEncoding from, EEncoding to) const;
+
+		std::size_t Size(EEncoding encoding) const;
+
+	private:
+		// Units of UTF-8, UTF-16 and UTF-32, a Latin-1 or ASCII unit is a codepoint like a UTF-32 one
+		static constexpr std::uint8_t c_SampledCount = 3;
+
+		struct Sample
+		{
+			std::size_t Units[c_SampledCount];
+		};
+
+	private:
+		Sample      Advance(std::u8string_view text, Sample sample, std::size_t end, std::vector<Sample>& samples) const;
+		std::size_t Count(std::u8string_view text, std::size_t offset, EEncoding encoding) const;
+		std::size_t Find(std::u8string_view text, std::size_t offset, EEncoding encoding) const;
+
+	private:
+		std::size_t         m_SampleSize;
+		EImpl               m_Impl;
+		std::vector<Sample> m_Samples;
+		Sample              m_Total;
+	};
+
+	// Converts the file at inPath into a new file at outPath, both hold native endian units without a byte order mark.
+	// The input is memory mapped and converted in windows of c_FileWindowSize bytes, so files of any size run with bounded memory.
+	// Returns FileError when a file can't be opened, mapped or written or ends in the middle of a unit of from, and MissingImpl for
+	// encodings that don't exist. On failure the output file is removed again.
+	EError ConvertFile(std::string_view inPath, std::string_view outPath, EEncoding from, EEncoding to, EImpl impl = EImpl::Fastest);
+} // namespace UTF
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "Memory/Arena.h"
+#include "Memory/Memory.h"
+
+#include <algorithm>
+
+namespace Memory
+{
+	struct Arena::Chunk
+	{
+		Chunk*      Next;
+		std::size_t Size; // Including this header
+		std::size_t Used;
+	};
+
+	// Allocations start behind the chunk header, which is padded so they start out aligned to c_ChunkAlignment
+	static constexpr std::size_t c_ChunkAlignment = 64;
+	static constexpr std::size_t c_ChunkHeader    = 64;
+
+	Arena::~Arena() noexcept
+	{
+		Chunk* chunk = m_First;
+		while (chunk)
+		{
+			Chunk* next = chunk->Next;
+			AlignedFree(chunk, c_ChunkAlignment);
+			chunk = next;
+		}
+	}
+
+	void* Arena::Allocate(std::size_t size, std::size_t alignment) noexcept
+	{
+		static_assert(sizeof(Chunk) <= c_ChunkHeader);
+
+		auto tryChunk = [&](Chunk* chunk) -> void* {
+			std::uintptr_t base  = reinterpret_cast<std::uintptr_t>(chunk);
+			std::uintptr_t start = AlignCeil(base + chunk->Used, alignment);
+			if (start + size > base + chunk->Size)
+				return nullptr;
+			chunk->Used = start + size - base;
+			return reinterpret_cast<void*>(start);
+		};
+
+		if (m_Current)
+		{
+			if (void* ptr = tryChunk(m_Current))
+				return ptr;
+			// Chunks past the current one were freed by a rewind and are reused in order
+			if (Chunk* next = m_Current->Next)
+			{
+				next->Used = c_ChunkHeader;
+				if (void* ptr = tryChunk(next))
+				{
+					m_Current = next;
+					return ptr;
+				}
+			}
+		}
+		else if (m_First)
+		{
+			m_First->Used = c_ChunkHeader;
+			if (void* ptr = tryChunk(m_First))
+			{
+				m_Current = m_First;
+				return ptr;
+			}
+		}
+
+		// Larger allocations get a chunk of their own, it is placed before any reusable chunks that were too small
+		std::size_t chunkSize = std::max(m_ChunkSize, c_ChunkHeader + size + (alignment > c_ChunkAlignment ? alignment : 0));
+		Chunk*      chunk     = static_cast<Chunk*>(AlignedMalloc(c_ChunkAlignment, chunkSize));
+		if (!chunk)
+			return nullptr;
+		chunk->Size = chunkSize;
+		chunk->Used = c_ChunkHeader;
+		if (m_Current)
+		{
+			chunk->Next     = m_Current->Next;
+			m_Current->Next = chunk;
+		}
+		else
+		{
+			chunk->Next = m_First;
+			m_First     = chunk;
+		}
+		m_Current = chunk;
+		return tryChunk(chunk);
+	}
+
+	Arena::Marker Arena::Mark() const noexcept
+	{
+		return Marker { m_Current, m_Current ? m_Current->Used : 0 };
+	}
+
+	void Arena::Rewind(const Marker& marker) noexcept
+	{
+		m_Current = static_cast<Chunk*>(marker.Chunk);
+		if (m_Current)
+			m_Current->Used = marker.Used;
+	}
+
+	void Arena::Reset() noexcept
+	{
+		m_Current = nullptr;
+	}
+
+	void Arena::Trim() noexcept
+	{
+		Chunk*& unused = m_Current ? m_Current->Next : m_First;
+		Chunk*  chunk  = unused;
+		while (chunk)
+		{
+			Chunk* next = chunk->Next;
+			AlignedFree(chunk, c_ChunkAlignment);
+			chunk = next;
+		}
+		unused = nullptr;
+	}
+
+	std::size_t Arena::Capacity() const noexcept
+	{
+		std::size_t capacity = 0;
+		for (Chunk* chunk = m_First; chunk; chunk = chunk->Next)
+			capacity += chunk->Size;
+		return capacity;
+	}
+
+	Arena& ThreadArena() noexcept
+	{
+		thread_local Arena s_Arena;
+		return s_Arena;
+	}
+} // namespace Memory
\ No newline at end of file
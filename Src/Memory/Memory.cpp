@@ -0,0 +1,32 @@
+#include "Memory/Memory.h"
+#include "Build.h"
+
+#include <cstdlib>
+
+#if BUILD_IS_SYSTEM_WINDOWS
+	#include <malloc.h>
+#endif
+
+namespace Memory
+{
+	void* AlignedMalloc(std::size_t alignment, std::size_t size) noexcept
+	{
+		if (alignment < alignof(void*))
+			alignment = alignof(void*);
+#if BUILD_IS_SYSTEM_WINDOWS
+		return _aligned_malloc(size ? size : 1, alignment);
+#else
+		// aligned_alloc only takes sizes that are a multiple of the alignment
+		return std::aligned_alloc(alignment, AlignCeil(size ? size : 1, alignment));
+#endif
+	}
+
+	void AlignedFree(void* ptr, [[maybe_unused]] std::size_t alignment) noexcept
+	{
+#if BUILD_IS_SYSTEM_WINDOWS
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+} // namespace Memory
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "Memory/Pool.h"
+#include "Memory/Memory.h"
+
+#include <bit>
+
+namespace Memory
+{
+	struct Pool::FreeBlock
+	{
+		FreeBlock* Next;
+	};
+
+	struct Pool::Slab
+	{
+		Slab* Next;
+	};
+
+	// Blocks start behind the slab header, which is padded so they are aligned to their class size up to c_SlabAlignment
+	static constexpr std::size_t c_SlabAlignment = 64;
+	static constexpr std::size_t c_SlabHeader    = 64;
+
+	static constexpr std::uint8_t SizeClass(std::size_t size) noexcept
+	{
+		return size <= c_PoolMinSize ? 0 : static_cast<std::uint8_t>(std::bit_width(size - 1) - std::bit_width(c_PoolMinSize - 1));
+	}
+
+	static_assert(SizeClass(c_PoolMaxSize) == c_PoolClassCount - 1);
+
+	Pool::Pool() noexcept
+		: m_FreeLists {},
+		  m_Slabs(nullptr) {}
+
+	Pool::~Pool() noexcept
+	{
+		Slab* slab = m_Slabs;
+		while (slab)
+		{
+			Slab* next = slab->Next;
+			AlignedFree(slab, c_SlabAlignment);
+			slab = next;
+		}
+	}
+
+	void* Pool::Allocate(std::size_t size) noexcept
+	{
+		static_assert(sizeof(Slab) <= c_SlabHeader && sizeof(FreeBlock) <= c_PoolMinSize);
+
+		if (size > c_PoolMaxSize)
+			return AlignedMalloc(c_SlabAlignment, size);
+
+		std::uint8_t sizeClass = SizeClass(size);
+		if (!m_FreeLists[sizeClass])
+		{
+			Slab* slab = static_cast<Slab*>(AlignedMalloc(c_SlabAlignment, c_PoolSlabSize));
+			if (!slab)
+				return nullptr;
+			slab->Next = m_Slabs;
+			m_Slabs    = slab;
+
+			// Thread the new blocks in address order, so consecutive allocations are adjacent
+			std::size_t   blockSize  = c_PoolMinSize << sizeClass;
+			std::size_t   blockCount = (c_PoolSlabSize - c_SlabHeader) / blockSize;
+			std::uint8_t* blocks     = reinterpret_cast<std::uint8_t*>(slab) + c_SlabHeader;
+			FreeBlock*    list       = nullptr;
+			for (std::size_t index = blockCount; index-- > 0;)
+			{
+				FreeBlock* block = reinterpret_cast<FreeBlock*>(blocks + index * blockSize);
+				block->Next      = list;
+				list             = block;
+			}
+			m_FreeLists[sizeClass] = list;
+		}
+
+		FreeBlock* block       = m_FreeLists[sizeClass];
+		m_FreeLists[sizeClass] = block->Next;
+		return block;
+	}
+
+	void Pool::Deallocate(void* ptr, std::size_t size) noexcept
+	{
+		if (!ptr)
+			return;
+		if (size > c_PoolMaxSize)
+		{
+			AlignedFree(ptr, c_SlabAlignment);
+			return;
+		}
+
+		std::uint8_t sizeClass = SizeClass(size);
+		FreeBlock*   block     = static_cast<FreeBlock*>(ptr);
+		block->Next            = m_FreeLists[sizeClass];
+		m_FreeLists[sizeClass] = block;
+	}
+} // namespace Memory
\ No newline at end of file
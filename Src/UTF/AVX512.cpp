@@ -0,0 +1,590 @@
+#include "UTF/AVX512.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#include <immintrin.h>
+
+	#include <algorithm>
+	#include <bit>
+
+	// Dispatch only selects this tier when the CPU and OS support AVX-512 VBMI2
+	#if defined(__clang__)
+		#pragma clang attribute push(__attribute__((target("avx2,bmi,bmi2,popcnt,avx512f,avx512bw,avx512vl,avx512vbmi,avx512vbmi2"))), apply_to = function)
+	#elif defined(__GNUC__)
+		#pragma GCC push_options
+		#pragma GCC target("avx2,bmi,bmi2,popcnt,avx512f,avx512bw,avx512vl,avx512vbmi,avx512vbmi2")
+		// GCC's _mm512 intrinsics pass self-initialized undefined vectors as the unused merge source
+		#pragma GCC diagnostic push
+		#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+	#endif
+
+	#include "ConvBuffer.h"
+#endif
+
+namespace UTF::AVX512
+{
+#if defined(__x86_64__) || defined(_M_X64)
+	static std::uint64_t RangeMask(std::size_t begin, std::size_t end)
+	{
+		std::uint64_t endMask = end >= 64 ? ~0ULL : ((1ULL << end) - 1);
+		return endMask & (~0ULL << begin);
+	}
+
+	// Decodes 16 lanes holding the 4 bytes starting at a leading byte each, the same way as SIMD::DecodeUTF8Lanes.
+	static __m512i DecodeUTF8Lanes(__m512i lanes)
+	{
+		const __m512i c_LeadMasks = _mm512_broadcast_i32x4(_mm_setr_epi8(0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0, 0, 0, 0, 0x1F, 0x1F, 0x0F, 0x07));
+		const __m512i c_Shifts    = _mm512_broadcast_i32x4(_mm_setr_epi8(18, 18, 18, 18, 18, 18, 18, 18, 0, 0, 0, 0, 12, 12, 6, 0));
+
+		__m512i nibbles = _mm512_and_si512(_mm512_srli_epi32(lanes, 4), _mm512_set1_epi32(0x0F));
+		__m512i masks   = _mm512_and_si512(_mm512_shuffle_epi8(c_LeadMasks, nibbles), _mm512_set1_epi32(0x3F3F'3FFF));
+		__m512i shifts  = _mm512_and_si512(_mm512_shuffle_epi8(c_Shifts, nibbles), _mm512_set1_epi32(0xFF));
+		__m512i pairs   = _mm512_maddubs_epi16(_mm512_and_si512(lanes, masks), _mm512_set1_epi32(0x0140'0140));
+		__m512i merged  = _mm512_madd_epi16(pairs, _mm512_set1_epi32(0x0001'1000));
+		return _mm512_srlv_epi32(merged, shifts);
+	}
+
+	// Writes the first count codepoints as UTF-8, returns the number of bytes written.
+	static std::size_t StoreUTF8(OutputBlock& output, std::size_t offset, __m512i codepoints, std::uint32_t count)
+	{
+		__mmask16 lanes   = static_cast<__mmask16>(RangeMask(0, count));
+		__mmask16 isMulti = _mm512_mask_cmpgt_epu32_mask(lanes, codepoints, _mm512_set1_epi32(0x7F));
+		if (!isMulti)
+		{
+			_mm_mask_storeu_epi8(output.Bytes + offset, lanes, _mm512_cvtepi32_epi8(codepoints));
+			return count;
+		}
+
+		__mmask16 is3    = _mm512_cmpgt_epu32_mask(codepoints, _mm512_set1_epi32(0x7FF));
+		__mmask16 is4    = _mm512_cmpgt_epu32_mask(codepoints, _mm512_set1_epi32(0xFFFF));
+		__m512i   one    = _mm512_set1_epi32(1);
+		__m512i   extra  = _mm512_add_epi32(_mm512_maskz_mov_epi32(isMulti, one), _mm512_add_epi32(_mm512_maskz_mov_epi32(is3, one), _mm512_maskz_mov_epi32(is4, one)));
+		__m512i   shifts = _mm512_sub_epi32(_mm512_set1_epi32(24), _mm512_slli_epi32(extra, 3));
+		// Same layout as SIMD::StoreUTF8, the 6 bit groups in reverse with the unused ones shifted out
+		__m512i groups = _mm512_or_si512(_mm512_or_si512(_mm512_and_si512(_mm512_slli_epi32(codepoints, 24), _mm512_set1_epi32(0x3F00'0000)),
+														 _mm512_and_si512(_mm512_slli_epi32(codepoints, 10), _mm512_set1_epi32(0x003F'0000))),
+										 _mm512_or_si512(_mm512_and_si512(_mm512_srli_epi32(codepoints, 4), _mm512_set1_epi32(0x0000'3F00)),
+														 _mm512_srli_epi32(codepoints, 18)));
+		__m512i prefix = _mm512_and_si512(_mm512_srlv_epi32(_mm512_set1_epi32(0x7F80), extra), _mm512_set1_epi32(0xF0));
+		__m512i bytes  = _mm512_or_si512(_mm512_srlv_epi32(_mm512_or_si512(groups, _mm512_set1_epi32(static_cast<int>(0x8080'8080))), shifts), prefix);
+		bytes          = _mm512_mask_mov_epi32(bytes, static_cast<__mmask16>(~isMulti), codepoints);
+
+		// Byte i of a lane is used when i <= extra, the unused ones get squeezed out
+		__mmask64   used   = _mm512_mask_cmple_epu8_mask(RangeMask(0, count * 4), _mm512_set1_epi32(0x0302'0100), _mm512_mullo_epi32(extra, _mm512_set1_epi32(0x0101'0101)));
+		std::size_t length = std::popcount(used);
+		_mm512_mask_storeu_epi8(output.Bytes + offset, RangeMask(0, length), _mm512_maskz_compress_epi8(used, bytes));
+		return length;
+	}
+
+	// Writes the first count codepoints as UTF-16, returns the number of bytes written.
+	static std::size_t StoreUTF16(OutputBlock& output, std::size_t offset, __m512i codepoints, std::uint32_t count)
+	{
+		__mmask16 lanes           = static_cast<__mmask16>(RangeMask(0, count));
+		__mmask16 isSupplementary = _mm512_mask_cmpgt_epu32_mask(lanes, codepoints, _mm512_set1_epi32(0xFFFF));
+		if (!isSupplementary)
+		{
+			_mm256_mask_storeu_epi16(output.Bytes + offset, lanes, _mm512_cvtepi32_epi16(codepoints));
+			return count * 2;
+		}
+
+		// Supplementary lanes become a high surrogate in the low word and a low surrogate in the high word
+		__m512i highSurrogates = _mm512_add_epi32(_mm512_srli_epi32(codepoints, 10), _mm512_set1_epi32(0xD800 - (0x1'0000 >> 10)));
+		__m512i lowSurrogates  = _mm512_or_si512(_mm512_and_si512(codepoints, _mm512_set1_epi32(0x3FF)), _mm512_set1_epi32(0xDC00));
+		__m512i words          = _mm512_mask_mov_epi32(codepoints, isSupplementary, _mm512_or_si512(highSurrogates, _mm512_slli_epi32(lowSurrogates, 16)));
+
+		// Every lane keeps its low word, the high word is only non-zero for pairs
+		__mmask32   used   = ((_mm512_test_epi16_mask(words, words) & 0xAAAA'AAAA) | 0x5555'5555) & static_cast<__mmask32>(RangeMask(0, count * 2));
+		std::size_t length = std::popcount(used);
+		_mm512_mask_storeu_epi16(output.Bytes + offset, static_cast<__mmask32>(RangeMask(0, length)), _mm512_maskz_compress_epi16(used, words));
+		return length * 2;
+	}
+
+	template <EEncoding To>
+	static std::size_t StoreCodepoints(OutputBlock& output, std::size_t offset, __m512i codepoints, std::uint32_t count)
+	{
+		if constexpr (To == EEncoding::UTF8)
+		{
+			return StoreUTF8(output, offset, codepoints, count);
+		}
+		else if constexpr (To == EEncoding::UTF16)
+		{
+			return StoreUTF16(output, offset, codepoints, count);
+		}
+		else
+		{
+			_mm512_mask_storeu_epi32(output.Bytes + offset, static_cast<__mmask16>(RangeMask(0, count)), codepoints);
+			return count * 4;
+		}
+	}
+
+	// Same approach as SIMD::CalcReqSizeFrom8 on k-masks, the last window is a masked load so nothing past the input is read.
+	template <EEncoding To>
+	static EError CalcReqSizeFrom8(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize = 0;
+
+		const std::uint8_t* bytes     = static_cast<const std::uint8_t*>(input);
+		std::size_t         leaders   = 0;
+		std::size_t         fourBytes = 0;
+		std::uint64_t       carry     = 0;
+		std::uint64_t       afterE0   = 0;
+		std::uint64_t       afterED   = 0;
+		std::uint64_t       afterF0   = 0;
+		std::uint64_t       afterF4   = 0;
+		for (std::size_t offset = 0; offset < inputSize; offset += 64)
+		{
+			std::size_t   length = std::min<std::size_t>(inputSize - offset, 64);
+			std::uint64_t range  = RangeMask(0, length);
+			__m512i       window = _mm512_maskz_loadu_epi8(range, bytes + offset);
+			std::uint64_t high   = _mm512_movepi8_mask(window);
+			if (!(high | carry))
+			{
+				leaders += length;
+				continue;
+			}
+
+			std::uint64_t cont       = _mm512_cmplt_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xC0))) & high;
+			std::uint64_t ge2        = _mm512_cmpge_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xC0)));
+			std::uint64_t ge3        = _mm512_cmpge_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xE0)));
+			std::uint64_t ge4        = _mm512_cmpge_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xF0)));
+			std::uint64_t bad        = _mm512_cmpge_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xF5))) | _mm512_cmpeq_epu8_mask(_mm512_and_si512(window, _mm512_set1_epi8(static_cast<char>(0xFE))), _mm512_set1_epi8(static_cast<char>(0xC0)));
+			std::uint64_t e0         = _mm512_cmpeq_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xE0)));
+			std::uint64_t ed         = _mm512_cmpeq_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xED)));
+			std::uint64_t f0         = _mm512_cmpeq_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xF0)));
+			std::uint64_t f4         = _mm512_cmpeq_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xF4)));
+			std::uint64_t ge90       = _mm512_cmpge_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0x90)));
+			std::uint64_t geA0       = _mm512_cmpge_epu8_mask(window, _mm512_set1_epi8(static_cast<char>(0xA0)));
+			std::uint64_t required   = carry | ge2 << 1 | ge3 << 2 | ge4 << 3;
+			std::uint64_t leadErrors = bad | (cont & ~required);
+			std::uint64_t contErrors = (required & ~cont) | ((afterE0 | e0 << 1) & ~geA0) | ((afterED | ed << 1) & geA0) | ((afterF0 | f0 << 1) & ~ge90) | ((afterF4 | f4 << 1) & ge90);
+			carry                    = ge2 >> 63 | ge3 >> 62 | ge4 >> 61;
+			afterE0                  = e0 >> 63;
+			afterED                  = ed >> 63;
+			afterF0                  = f0 >> 63;
+			afterF4                  = f4 >> 63;
+			if (leadErrors | contErrors)
+				return std::countr_zero(leadErrors) < std::countr_zero(contErrors) ? EError::InvalidLeading : EError::InvalidContinuation;
+
+			leaders   += std::popcount(range & ~cont);
+			fourBytes += std::popcount(ge4);
+		}
+		if (carry)
+			return EError::InvalidContinuation;
+
+		if constexpr (To == EEncoding::UTF16)
+			requiredSize = 2 * (leaders + fourBytes);
+		else
+			requiredSize = 4 * leaders;
+		return EError::Success;
+	}
+
+	template <EEncoding To>
+	static EError CalcReqSizeFrom16(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize = 0;
+
+		const std::uint8_t* bytes = static_cast<const std::uint8_t*>(input);
+		std::size_t         size  = 0;
+		std::uint64_t       carry = 0;
+		for (std::size_t offset = 0; offset < inputSize; offset += 64)
+		{
+			std::size_t length = std::min<std::size_t>(inputSize - offset, 64);
+			std::size_t units  = (length + 1) / 2;
+			__m512i     window = _mm512_maskz_loadu_epi8(RangeMask(0, length), bytes + offset);
+			if (!carry && !_mm512_test_epi16_mask(window, _mm512_set1_epi16(static_cast<short>(0xFF80))))
+			{
+				size += To == EEncoding::UTF8 ? units : 4 * units;
+				continue;
+			}
+
+			__m512i       masked     = _mm512_and_si512(window, _mm512_set1_epi16(static_cast<short>(0xFC00)));
+			std::uint64_t high       = _mm512_cmpeq_epi16_mask(masked, _mm512_set1_epi16(static_cast<short>(0xD800)));
+			std::uint64_t low        = _mm512_cmpeq_epi16_mask(masked, _mm512_set1_epi16(static_cast<short>(0xDC00)));
+			std::uint64_t required   = carry | high << 1;
+			std::uint64_t leadErrors = low & ~required;
+			std::uint64_t contErrors = required & ~low & 0xFFFF'FFFF;
+			carry                    = required >> 32;
+			if (leadErrors | contErrors)
+				return std::countr_zero(leadErrors) < std::countr_zero(contErrors) ? EError::InvalidLeading : EError::InvalidContinuation;
+
+			if constexpr (To == EEncoding::UTF8)
+			{
+				// One byte per unit, one more from 0x80 and from 0x800 on, each surrogate takes one back so a pair adds up to 4
+				std::uint32_t ge80  = _mm512_test_epi16_mask(window, _mm512_set1_epi16(static_cast<short>(0xFF80)));
+				std::uint32_t ge800 = _mm512_test_epi16_mask(window, _mm512_set1_epi16(static_cast<short>(0xF800)));
+				size               += units + std::popcount(ge80) + std::popcount(ge800) - std::popcount(high | low);
+			}
+			else
+			{
+				size += 4 * (units - std::popcount(low));
+			}
+		}
+		if (carry)
+			return EError::InvalidContinuation;
+
+		requiredSize = size;
+		return EError::Success;
+	}
+
+	// Lanes past U+10FFFF or on a surrogate, neither has an encoding in UTF-8 or UTF-16
+	static __mmask16 InvalidCodepoints(__m512i codepoints)
+	{
+		return _mm512_cmpgt_epu32_mask(codepoints, _mm512_set1_epi32(0x10'FFFF)) |
+			   _mm512_cmpeq_epi32_mask(_mm512_and_si512(codepoints, _mm512_set1_epi32(static_cast<int>(0xFFFF'F800))), _mm512_set1_epi32(0xD800));
+	}
+
+	template <EEncoding To>
+	static EError CalcReqSizeFrom32(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize = 0;
+
+		const std::uint8_t* bytes = static_cast<const std::uint8_t*>(input);
+		std::size_t         units = (inputSize + 3) / 4;
+		std::size_t         size  = 0;
+		for (std::size_t unit = 0; unit < units; unit += 16)
+		{
+			std::uint32_t count      = static_cast<std::uint32_t>(std::min<std::size_t>(units - unit, 16));
+			__m512i       codepoints = _mm512_maskz_loadu_epi32(static_cast<__mmask16>(RangeMask(0, count)), bytes + unit * 4);
+			if (InvalidCodepoints(codepoints))
+				return EError::OOB;
+
+			std::uint32_t supplementary = _mm512_cmpgt_epu32_mask(codepoints, _mm512_set1_epi32(0xFFFF));
+			if constexpr (To == EEncoding::UTF8)
+			{
+				std::uint32_t ge80  = _mm512_cmpgt_epu32_mask(codepoints, _mm512_set1_epi32(0x7F));
+				std::uint32_t ge800 = _mm512_cmpgt_epu32_mask(codepoints, _mm512_set1_epi32(0x7FF));
+				size               += count + std::popcount(ge80) + std::popcount(ge800) + std::popcount(supplementary);
+			}
+			else
+			{
+				size += 2 * (count + std::popcount(supplementary));
+			}
+		}
+		requiredSize = size;
+		return EError::Success;
+	}
+
+	template <EEncoding To>
+	static EError ConvBlockFrom8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize = 0;
+		if (inputSize == 0)
+			return EError::Success;
+
+		// Up to 3 continuation bytes belong to a sequence started in the previous block
+		std::size_t start = 0;
+		while (start < 3 && start < inputSize && (input.Bytes[start] & 0xC0) == 0x80)
+			++start;
+
+		const __m512i c_Iota         = _mm512_set_epi64(0x3F3E'3D3C'3B3A'3938, 0x3736'3534'3332'3130, 0x2F2E'2D2C'2B2A'2928, 0x2726'2524'2322'2120, 0x1F1E'1D1C'1B1A'1918, 0x1716'1514'1312'1110, 0x0F0E'0D0C'0B0A'0908, 0x0706'0504'0302'0100);
+		const __m512i c_LaneSpread   = _mm512_set_epi32(0x0F0F'0F0F, 0x0E0E'0E0E, 0x0D0D'0D0D, 0x0C0C'0C0C, 0x0B0B'0B0B, 0x0A0A'0A0A, 0x0909'0909, 0x0808'0808, 0x0707'0707, 0x0606'0606, 0x0505'0505, 0x0404'0404, 0x0303'0303, 0x0202'0202, 0x0101'0101, 0x0000'0000);
+		const __m512i c_LaneSequence = _mm512_set1_epi32(0x0302'0100);
+
+		std::uint64_t carry   = 0;
+		std::uint64_t afterE0 = 0;
+		std::uint64_t afterED = 0;
+		std::uint64_t afterF0 = 0;
+		std::uint64_t afterF4 = 0;
+		__m512i       bytes   = _mm512_loadu_si512(input.Bytes);
+		for (std::size_t window = 0; window < inputSize; window += 64)
+		{
+			// The second window only has zeroes after it, which can never complete a sequence
+			__m512i next = window + 64 < sizeof(InputBlock) ? _mm512_loadu_si512(input.Bytes + window + 64) : _mm512_setzero_si512();
+
+			std::uint64_t range = RangeMask(start > window ? start - window : 0, inputSize - window);
+			std::uint64_t high  = _mm512_movepi8_mask(bytes);
+			std::uint64_t cont  = _mm512_cmplt_epu8_mask(bytes, _mm512_set1_epi8(static_cast<char>(0xC0))) & high;
+			std::uint64_t ge2   = _mm512_mask_cmpge_epu8_mask(range, bytes, _mm512_set1_epi8(static_cast<char>(0xC0)));
+			std::uint64_t ge3   = _mm512_mask_cmpge_epu8_mask(range, bytes, _mm512_set1_epi8(static_cast<char>(0xE0)));
+			std::uint64_t ge4   = _mm512_mask_cmpge_epu8_mask(range, bytes, _mm512_set1_epi8(static_cast<char>(0xF0)));
+			std::uint64_t bad   = _mm512_mask_cmpge_epu8_mask(range, bytes, _mm512_set1_epi8(static_cast<char>(0xF5))) | _mm512_mask_cmpeq_epu8_mask(range, _mm512_and_si512(bytes, _mm512_set1_epi8(static_cast<char>(0xFE))), _mm512_set1_epi8(static_cast<char>(0xC0)));
+			std::uint64_t e0    = _mm512_mask_cmpeq_epu8_mask(range, bytes, _mm512_set1_epi8(static_cast<char>(0xE0)));
+			std::uint64_t ed    = _mm512_mask_cmpeq_epu8_mask(range, bytes, _mm512_set1_epi8(static_cast<char>(0xED)));
+			std::uint64_t f0    = _mm512_mask_cmpeq_epu8_mask(range, bytes, _mm512_set1_epi8(static_cast<char>(0xF0)));
+			std::uint64_t f4    = _mm512_mask_cmpeq_epu8_mask(range, bytes, _mm512_set1_epi8(static_cast<char>(0xF4)));
+			std::uint64_t ge90  = _mm512_cmpge_epu8_mask(bytes, _mm512_set1_epi8(static_cast<char>(0x90)));
+			std::uint64_t geA0  = _mm512_cmpge_epu8_mask(bytes, _mm512_set1_epi8(static_cast<char>(0xA0)));
+
+			// Every leading byte requires the following bytes to be continuations, any other continuation is stray. After E0 the first
+			// of them also has to be from 0xA0 on and after F0 from 0x90 on, or the sequence is overlong. After ED it has to be below 0xA0,
+			// or it is a surrogate, after F4 below 0x90, or it is past U+10FFFF. C0 and C1 only start overlong sequences.
+			std::uint64_t required   = carry | ge2 << 1 | ge3 << 2 | ge4 << 3;
+			std::uint64_t leadErrors = bad | (cont & range & ~required);
+			std::uint64_t contErrors = (required & ~cont) | ((afterE0 | e0 << 1) & ~geA0) | ((afterED | ed << 1) & geA0) | ((afterF0 | f0 << 1) & ~ge90) | ((afterF4 | f4 << 1) & ge90);
+			carry                    = ge2 >> 63 | ge3 >> 62 | ge4 >> 61;
+			afterE0                  = e0 >> 63;
+			afterED                  = ed >> 63;
+			afterF0                  = f0 >> 63;
+			afterF4                  = f4 >> 63;
+			if (carry && window + 64 >= inputSize)
+			{
+				std::uint64_t nextCont = _mm512_cmplt_epu8_mask(next, _mm512_set1_epi8(static_cast<char>(0xC0))) & _mm512_movepi8_mask(next);
+				std::uint64_t nextGe90 = _mm512_cmpge_epu8_mask(next, _mm512_set1_epi8(static_cast<char>(0x90)));
+				std::uint64_t nextGeA0 = _mm512_cmpge_epu8_mask(next, _mm512_set1_epi8(static_cast<char>(0xA0)));
+				if ((carry & ~nextCont) | (afterE0 & ~nextGeA0) | (afterED & nextGeA0) | (afterF0 & ~nextGe90) | (afterF4 & nextGe90))
+					contErrors |= 1ULL << 63;
+			}
+			if (leadErrors | contErrors)
+				return std::countr_zero(leadErrors) < std::countr_zero(contErrors) ? EError::InvalidLeading : EError::InvalidContinuation;
+			if (window + 64 >= inputSize)
+			{
+				// The next block skips the continuation bytes at its start, any past the last sequence here are stray
+				std::size_t next = inputSize + std::popcount(required & ~RangeMask(0, inputSize - window)) + std::popcount(carry);
+				if (next < sizeof(InputBlock) && (input.Bytes[next] & 0xC0) == 0x80)
+					return EError::InvalidLeading;
+			}
+
+			std::uint64_t leaders = range & ~cont;
+			std::uint32_t count   = std::popcount(leaders);
+			if (!(high & range))
+			{
+				// Pure ASCII, the bytes in range are a single run of codepoints
+				const std::uint8_t* ascii = input.Bytes + window + std::countr_zero(range);
+				if constexpr (To == EEncoding::UTF16)
+				{
+					for (std::uint32_t lane = 0; lane < count; lane += 32)
+					{
+						__mmask32 laneMask = static_cast<__mmask32>(RangeMask(0, count - lane));
+						_mm512_mask_storeu_epi16(output.Bytes + outputSize + lane * 2, laneMask, _mm512_cvtepu8_epi16(_mm256_maskz_loadu_epi8(laneMask, ascii + lane)));
+					}
+					outputSize += count * 2;
+				}
+				else
+				{
+					for (std::uint32_t lane = 0; lane < count; lane += 16)
+					{
+						__mmask16 laneMask = static_cast<__mmask16>(RangeMask(0, count - lane));
+						_mm512_mask_storeu_epi32(output.Bytes + outputSize + lane * 4, laneMask, _mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(laneMask, ascii + lane)));
+					}
+					outputSize += count * 4;
+				}
+				bytes = next;
+				continue;
+			}
+
+			// Offsets of the leading bytes, each lane then gathers the 4 bytes starting at its own offset
+			__m512i offsets = _mm512_maskz_compress_epi8(leaders, c_Iota);
+			for (std::uint32_t lane = 0; lane < count; lane += 16)
+			{
+				__m512i gather = _mm512_add_epi8(_mm512_permutexvar_epi8(_mm512_add_epi8(c_LaneSpread, _mm512_set1_epi8(static_cast<char>(lane))), offsets), c_LaneSequence);
+				__m512i lanes  = _mm512_permutex2var_epi8(bytes, gather, next);
+				outputSize    += StoreCodepoints<To>(output, outputSize, DecodeUTF8Lanes(lanes), std::min<std::uint32_t>(count - lane, 16));
+			}
+			bytes = next;
+		}
+		return EError::Success;
+	}
+
+	template <EEncoding To>
+	static EError ConvBlockFrom16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize = 0;
+
+		__m512i       lo   = _mm512_and_si512(_mm512_loadu_si512(input.Bytes), _mm512_set1_epi16(static_cast<short>(0xFC00)));
+		__m512i       hi   = _mm512_and_si512(_mm512_loadu_si512(input.Bytes + 64), _mm512_set1_epi16(static_cast<short>(0xFC00)));
+		std::uint64_t high = _mm512_cmpeq_epi16_mask(lo, _mm512_set1_epi16(static_cast<short>(0xD800))) | static_cast<std::uint64_t>(_mm512_cmpeq_epi16_mask(hi, _mm512_set1_epi16(static_cast<short>(0xD800)))) << 32;
+		std::uint64_t low  = _mm512_cmpeq_epi16_mask(lo, _mm512_set1_epi16(static_cast<short>(0xDC00))) | static_cast<std::uint64_t>(_mm512_cmpeq_epi16_mask(hi, _mm512_set1_epi16(static_cast<short>(0xDC00)))) << 32;
+
+		// A low surrogate at the start belongs to a pair started in the previous block
+		std::size_t   units    = (inputSize + 1) / 2;
+		std::uint64_t range    = RangeMask(low & 1, units);
+		std::uint64_t leaders  = high & range;
+		std::uint64_t required = leaders << 1;
+		if ((required & ~low) || (leaders >> 63))
+			return EError::InvalidContinuation;
+		if (low & range & ~required)
+			return EError::InvalidLeading;
+
+		// Same for a low surrogate at the start of the next block
+		std::size_t next = units < 64 ? units + ((required >> units) & 1) : 64;
+		if (inputSize && next < 64 && ((low >> next) & 1))
+			return EError::InvalidLeading;
+
+		std::uint64_t keep = range & ~low;
+		for (std::size_t group = 0; group < units; group += 16)
+		{
+			const std::uint8_t* bytes = input.Bytes + group * 2;
+
+			if constexpr (To == EEncoding::UTF8)
+			{
+				// Whole runs of ASCII are narrowed without encoding
+				if (group + 32 <= units && ((keep >> group) & 0xFFFF'FFFF) == 0xFFFF'FFFF)
+				{
+					__m512i chunk = _mm512_loadu_si512(bytes);
+					if (!_mm512_test_epi16_mask(chunk, _mm512_set1_epi16(static_cast<short>(0xFF80))))
+					{
+						_mm256_storeu_si256(reinterpret_cast<__m256i*>(output.Bytes + outputSize), _mm512_cvtepi16_epi8(chunk));
+						outputSize += 32;
+						group      += 16;
+						continue;
+					}
+				}
+			}
+
+			__mmask16 groupKeep  = static_cast<__mmask16>(keep >> group);
+			__m512i   codepoints = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes)));
+			if (__mmask16 groupLeaders = static_cast<__mmask16>(leaders >> group))
+			{
+				// Combine each high surrogate with the unit after it, the low surrogate lanes get dropped
+				__m512i next  = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(group + 16 < 64 ? 0xFFFF : 0x7FFF, bytes + 2));
+				__m512i pairs = _mm512_add_epi32(_mm512_add_epi32(_mm512_slli_epi32(codepoints, 10), next), _mm512_set1_epi32(0x1'0000 - (0xD800 << 10) - 0xDC00));
+				codepoints    = _mm512_mask_mov_epi32(codepoints, groupLeaders, pairs);
+			}
+			if (groupKeep)
+				outputSize += StoreCodepoints<To>(output, outputSize, _mm512_maskz_compress_epi32(groupKeep, codepoints), std::popcount(groupKeep));
+		}
+		return EError::Success;
+	}
+
+	template <EEncoding To>
+	static EError ConvBlockFrom32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize = 0;
+
+		std::size_t units = (inputSize + 3) / 4;
+		for (std::size_t group = 0; group < units; group += 16)
+		{
+			std::uint32_t count      = static_cast<std::uint32_t>(std::min<std::size_t>(units - group, 16));
+			__m512i       codepoints = _mm512_maskz_loadu_epi32(static_cast<__mmask16>(RangeMask(0, count)), input.Bytes + group * 4);
+			if (InvalidCodepoints(codepoints))
+				return EError::OOB;
+			outputSize += StoreCodepoints<To>(output, outputSize, codepoints, count);
+		}
+		return EError::Success;
+	}
+
+	EError CalcReqSize8To16(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeFrom8<EEncoding::UTF16>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSize8To32(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeFrom8<EEncoding::UTF32>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSize16To8(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeFrom16<EEncoding::UTF8>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSize16To32(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeFrom16<EEncoding::UTF32>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSize32To8(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeFrom32<EEncoding::UTF8>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSize32To16(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeFrom32<EEncoding::UTF16>(input, inputSize, requiredSize);
+	}
+
+	EError ConvBlock8To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockFrom8<EEncoding::UTF16>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlock8To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockFrom8<EEncoding::UTF32>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlock16To8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockFrom16<EEncoding::UTF8>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlock16To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockFrom16<EEncoding::UTF32>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlock32To8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockFrom32<EEncoding::UTF8>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlock32To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockFrom32<EEncoding::UTF16>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBuffer8To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockFrom8<EEncoding::UTF16>>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer8To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockFrom8<EEncoding::UTF32>>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer16To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockFrom16<EEncoding::UTF8>>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer16To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockFrom16<EEncoding::UTF32>>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer32To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockFrom32<EEncoding::UTF8>>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer32To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockFrom32<EEncoding::UTF16>>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+#else
+	EError CalcReqSize8To16(const void*, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError CalcReqSize8To32(const void*, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError CalcReqSize16To8(const void*, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError CalcReqSize16To32(const void*, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError CalcReqSize32To8(const void*, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError CalcReqSize32To16(const void*, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBlock8To16(const InputBlock&, OutputBlock&, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBlock8To32(const InputBlock&, OutputBlock&, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBlock16To8(const InputBlock&, OutputBlock&, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBlock16To32(const InputBlock&, OutputBlock&, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBlock32To8(const InputBlock&, OutputBlock&, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBlock32To16(const InputBlock&, OutputBlock&, std::size_t, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBuffer8To16(const void*, std::size_t, std::size_t, void*, std::size_t&, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBuffer8To32(const void*, std::size_t, std::size_t, void*, std::size_t&, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBuffer16To8(const void*, std::size_t, std::size_t, void*, std::size_t&, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBuffer16To32(const void*, std::size_t, std::size_t, void*, std::size_t&, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBuffer32To8(const void*, std::size_t, std::size_t, void*, std::size_t&, std::size_t&) { return EError::MissingImpl; }
+
+	EError ConvBuffer32To16(const void*, std::size_t, std::size_t, void*, std::size_t&, std::size_t&) { return EError::MissingImpl; }
+#endif
+} // namespace UTF::AVX512
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#if defined(__clang__)
+		#pragma clang attribute pop
+	#elif defined(__GNUC__)
+		#pragma GCC diagnostic pop
+		#pragma GCC pop_options
+	#endif
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "UTF/Base.h"
+
+#include <cstring>
+
+namespace UTF::Details
+{
+	// Reads eight bytes of Size byte units, runs of ASCII are taken a word at a time instead of a unit at a time through the tables
+	template <std::size_t Size>
+	static bool LoadAscii(const void* input, std::uint64_t& word)
+	{
+		std::memcpy(&word, input, sizeof(word));
+		return (word & Details::c_NonAsciiBits<Size>) == 0;
+	}
+
+	// Stores the ASCII units of word as OutSize byte units
+	template <std::size_t Size, std::size_t OutSize>
+	static void StoreAscii(std::uint64_t word, void* output)
+	{
+		std::uint8_t* outputBuf = static_cast<std::uint8_t*>(output);
+		if constexpr (OutSize < Size)
+		{
+			std::uint64_t packed = Details::ResizeAsciiLanes<Size, OutSize>(word);
+			std::memcpy(outputBuf, &packed, sizeof(word) * OutSize / Size);
+		}
+		else
+		{
+			// Every output word is widened from its own part of the input word
+			constexpr std::size_t c_Parts    = OutSize / Size;
+			constexpr std::size_t c_PartBits = 64 / c_Parts;
+			for (std::size_t part = 0; part < c_Parts; ++part)
+			{
+				std::uint64_t wide = Details::ResizeAsciiLanes<Size, OutSize>(word >> (part * c_PartBits) & ((std::uint64_t { 1 } << c_PartBits) - 1));
+				std::memcpy(outputBuf + part * sizeof(wide), &wide, sizeof(wide));
+			}
+		}
+	}
+} // namespace UTF::Details
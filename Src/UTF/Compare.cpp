@@ -0,0 +1,209 @@
+#include "UTF/UTF.h"
+#include "Decode.h"
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+
+namespace UTF
+{
+	// Each side is decoded in chunks of c_FirstChunkSize bytes doubling up to c_CompareChunkSize, texts that differ early stop after decoding little past the difference
+	static constexpr std::size_t c_FirstChunkSize   = 1024;
+	static constexpr std::size_t c_CompareChunkSize = 4096;
+	// Runs of equal units are compared this many bytes at a time
+	static constexpr std::size_t c_SameRunSize = 64;
+
+	// Codepoints of one side decoded ahead of the other
+	template <EEncoding Encoding>
+	struct CompareSide
+	{
+		using C = Details::CharTypeT<Encoding>;
+
+		const C*    Units;
+		std::size_t Size;
+		std::size_t Offset;
+		std::size_t First = 0; // Codepoints of the chunk already compared
+		std::size_t Count = 0; // Codepoints decoded and not compared yet
+		std::size_t Chunk = c_FirstChunkSize;
+
+		alignas(OutputBlock) char32_t Codepoints[(Details::MaxOutputSize<Encoding, EEncoding::UTF32>(c_CompareChunkSize) + sizeof(OutputBlock)) / sizeof(char32_t)];
+
+		// Codepoints is left uninitialized, only what Refill decodes is read
+		CompareSide(const C* units, std::size_t size, std::size_t offset)
+			: Units(units),
+			  Size(size),
+			  Offset(offset) {}
+
+		// Decodes the next chunk once the last one is compared, false when there is nothing left
+		bool Refill(EImpl impl)
+		{
+			while (Count == 0 && Offset < Size)
+			{
+				First = 0;
+				Count = Details::DecodeReplaced<Encoding>(Units, Size, Offset, Chunk, Codepoints, impl);
+				Chunk = std::min(Chunk * 2, c_CompareChunkSize);
+			}
+			return Count > 0;
+		}
+	};
+
+	// Moves index back to where input split decodes the same as it does whole, whatever the units from index on are.
+	// A unit that can't continue a sequence starts one either way, and no UTF-8 sequence reaches past the 3 bytes after its leading byte.
+	template <class C>
+	static std::size_t SplitBefore(const C* input, std::size_t index)
+	{
+		if constexpr (Details::EncodingTypeV<C> == EEncoding::UTF8)
+		{
+			for (std::size_t back = 1; back <= 3 && back <= index; ++back)
+			{
+				if (input[index - back] >= 0xC0)
+					return index - back;
+			}
+		}
+		else if constexpr (Details::EncodingTypeV<C> == EEncoding::UTF16)
+		{
+			if (index > 0 && (input[index - 1] & 0xFC00) == 0xD800)
+				return index - 1;
+		}
+		return index;
+	}
+
+	// Units at the start of lhs and rhs that are the same, moved back to where both can be split
+	template <class C>
+	static std::size_t SamePrefix(const C* lhs, const C* rhs, std::size_t size)
+	{
+		constexpr std::size_t c_Step = c_SameRunSize / sizeof(C);
+
+		std::size_t same = 0;
+		while (same + c_Step <= size && std::memcmp(lhs + same, rhs + same, c_SameRunSize) == 0)
+			same += c_Step;
+		while (same < size && lhs[same] == rhs[same])
+			++same;
+		return SplitBefore(lhs, same);
+	}
+
+	// Decodes a codepoint of each side at a time, for texts too short to go through the kernels
+	template <class C1, class C2>
+	static int CompareSequences(const C1* lhs, std::size_t lhsCount, const C2* rhs, std::size_t rhsCount, std::size_t lhsIndex, std::size_t rhsIndex)
+	{
+		while (lhsIndex < lhsCount && rhsIndex < rhsCount)
+		{
+			auto lhsUnit = static_cast<std::make_unsigned_t<C1>>(lhs[lhsIndex]);
+			auto rhsUnit = static_cast<std::make_unsigned_t<C2>>(rhs[rhsIndex]);
+			if (lhsUnit < 0x80 && rhsUnit < 0x80)
+			{
+				if (lhsUnit != rhsUnit)
+					return lhsUnit < rhsUnit ? -1 : 1;
+				++lhsIndex;
+				++rhsIndex;
+				continue;
+			}
+			char32_t lhsPoint = 0;
+			char32_t rhsPoint = 0;
+			Details::DecodeSubpart(lhs, lhsCount, lhsIndex, lhsPoint);
+			Details::DecodeSubpart(rhs, rhsCount, rhsIndex, rhsPoint);
+			if (lhsPoint != rhsPoint)
+				return lhsPoint < rhsPoint ? -1 : 1;
+		}
+		return (lhsIndex < lhsCount) - (rhsIndex < rhsCount);
+	}
+
+	template <EEncoding LhsEncoding, EEncoding RhsEncoding>
+	static int CompareText(const void* lhs, std::size_t lhsSize, const void* rhs, std::size_t rhsSize, EImpl impl)
+	{
+		using C1 = Details::CharTypeT<LhsEncoding>;
+		using C2 = Details::CharTypeT<RhsEncoding>;
+
+		const C1*   lhsUnits = static_cast<const C1*>(lhs);
+		const C2*   rhsUnits = static_cast<const C2*>(rhs);
+		std::size_t lhsCount = lhsSize / sizeof(C1);
+		std::size_t rhsCount = rhsSize / sizeof(C2);
+
+		// The kernels match the ASCII both start with, the narrower units widened into the lanes of the wider ones.
+		// Units of the same size in different encodings only decode the same while they are ASCII.
+		std::size_t prefix = 0;
+		std::size_t size   = std::min(lhsCount, rhsCount);
+		if constexpr (LhsEncoding == RhsEncoding)
+			prefix = SamePrefix(lhsUnits, rhsUnits, size);
+		else if constexpr (sizeof(C1) == sizeof(C2))
+			prefix = Details::AsciiPrefix(lhsUnits, SamePrefix(lhsUnits, reinterpret_cast<const C1*>(rhsUnits), size));
+		else if constexpr (sizeof(C1) < sizeof(C2))
+			s_AsciiMatchImpls[static_cast<std::uint8_t>(LhsEncoding)][static_cast<std::uint8_t>(RhsEncoding)][static_cast<std::uint8_t>(impl)](lhsUnits, rhsUnits, size, prefix);
+		else
+			s_AsciiMatchImpls[static_cast<std::uint8_t>(RhsEncoding)][static_cast<std::uint8_t>(LhsEncoding)][static_cast<std::uint8_t>(impl)](rhsUnits, lhsUnits, size, prefix);
+
+		// Both decode to the same codepoints up to prefix, a side that ends there or an ASCII unit on both decides without decoding the rest
+		if (prefix == lhsCount || prefix == rhsCount)
+			return (prefix < lhsCount) - (prefix < rhsCount);
+		auto lhsUnit = static_cast<std::make_unsigned_t<C1>>(lhsUnits[prefix]);
+		auto rhsUnit = static_cast<std::make_unsigned_t<C2>>(rhsUnits[prefix]);
+		if (lhsUnit < 0x80 && rhsUnit < 0x80 && lhsUnit != rhsUnit)
+			return lhsUnit < rhsUnit ? -1 : 1;
+
+		if ((lhsCount - prefix) * sizeof(C1) < c_SmallMaxSize && (rhsCount - prefix) * sizeof(C2) < c_SmallMaxSize)
+			return CompareSequences<C1, C2>(lhsUnits, lhsCount, rhsUnits, rhsCount, prefix, prefix);
+
+		CompareSide<LhsEncoding> lhsSide(lhsUnits, lhsCount, prefix);
+		CompareSide<RhsEncoding> rhsSide(rhsUnits, rhsCount, prefix);
+		while (true)
+		{
+			bool lhsLeft = lhsSide.Refill(impl);
+			bool rhsLeft = rhsSide.Refill(impl);
+			if (!lhsLeft || !rhsLeft)
+				return lhsLeft - rhsLeft;
+
+			std::size_t     count     = std::min(lhsSide.Count, rhsSide.Count);
+			const char32_t* lhsPoints = lhsSide.Codepoints + lhsSide.First;
+			const char32_t* rhsPoints = rhsSide.Codepoints + rhsSide.First;
+			if (std::memcmp(lhsPoints, rhsPoints, count * sizeof(char32_t)) != 0)
+			{
+				auto [lhsPoint, rhsPoint] = std::mismatch(lhsPoints, lhsPoints + count, rhsPoints);
+				return *lhsPoint < *rhsPoint ? -1 : 1;
+			}
+			lhsSide.First += count;
+			lhsSide.Count -= count;
+			rhsSide.First += count;
+			rhsSide.Count -= count;
+		}
+	}
+
+	template <EEncoding LhsEncoding>
+	static int CompareWith(const void* lhs, std::size_t lhsSize, EEncoding rhsEncoding, const void* rhs, std::size_t rhsSize, EImpl impl)
+	{
+		switch (rhsEncoding)
+		{
+		case EEncoding::UTF16:
+			return CompareText<LhsEncoding, EEncoding::UTF16>(lhs, lhsSize, rhs, rhsSize, impl);
+		case EEncoding::UTF32:
+			return CompareText<LhsEncoding, EEncoding::UTF32>(lhs, lhsSize, rhs, rhsSize, impl);
+		case EEncoding::Latin1:
+			return CompareText<LhsEncoding, EEncoding::Latin1>(lhs, lhsSize, rhs, rhsSize, impl);
+		case EEncoding::ASCII:
+			return CompareText<LhsEncoding, EEncoding::ASCII>(lhs, lhsSize, rhs, rhsSize, impl);
+		default:
+			return CompareText<LhsEncoding, EEncoding::UTF8>(lhs, lhsSize, rhs, rhsSize, impl);
+		}
+	}
+
+	namespace Details
+	{
+		int CompareCodepoints(EEncoding lhsEncoding, const void* lhs, std::size_t lhsSize, EEncoding rhsEncoding, const void* rhs, std::size_t rhsSize, EImpl impl)
+		{
+			if (impl == EImpl::Fastest)
+				impl = GetFastestImpl();
+			switch (lhsEncoding)
+			{
+			case EEncoding::UTF16:
+				return CompareWith<EEncoding::UTF16>(lhs, lhsSize, rhsEncoding, rhs, rhsSize, impl);
+			case EEncoding::UTF32:
+				return CompareWith<EEncoding::UTF32>(lhs, lhsSize, rhsEncoding, rhs, rhsSize, impl);
+			case EEncoding::Latin1:
+				return CompareWith<EEncoding::Latin1>(lhs, lhsSize, rhsEncoding, rhs, rhsSize, impl);
+			case EEncoding::ASCII:
+				return CompareWith<EEncoding::ASCII>(lhs, lhsSize, rhsEncoding, rhs, rhsSize, impl);
+			default:
+				return CompareWith<EEncoding::UTF8>(lhs, lhsSize, rhsEncoding, rhs, rhsSize, impl);
+			}
+		}
+	} // namespace Details
+} // namespace UTF
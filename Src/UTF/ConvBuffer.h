@@ -0,0 +1,44 @@
+#pragma once
+
+#include "UTF/Base.h"
+
+#include <cstring>
+
+namespace UTF::Details
+{
+	using ConvBlockKernelF = EError (*)(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize);
+
+	// Runs a block kernel over inputSize / alignof(InputBlock) consecutive blocks, with the kernel known at compile time the loop calls it directly.
+	// Kernels may read the whole InputBlock, so blocks with less than that left in readableSize are staged.
+	template <ConvBlockKernelF Kernel>
+	static EError ConvBuffer(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		const std::uint8_t* inputBuf  = static_cast<const std::uint8_t*>(input);
+		std::uint8_t*       outputBuf = static_cast<std::uint8_t*>(output);
+		outputSize                    = 0;
+
+		InputBlock staged;
+		for (std::size_t offset = 0; offset < inputSize; offset += alignof(InputBlock))
+		{
+			const InputBlock* block     = reinterpret_cast<const InputBlock*>(inputBuf + offset);
+			std::size_t       remaining = readableSize - offset;
+			if (remaining < sizeof(InputBlock))
+			{
+				std::memcpy(&staged, block, remaining);
+				std::memset(reinterpret_cast<std::uint8_t*>(&staged) + remaining, 0, sizeof(staged) - remaining);
+				block = &staged;
+			}
+
+			std::size_t bytesWritten = 0;
+			EError      error        = Kernel(*block, *reinterpret_cast<OutputBlock*>(outputBuf + outputSize), alignof(InputBlock), bytesWritten);
+			if (error != EError::Success)
+			{
+				consumed = offset;
+				return error;
+			}
+			outputSize += bytesWritten;
+		}
+		consumed = inputSize;
+		return EError::Success;
+	}
+} // namespace UTF::Details
@@ -0,0 +1,195 @@
+#include "UTF/DFA.h"
+#include "Ascii.h"
+#include "ConvBuffer.h"
+#include "LUTs.h"
+
+namespace UTF::DFA
+{
+	static constexpr std::uint32_t c_Accept = 0;
+	static constexpr std::uint32_t c_Reject = 12;
+
+	// Feeds one byte to the DFA. The payload bits are collected without branching on the state, so input mixing sequence lengths does not mispredict.
+	static inline void Step(std::uint8_t byte, std::uint32_t& state, char32_t& codepoint)
+	{
+		std::uint32_t type = LUTs::UTF8DFAClasses[byte];
+		codepoint          = state != c_Accept ? (byte & 0x3Fu) | codepoint << 6 : (0xFFu >> type) & byte;
+		state              = LUTs::UTF8DFATransitions[state + type];
+	}
+
+	// Walks the bytes again to tell whether the rejected byte should have started a sequence or continued one, only runs once the DFA rejected
+	static EError RejectError(const std::uint8_t* bytes, std::size_t size)
+	{
+		std::uint32_t state     = c_Accept;
+		char32_t      codepoint = 0;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			std::uint32_t previous = state;
+			Step(bytes[i], state, codepoint);
+			if (state == c_Reject)
+				return previous == c_Accept ? EError::InvalidLeading : EError::InvalidContinuation;
+		}
+		return EError::InvalidContinuation;
+	}
+
+	// Up to 3 continuation bytes belong to a sequence started in the previous block, it already validated them
+	static std::size_t SkipLeadingTail(const std::uint8_t* bytes, std::size_t size)
+	{
+		std::size_t i = 0;
+		while (i < 3 && i < size && (bytes[i] & 0xC0) == 0x80)
+			++i;
+		return i;
+	}
+
+	EError CalcReqSize8To16(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize                 = 0;
+		const std::uint8_t* inputBuf = static_cast<const std::uint8_t*>(input);
+
+		// Every four byte lead of valid input turns into a surrogate pair, so the units are counted without decoding
+		std::uint32_t state = c_Accept;
+		std::size_t   units = 0;
+		for (std::size_t i = 0; i < inputSize; ++i)
+		{
+			// ASCII only moves the DFA from accept to accept, so whole words of it skip the tables
+			std::uint64_t ascii;
+			if (state == c_Accept && i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf + i, ascii))
+			{
+				units += 8;
+				i     += 7;
+				continue;
+			}
+
+			std::uint8_t byte  = inputBuf[i];
+			state              = LUTs::UTF8DFATransitions[state + LUTs::UTF8DFAClasses[byte]];
+			units             += (state == c_Accept) + (byte >= 0xF0);
+		}
+		if (state == c_Reject)
+			return RejectError(inputBuf, inputSize);
+		if (state != c_Accept)
+			return EError::InvalidContinuation;
+		requiredSize = units * sizeof(char16_t);
+		return EError::Success;
+	}
+
+	EError CalcReqSize8To32(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize                 = 0;
+		const std::uint8_t* inputBuf = static_cast<const std::uint8_t*>(input);
+
+		std::uint32_t state = c_Accept;
+		std::size_t   units = 0;
+		for (std::size_t i = 0; i < inputSize; ++i)
+		{
+			std::uint64_t ascii;
+			if (state == c_Accept && i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf + i, ascii))
+			{
+				units += 8;
+				i     += 7;
+				continue;
+			}
+
+			state  = LUTs::UTF8DFATransitions[state + LUTs::UTF8DFAClasses[inputBuf[i]]];
+			units += state == c_Accept;
+		}
+		if (state == c_Reject)
+			return RejectError(inputBuf, inputSize);
+		if (state != c_Accept)
+			return EError::InvalidContinuation;
+		requiredSize = units * sizeof(char32_t);
+		return EError::Success;
+	}
+
+	EError ConvBlock8To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize                    = 0;
+		const std::uint8_t* inputBuf  = input.Bytes;
+		char16_t*           outputBuf = reinterpret_cast<char16_t*>(&output);
+
+		std::size_t   start     = SkipLeadingTail(inputBuf, inputSize);
+		std::size_t   i         = start;
+		std::uint32_t state     = c_Accept;
+		char32_t      codepoint = 0;
+		std::size_t   written   = 0;
+		auto          step      = [&]() {
+			Step(inputBuf[i++], state, codepoint);
+			// Both units are stored for every byte, only a completed codepoint moves past them
+			char32_t surrogate     = codepoint - 0x1'0000;
+			bool     pair          = codepoint > 0xFFFF;
+			outputBuf[written]     = static_cast<char16_t>(pair ? 0xD800 | (surrogate >> 10) : codepoint);
+			outputBuf[written + 1] = static_cast<char16_t>(0xDC00 | (surrogate & 0x3FF));
+			written               += state == c_Accept ? 1 + pair : 0;
+		};
+		while (i < inputSize)
+		{
+			std::uint64_t ascii;
+			if (state == c_Accept && i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf + i, ascii))
+			{
+				Details::StoreAscii<1, 2>(ascii, outputBuf + written);
+				i       += 8;
+				written += 8;
+				continue;
+			}
+			step();
+		}
+		// The last sequence may continue past inputSize, an input that ends inside it is padded with zeros and rejected
+		while (state != c_Accept && state != c_Reject && i < sizeof(InputBlock))
+			step();
+
+		if (state != c_Accept)
+			return RejectError(inputBuf + start, i - start);
+		// The next block skips the continuation bytes at its start, any past the last sequence here are stray
+		if (inputSize && i < sizeof(InputBlock) && (inputBuf[i] & 0xC0) == 0x80)
+			return EError::InvalidLeading;
+		outputSize = written * sizeof(char16_t);
+		return EError::Success;
+	}
+
+	EError ConvBlock8To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize                    = 0;
+		const std::uint8_t* inputBuf  = input.Bytes;
+		char32_t*           outputBuf = reinterpret_cast<char32_t*>(&output);
+
+		std::size_t   start     = SkipLeadingTail(inputBuf, inputSize);
+		std::size_t   i         = start;
+		std::uint32_t state     = c_Accept;
+		char32_t      codepoint = 0;
+		std::size_t   written   = 0;
+		auto          step      = [&]() {
+			Step(inputBuf[i++], state, codepoint);
+			outputBuf[written]  = codepoint;
+			written            += state == c_Accept;
+		};
+		while (i < inputSize)
+		{
+			std::uint64_t ascii;
+			if (state == c_Accept && i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf + i, ascii))
+			{
+				Details::StoreAscii<1, 4>(ascii, outputBuf + written);
+				i       += 8;
+				written += 8;
+				continue;
+			}
+			step();
+		}
+		while (state != c_Accept && state != c_Reject && i < sizeof(InputBlock))
+			step();
+
+		if (state != c_Accept)
+			return RejectError(inputBuf + start, i - start);
+		if (inputSize && i < sizeof(InputBlock) && (inputBuf[i] & 0xC0) == 0x80)
+			return EError::InvalidLeading;
+		outputSize = written * sizeof(char32_t);
+		return EError::Success;
+	}
+
+	EError ConvBuffer8To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock8To16>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer8To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock8To32>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+} // namespace UTF::DFA
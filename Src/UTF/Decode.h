@@ -0,0 +1,97 @@
+#pragma once
+
+#include "UTF/UTF.h"
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+
+namespace UTF::Details
+{
+	// Decodes the less than an InputBlock of units left from offset the way ConvertBlocks converts them, a block of alignof(InputBlock) bytes
+	// at a time staged with zeros after it. Only the blocks the kernel rejects are decoded a sequence at a time.
+	template <EEncoding From>
+	static std::size_t DecodeSmall(const CharTypeT<From>* units, std::size_t size, std::size_t& offset, std::span<char32_t> output, EImpl impl)
+	{
+		using C = CharTypeT<From>;
+
+		constexpr std::size_t c_BlockUnits = alignof(InputBlock) / sizeof(C);
+		auto                  convertRange = &ConvertRange<char32_t, C, true>;
+		ConvBlockImplF        convBlock    = From == EEncoding::UTF32 ? nullptr : s_ConvBlockImpls[static_cast<std::uint8_t>(From)][static_cast<std::uint8_t>(EEncoding::UTF32)][static_cast<std::uint8_t>(impl)];
+
+		// The units the first block skips have no sequence in front of them to belong to, the kernel still starts in front of them
+		std::size_t tail    = offset;
+		std::size_t written = 0;
+		convertRange(units, size, tail, offset, output.data(), written);
+
+		while (offset < size)
+		{
+			// The kernel reads the units staged after the block for the sequence the block ends with
+			std::size_t blockSize  = std::min(size - offset, c_BlockUnits);
+			std::size_t readable   = (size - offset) * sizeof(C);
+			std::size_t outputSize = 0;
+			InputBlock  inputBlock;
+			OutputBlock outputBlock;
+			std::memcpy(inputBlock.Bytes, units + offset, readable);
+			std::memset(inputBlock.Bytes + readable, 0, sizeof(InputBlock) - readable);
+			if (convBlock && convBlock(inputBlock, outputBlock, blockSize * sizeof(C), outputSize) == EError::Success)
+			{
+				std::memcpy(output.data() + written, outputBlock.Bytes, outputSize);
+				written += outputSize / sizeof(char32_t);
+			}
+			else
+			{
+				std::size_t index   = offset + LeadingTail<From>(inputBlock.Bytes, readable) / sizeof(C);
+				std::size_t decoded = 0;
+				convertRange(units, size, index, offset + blockSize, output.data() + written, decoded);
+				written += decoded;
+			}
+			offset += blockSize;
+		}
+		return written;
+	}
+
+	// Decodes about chunkSize bytes of units from offset into output the way EErrorPolicy::Replace converts them, moves offset past them and returns the codepoints written.
+	// The chunk ends where splitting gives the same replacements, output needs room for MaxOutputSize of chunkSize plus an OutputBlock and for c_SmallMaxSize codepoints.
+	// Less than an InputBlock left skips the setup of ConvertInto, which costs more than decoding that little.
+	template <EEncoding From>
+	static std::size_t DecodeReplaced(const CharTypeT<From>* units, std::size_t size, std::size_t& offset, std::size_t chunkSize, std::span<char32_t> output, EImpl impl)
+	{
+		using C = CharTypeT<From>;
+
+		if ((size - offset) * sizeof(C) < c_SmallMaxSize)
+		{
+			std::size_t ascii = AsciiPrefix(units + offset, size - offset);
+			CopyAscii(units + offset, output.data(), ascii);
+			offset += ascii;
+			return ascii + DecodeSmall<From>(units, size, offset, output.subspan(ascii), impl);
+		}
+
+		std::size_t end = ReplaceBoundary(units, size, std::min(offset + chunkSize / sizeof(C), size));
+		if constexpr (From == EEncoding::UTF32)
+		{
+			for (std::size_t index = offset; index < end; ++index)
+				output[index - offset] = units[index] < 0x11'0000 && (units[index] & 0xFFFF'F800) != 0xD800 ? units[index] : 0xFFFD;
+			std::size_t decoded = end - offset;
+			offset              = end;
+			return decoded;
+		}
+		else
+		{
+			// A chunk ReplaceBoundary moved far past chunkSize runs out of room and is resumed from where it stopped
+			ConvertResult result = ConvertInto<char32_t, C>(std::span<const C>(units + offset, end - offset), output, impl, EErrorPolicy::Replace);
+			if (result.Consumed > 0)
+			{
+				offset += result.Consumed;
+				return result.Written;
+			}
+
+			// Neither Hash nor Compare can report the kernels failing without progress, the chunk is decoded a maximal subpart at a time instead.
+			// Stopping between two of them decodes the same as going on, so output running out only leaves the rest to the next chunk.
+			std::size_t decoded = 0;
+			while (offset < end && decoded < output.size())
+				DecodeSubpart(units, size, offset, output[decoded++]);
+			return decoded;
+		}
+	}
+} // namespace UTF::Details
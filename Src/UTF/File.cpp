@@ -0,0 +1,284 @@
+#include "UTF/UTF.h"
+
+#include <string>
+
+#if BUILD_IS_SYSTEM_WINDOWS
+	#include <Windows.h>
+#elif BUILD_IS_SYSTEM_UNIX
+	#include <cerrno>
+
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace UTF
+{
+#if BUILD_IS_SYSTEM_WINDOWS || BUILD_IS_SYSTEM_UNIX
+	#if BUILD_IS_SYSTEM_WINDOWS
+	using FileHandle = HANDLE;
+
+	static bool WriteAll(FileHandle file, const std::uint8_t* data, std::size_t size)
+	{
+		while (size > 0)
+		{
+			DWORD written = 0;
+			DWORD chunk   = static_cast<DWORD>(size < 0x4000'0000 ? size : 0x4000'0000);
+			if (!WriteFile(file, data, chunk, &written, nullptr) || written == 0)
+				return false;
+			data += written;
+			size -= written;
+		}
+		return true;
+	}
+
+	static void* AllocateBuffer(std::size_t size)
+	{
+		return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+
+	static void FreeBuffer(void* buffer, [[maybe_unused]] std::size_t size)
+	{
+		VirtualFree(buffer, 0, MEM_RELEASE);
+	}
+
+	static std::size_t PageSize()
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return info.dwPageSize;
+	}
+
+	// Unlocking pages that were never locked takes them out of the working set
+	static void ReleaseInput(const std::uint8_t* data, std::size_t size)
+	{
+		VirtualUnlock(const_cast<std::uint8_t*>(data), size);
+	}
+	#else
+	using FileHandle = int;
+
+	static bool WriteAll(FileHandle file, const std::uint8_t* data, std::size_t size)
+	{
+		while (size > 0)
+		{
+			ssize_t written = ::write(file, data, size);
+			if (written < 0 && errno == EINTR)
+				continue;
+			if (written <= 0)
+				return false;
+			data += written;
+			size -= static_cast<std::size_t>(written);
+		}
+		return true;
+	}
+
+	static void AdviseHugePages([[maybe_unused]] void* address, [[maybe_unused]] std::size_t size)
+	{
+		// Only a hint, kernels without transparent huge pages for the mapping type reject it
+		#if defined(MADV_HUGEPAGE)
+		::madvise(address, size, MADV_HUGEPAGE);
+		#endif
+	}
+
+	static void* AllocateBuffer(std::size_t size)
+	{
+		void* buffer = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (buffer == MAP_FAILED)
+			return nullptr;
+		AdviseHugePages(buffer, size);
+		return buffer;
+	}
+
+	static void FreeBuffer(void* buffer, std::size_t size)
+	{
+		::munmap(buffer, size);
+	}
+
+	static std::size_t PageSize()
+	{
+		return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	}
+
+	// The pages stay in the page cache, they just stop counting towards this process
+	static void ReleaseInput(const std::uint8_t* data, std::size_t size)
+	{
+		::madvise(const_cast<std::uint8_t*>(data), size, MADV_DONTNEED);
+	}
+	#endif
+
+	// Converts one window at a time into a reused buffer and drops the mapped input pages behind it, so neither grows with the file
+	template <EEncoding From, EEncoding To>
+	static EError ConvertMapped(const std::uint8_t* data, std::size_t size, EImpl impl, FileHandle file)
+	{
+		using C1 = Details::CharTypeT<To>;
+		using C2 = Details::CharTypeT<From>;
+
+		// A file cut off in the middle of a unit is not text of From at all
+		if (size % sizeof(C2) != 0)
+			return EError::FileError;
+
+		std::size_t bufferSize = Details::MaxOutputSize<From, To>(c_FileWindowSize) + sizeof(OutputBlock);
+		void*       buffer     = AllocateBuffer(bufferSize);
+		if (!buffer)
+			return EError::OutOfMemory;
+
+		const C2*   input       = reinterpret_cast<const C2*>(data);
+		std::size_t units       = size / sizeof(C2);
+		std::size_t windowUnits = c_FileWindowSize / sizeof(C2);
+		std::size_t pageSize    = PageSize();
+		std::size_t released    = 0;
+		std::size_t offset      = 0;
+		EError      error       = EError::Success;
+		while (offset < units)
+		{
+			std::size_t   end    = units - offset > windowUnits ? Details::SequenceStart(input, offset + windowUnits) : units;
+			ConvertResult result = ConvertInto<C1, C2>(std::span<const C2>(input + offset, end - offset), std::span<C1>(static_cast<C1*>(buffer), bufferSize / sizeof(C1)), impl);
+			if (result.Error != EError::Success)
+			{
+				error = result.Error;
+				break;
+			}
+			if (!WriteAll(file, static_cast<const std::uint8_t*>(buffer), result.Written * sizeof(C1)))
+			{
+				error = EError::FileError;
+				break;
+			}
+			offset = end;
+
+			std::size_t done = Memory::AlignFloor(offset * sizeof(C2), pageSize);
+			if (done > released)
+			{
+				ReleaseInput(data + released, done - released);
+				released = done;
+			}
+		}
+		FreeBuffer(buffer, bufferSize);
+		return error;
+	}
+
+	static EError CopyMapped(const std::uint8_t* data, std::size_t size, [[maybe_unused]] EImpl impl, FileHandle file)
+	{
+		return WriteAll(file, data, size) ? EError::Success : EError::FileError;
+	}
+
+	using ConvertMappedF = EError (*)(const std::uint8_t* data, std::size_t size, EImpl impl, FileHandle file);
+
+	static constexpr ConvertMappedF s_ConvertMappedImpls[c_EncodingCount][c_EncodingCount] {
+		{&CopyMapped, &ConvertMapped<EEncoding::UTF8, EEncoding::UTF16>, &ConvertMapped<EEncoding::UTF8, EEncoding::UTF32>, &ConvertMapped<EEncoding::UTF8, EEncoding::Latin1>, &ConvertMapped<EEncoding::UTF8, EEncoding::ASCII>},
+		{&ConvertMapped<EEncoding::UTF16, EEncoding::UTF8>, &CopyMapped, &ConvertMapped<EEncoding::UTF16, EEncoding::UTF32>, &ConvertMapped<EEncoding::UTF16, EEncoding::Latin1>, &ConvertMapped<EEncoding::UTF16, EEncoding::ASCII>},
+		{&ConvertMapped<EEncoding::UTF32, EEncoding::UTF8>, &ConvertMapped<EEncoding::UTF32, EEncoding::UTF16>, &CopyMapped, &ConvertMapped<EEncoding::UTF32, EEncoding::Latin1>, &ConvertMapped<EEncoding::UTF32, EEncoding::ASCII>},
+		{&ConvertMapped<EEncoding::Latin1, EEncoding::UTF8>, &ConvertMapped<EEncoding::Latin1, EEncoding::UTF16>, &ConvertMapped<EEncoding::Latin1, EEncoding::UTF32>, &CopyMapped, &ConvertMapped<EEncoding::Latin1, EEncoding::ASCII>},
+		{&ConvertMapped<EEncoding::ASCII, EEncoding::UTF8>, &ConvertMapped<EEncoding::ASCII, EEncoding::UTF16>, &ConvertMapped<EEncoding::ASCII, EEncoding::UTF32>, &ConvertMapped<EEncoding::ASCII, EEncoding::Latin1>, &CopyMapped}
+	};
+
+	#if BUILD_IS_SYSTEM_WINDOWS
+	static EError ConvertFile(ConvertMappedF convert, const std::string& inName, const std::string& outName, EImpl impl)
+	{
+		// Without FILE_SHARE_WRITE opening the input again as the output fails, instead of truncating it under the mapping
+		HANDLE inFile = CreateFileA(inName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (inFile == INVALID_HANDLE_VALUE)
+			return EError::FileError;
+		LARGE_INTEGER inSize {};
+		if (GetFileType(inFile) != FILE_TYPE_DISK || !GetFileSizeEx(inFile, &inSize) || static_cast<std::uint64_t>(inSize.QuadPart) > static_cast<std::size_t>(-1))
+		{
+			CloseHandle(inFile);
+			return EError::FileError;
+		}
+
+		// Empty files can't be mapped, they convert to an empty file without it
+		std::size_t size = static_cast<std::size_t>(inSize.QuadPart);
+		void*       data = nullptr;
+		if (size > 0)
+		{
+			HANDLE mapping = CreateFileMappingA(inFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping)
+			{
+				data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping);
+			}
+			if (!data)
+			{
+				CloseHandle(inFile);
+				return EError::FileError;
+			}
+		}
+
+		EError error   = EError::FileError;
+		HANDLE outFile = CreateFileA(outName.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (outFile != INVALID_HANDLE_VALUE)
+		{
+			error = convert(static_cast<const std::uint8_t*>(data), size, impl, outFile);
+			if (!CloseHandle(outFile) && error == EError::Success)
+				error = EError::FileError;
+			if (error != EError::Success)
+				DeleteFileA(outName.c_str());
+		}
+		if (data)
+			UnmapViewOfFile(data);
+		CloseHandle(inFile);
+		return error;
+	}
+	#else
+	static EError ConvertFile(ConvertMappedF convert, const std::string& inName, const std::string& outName, EImpl impl)
+	{
+		int inFd = ::open(inName.c_str(), O_RDONLY | O_CLOEXEC);
+		if (inFd < 0)
+			return EError::FileError;
+		struct stat inStat, outStat;
+		if (::fstat(inFd, &inStat) != 0 || !S_ISREG(inStat.st_mode))
+		{
+			::close(inFd);
+			return EError::FileError;
+		}
+		// Truncating the output would pull the mapped input out from under the conversion
+		if (::stat(outName.c_str(), &outStat) == 0 && outStat.st_dev == inStat.st_dev && outStat.st_ino == inStat.st_ino)
+		{
+			::close(inFd);
+			return EError::FileError;
+		}
+
+		std::size_t size = static_cast<std::size_t>(inStat.st_size);
+		void*       data = nullptr;
+		if (size > 0)
+		{
+			data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, inFd, 0);
+			if (data == MAP_FAILED)
+			{
+				::close(inFd);
+				return EError::FileError;
+			}
+			::madvise(data, size, MADV_SEQUENTIAL);
+			AdviseHugePages(data, size);
+		}
+		::close(inFd);
+
+		EError error = EError::FileError;
+		int    outFd = ::open(outName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+		if (outFd >= 0)
+		{
+			error = convert(static_cast<const std::uint8_t*>(data), size, impl, outFd);
+			if (::close(outFd) != 0 && error == EError::Success)
+				error = EError::FileError;
+			if (error != EError::Success)
+				::unlink(outName.c_str());
+		}
+		if (data)
+			::munmap(data, size);
+		return error;
+	}
+	#endif
+
+	EError ConvertFile(std::string_view inPath, std::string_view outPath, EEncoding from, EEncoding to, EImpl impl)
+	{
+		if (static_cast<std::uint8_t>(from) >= c_EncodingCount || static_cast<std::uint8_t>(to) >= c_EncodingCount)
+			return EError::MissingImpl;
+		return ConvertFile(s_ConvertMappedImpls[static_cast<std::uint8_t>(from)][static_cast<std::uint8_t>(to)], std::string(inPath), std::string(outPath), impl);
+	}
+#else
+	EError ConvertFile([[maybe_unused]] std::string_view inPath, [[maybe_unused]] std::string_view outPath, [[maybe_unused]] EEncoding from, [[maybe_unused]] EEncoding to, [[maybe_unused]] EImpl impl)
+	{
+		return EError::MissingImpl;
+	}
+#endif
+} // namespace UTF
\ No newline at end of file
@@ -1,9 +1,39 @@
 #include "UTF/Generic.h"
+#include "Ascii.h"
+#include "ConvBuffer.h"
 #include "LUTs.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace UTF::Generic
 {
-	// TODO(MarcasRealAccount): Replace hard errors with encoding U+FFFD replacement character
+	// Reads the four bytes at input as one word, bytes past available read as zero and fail every continuation check
+	static char32_t LoadWord(const void* input, std::size_t available)
+	{
+		char32_t word = 0;
+		std::memcpy(&word, input, std::min<std::size_t>(available, sizeof(word)));
+		return word;
+	}
+
+	// Sequences have to take the fewest bytes their codepoint fits in and must not encode a surrogate or go past U+10FFFF, which is what
+	// DFA and Validate accept. C0 and C1 only start overlong sequences. The rest follows from the leading byte and the byte after it:
+	// three byte sequences below E0 A0 are overlong and ED A0 to ED BF are surrogates, four byte sequences only encode the planes 1 to 16.
+	// Leading bytes from F5 on can't start a valid sequence at all, otherwise it is the continuation byte that is out of range.
+	static EError CheckRange(char32_t word, std::uint8_t size)
+	{
+		if (size == 2)
+			return (word & 0x1E) ? EError::Success : EError::InvalidLeading;
+		if (size == 3)
+		{
+			char32_t top = (word & 0x0F) << 1 | (word >> 13 & 0x01);
+			return top != 0x00 && top != 0x1B ? EError::Success : EError::InvalidContinuation;
+		}
+		char32_t plane = (word & 0x07) << 2 | (word >> 12 & 0x03);
+		if (plane - 1 < 0x10)
+			return EError::Success;
+		return (word & 0xFF) > 0xF4 ? EError::InvalidLeading : EError::InvalidContinuation;
+	}
 
 	EError CalcReqSize8To16(const void* input, std::size_t inputSize, std::size_t& requiredSize)
 	{
@@ -11,7 +41,16 @@ namespace UTF::Generic
 		const char8_t* inputBuf = reinterpret_cast<const char8_t*>(input);
 		for (std::size_t i = 0; i < inputSize;)
 		{
-			char32_t     word = *reinterpret_cast<const char32_t*>(inputBuf);
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf, ascii))
+			{
+				requiredSize += 16;
+				inputBuf     += 8;
+				i            += 8;
+				continue;
+			}
+
+			char32_t     word = LoadWord(inputBuf, inputSize - i);
 			std::uint8_t size = LUTs::UTF8_6BitClass[(word >> 3) & 0x3F];
 			switch (size)
 			{
@@ -21,21 +60,27 @@ namespace UTF::Generic
 				++i;
 				break;
 			case 2:
-				if ((word & 0x80C0) != 0x80C0)
+				if (EError error = CheckRange(word, 2); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0) != 0x80C0)
 					return EError::InvalidContinuation;
 				requiredSize += 2;
 				inputBuf     += 2;
 				i            += 2;
 				break;
 			case 3:
-				if ((word & 0x8080C0) != 0x8080C0)
+				if (EError error = CheckRange(word, 3); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0C0) != 0x8080C0)
 					return EError::InvalidContinuation;
 				requiredSize += 2;
 				inputBuf     += 3;
 				i            += 3;
 				break;
 			case 4:
-				if ((word & 0x808080C0) != 0x808080C0)
+				if (EError error = CheckRange(word, 4); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0C0C0) != 0x808080C0)
 					return EError::InvalidContinuation;
 				requiredSize += 4;
 				inputBuf     += 4;
@@ -54,7 +99,16 @@ namespace UTF::Generic
 		const char8_t* inputBuf = reinterpret_cast<const char8_t*>(input);
 		for (std::size_t i = 0; i < inputSize;)
 		{
-			char32_t     word = *reinterpret_cast<const char32_t*>(inputBuf);
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf, ascii))
+			{
+				requiredSize += 32;
+				inputBuf     += 8;
+				i            += 8;
+				continue;
+			}
+
+			char32_t     word = LoadWord(inputBuf, inputSize - i);
 			std::uint8_t size = LUTs::UTF8_6BitClass[(word >> 3) & 0x3F];
 			switch (size)
 			{
@@ -64,21 +118,27 @@ namespace UTF::Generic
 				++i;
 				break;
 			case 2:
-				if ((word & 0x80C0) != 0x80C0)
+				if (EError error = CheckRange(word, 2); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0) != 0x80C0)
 					return EError::InvalidContinuation;
 				requiredSize += 4;
 				inputBuf     += 2;
 				i            += 2;
 				break;
 			case 3:
-				if ((word & 0x8080C0) != 0x8080C0)
+				if (EError error = CheckRange(word, 3); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0C0) != 0x8080C0)
 					return EError::InvalidContinuation;
 				requiredSize += 4;
 				inputBuf     += 3;
 				i            += 3;
 				break;
 			case 4:
-				if ((word & 0x808080C0) != 0x808080C0)
+				if (EError error = CheckRange(word, 4); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0C0C0) != 0x808080C0)
 					return EError::InvalidContinuation;
 				requiredSize += 4;
 				inputBuf     += 4;
@@ -97,7 +157,16 @@ namespace UTF::Generic
 		const char16_t* inputBuf = reinterpret_cast<const char16_t*>(input);
 		for (std::size_t i = 0; i < inputSize;)
 		{
-			char32_t     word = *reinterpret_cast<const char32_t*>(inputBuf);
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<2>(inputBuf, ascii))
+			{
+				requiredSize += 4;
+				inputBuf     += 4;
+				i            += 8;
+				continue;
+			}
+
+			char32_t     word = LoadWord(inputBuf, inputSize - i);
 			std::uint8_t size = LUTs::UTF16_6BitClass[(word >> 10) & 0x3F];
 			switch (size)
 			{
@@ -115,7 +184,7 @@ namespace UTF::Generic
 				break;
 			}
 			case 2:
-				if ((word & 0xDC00'D800) != 0xDC00'D800)
+				if ((word & 0xFC00'FC00) != 0xDC00'D800)
 					return EError::InvalidContinuation;
 				requiredSize += 4;
 				inputBuf     += 2;
@@ -134,7 +203,16 @@ namespace UTF::Generic
 		const char16_t* inputBuf = reinterpret_cast<const char16_t*>(input);
 		for (std::size_t i = 0; i < inputSize;)
 		{
-			char32_t     word = *reinterpret_cast<const char32_t*>(inputBuf);
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<2>(inputBuf, ascii))
+			{
+				requiredSize += 16;
+				inputBuf     += 4;
+				i            += 8;
+				continue;
+			}
+
+			char32_t     word = LoadWord(inputBuf, inputSize - i);
 			std::uint8_t size = LUTs::UTF16_6BitClass[(word >> 10) & 0x3F];
 			switch (size)
 			{
@@ -146,7 +224,7 @@ namespace UTF::Generic
 				break;
 			}
 			case 2:
-				if ((word & 0xDC00'D800) != 0xDC00'D800)
+				if ((word & 0xFC00'FC00) != 0xDC00'D800)
 					return EError::InvalidContinuation;
 				requiredSize += 4;
 				inputBuf     += 2;
@@ -165,7 +243,19 @@ namespace UTF::Generic
 		const char32_t* inputBuf = reinterpret_cast<const char32_t*>(input);
 		for (std::size_t i = 0; i < inputSize;)
 		{
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<4>(inputBuf, ascii))
+			{
+				requiredSize += 2;
+				inputBuf     += 2;
+				i            += 8;
+				continue;
+			}
+
 			char32_t codepoint = *inputBuf;
+			// Surrogates are no codepoints of their own, like units past U+10FFFF they have no encoding
+			if ((codepoint & 0xFFFF'F800) == 0xD800)
+				return EError::OOB;
 			if (codepoint < 0x80)
 				++requiredSize;
 			else if (codepoint < 0x800)
@@ -188,7 +278,18 @@ namespace UTF::Generic
 		const char32_t* inputBuf = reinterpret_cast<const char32_t*>(input);
 		for (std::size_t i = 0; i < inputSize;)
 		{
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<4>(inputBuf, ascii))
+			{
+				requiredSize += 4;
+				inputBuf     += 2;
+				i            += 8;
+				continue;
+			}
+
 			char32_t codepoint = *inputBuf;
+			if ((codepoint & 0xFFFF'F800) == 0xD800)
+				return EError::OOB;
 			if (codepoint < 0x1'0000)
 				requiredSize += 2;
 			else if (codepoint < 0x11'0000)
@@ -201,17 +302,288 @@ namespace UTF::Generic
 		return EError::Success;
 	}
 
+	// Bytes from 0x80 on, the Latin-1 units that take two bytes in UTF-8
+	static std::size_t CountHighBytes(const std::uint8_t* inputBuf, std::size_t inputSize)
+	{
+		std::size_t count = 0;
+		std::size_t i     = 0;
+		for (; i + 8 <= inputSize; i += 8)
+		{
+			std::uint64_t bytes;
+			std::memcpy(&bytes, inputBuf + i, sizeof(bytes));
+			count += static_cast<std::size_t>(((bytes & 0x8080'8080'8080'8080) >> 7) * 0x0101'0101'0101'0101 >> 56);
+		}
+		for (; i < inputSize; ++i)
+			count += inputBuf[i] >= 0x80;
+		return count;
+	}
+
+	EError CalcReqSizeLatin1To8(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize = inputSize + CountHighBytes(static_cast<const std::uint8_t*>(input), inputSize);
+		return EError::Success;
+	}
+
+	// Only C2 and C3 lead the sequences of Latin-1 past ASCII, every other leading byte is either invalid or past U+00FF.
+	// That rejects overlong encodings like DFA does.
+	EError CalcReqSize8ToLatin1(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize                 = 0;
+		const std::uint8_t* inputBuf = static_cast<const std::uint8_t*>(input);
+		for (std::size_t i = 0; i < inputSize;)
+		{
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf + i, ascii))
+			{
+				requiredSize += 8;
+				i            += 8;
+				continue;
+			}
+
+			std::uint8_t lead = inputBuf[i];
+			if (lead < 0x80)
+			{
+				++requiredSize;
+				++i;
+				continue;
+			}
+			if ((lead & 0xFE) != 0xC2)
+				return lead >= 0xC4 && lead < 0xF5 ? EError::OOB : EError::InvalidLeading;
+			if (i + 1 >= inputSize || (inputBuf[i + 1] & 0xC0) != 0x80)
+				return EError::InvalidContinuation;
+			++requiredSize;
+			i += 2;
+		}
+		return EError::Success;
+	}
+
+	// Converts units of In to the Out units of the same value, which is every conversion between Latin-1 or ASCII and UTF-16 or UTF-32
+	// and ASCII between Latin-1 and UTF-8. Units from Limit on are Error, there is nothing to check when In has none.
+	template <class In, class Out, char32_t Limit, EError Error>
+	static EError CalcReqSizeUnits(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		constexpr std::uint64_t c_Over = Details::c_LimitBits<sizeof(In), Limit>;
+
+		const In*   inputBuf = static_cast<const In*>(input);
+		std::size_t units    = inputSize / sizeof(In);
+		requiredSize         = 0;
+		if constexpr (c_Over != 0)
+		{
+			std::size_t i = 0;
+			for (; i + 8 / sizeof(In) <= units; i += 8 / sizeof(In))
+			{
+				std::uint64_t word;
+				std::memcpy(&word, inputBuf + i, sizeof(word));
+				if (word & c_Over)
+					return Error;
+			}
+			for (; i < units; ++i)
+			{
+				if (inputBuf[i] >= Limit)
+					return Error;
+			}
+		}
+		requiredSize = units * sizeof(Out);
+		return EError::Success;
+	}
+
+	EError CalcReqSizeAsciiTo8(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<std::uint8_t, std::uint8_t, 0x80, EError::InvalidLeading>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSizeLatin1ToAscii(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<std::uint8_t, std::uint8_t, 0x80, EError::OOB>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSizeLatin1To16(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<std::uint8_t, char16_t, 0x100, EError::Success>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSizeLatin1To32(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<std::uint8_t, char32_t, 0x100, EError::Success>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSizeAsciiTo16(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<std::uint8_t, char16_t, 0x80, EError::InvalidLeading>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSizeAsciiTo32(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<std::uint8_t, char32_t, 0x80, EError::InvalidLeading>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSize16ToLatin1(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<char16_t, std::uint8_t, 0x100, EError::OOB>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSize16ToAscii(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<char16_t, std::uint8_t, 0x80, EError::OOB>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSize32ToLatin1(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<char32_t, std::uint8_t, 0x100, EError::OOB>(input, inputSize, requiredSize);
+	}
+
+	EError CalcReqSize32ToAscii(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		return CalcReqSizeUnits<char32_t, std::uint8_t, 0x80, EError::OOB>(input, inputSize, requiredSize);
+	}
+
+	// Adds up the byte counters of a word, each of them at most 255
+	static std::size_t SumBytes(std::uint64_t counters)
+	{
+		std::uint64_t pairs = (counters & 0x00FF'00FF'00FF'00FF) + (counters >> 8 & 0x00FF'00FF'00FF'00FF);
+		return static_cast<std::size_t>(pairs * 0x0001'0001'0001'0001 >> 48);
+	}
+
+	// Counts the bytes that are not continuation bytes, those start a sequence, and the leading bytes of 4 byte sequences among them.
+	// Eight bytes are classified at a time into byte counters, which are summed before they can overflow.
+	static std::size_t CountLeaders(const std::uint8_t* inputBuf, std::size_t inputSize, std::size_t& fourBytes)
+	{
+		constexpr std::uint64_t c_HighBits = 0x8080'8080'8080'8080;
+
+		std::size_t leaders = 0;
+		std::size_t words   = inputSize / 8;
+		fourBytes           = 0;
+		for (std::size_t word = 0; word < words;)
+		{
+			std::size_t   end        = std::min<std::size_t>(words, word + 255);
+			std::uint64_t contCounts = 0;
+			std::uint64_t fourCounts = 0;
+			leaders                 += (end - word) * 8;
+			for (; word < end; ++word)
+			{
+				std::uint64_t bytes;
+				std::memcpy(&bytes, inputBuf + word * 8, sizeof(bytes));
+				// The high bit of a byte ends up set for 10xxxxxx and for 1111xxxx, bits shifted in from the byte below are masked off
+				contCounts += (bytes & ~(bytes << 1) & c_HighBits) >> 7;
+				fourCounts += (bytes & bytes << 1 & bytes << 2 & bytes << 3 & c_HighBits) >> 7;
+			}
+			leaders   -= SumBytes(contCounts);
+			fourBytes += SumBytes(fourCounts);
+		}
+		for (std::size_t i = words * 8; i < inputSize; ++i)
+		{
+			leaders   += (inputBuf[i] & 0xC0) != 0x80;
+			fourBytes += inputBuf[i] >= 0xF0;
+		}
+		return leaders;
+	}
+
+	EError Length8To16(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		std::size_t fourBytes = 0;
+		length                = CountLeaders(static_cast<const std::uint8_t*>(input), inputSize, fourBytes);
+		length               += fourBytes;
+		return EError::Success;
+	}
+
+	EError Length8To32(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		std::size_t fourBytes = 0;
+		length                = CountLeaders(static_cast<const std::uint8_t*>(input), inputSize, fourBytes);
+		return EError::Success;
+	}
+
+	EError Length16To8(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		const char16_t* inputBuf = static_cast<const char16_t*>(input);
+		std::size_t     units    = inputSize / 2;
+		length                   = 0;
+		for (std::size_t i = 0; i < units;)
+		{
+			std::uint64_t ascii;
+			if (i + 4 <= units && Details::LoadAscii<2>(inputBuf + i, ascii))
+			{
+				length += 4;
+				i      += 4;
+				continue;
+			}
+
+			// Each surrogate counts for half of the 4 bytes of a pair
+			char16_t unit = inputBuf[i];
+			if (unit < 0x80)
+				++length;
+			else if (unit < 0x800 || (unit & 0xF800) == 0xD800)
+				length += 2;
+			else
+				length += 3;
+			++i;
+		}
+		return EError::Success;
+	}
+
+	EError Length16To32(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		const char16_t* inputBuf = static_cast<const char16_t*>(input);
+		std::size_t     units    = inputSize / 2;
+		length                   = units;
+		for (std::size_t i = 0; i < units; ++i)
+			length -= (inputBuf[i] & 0xFC00) == 0xDC00;
+		return EError::Success;
+	}
+
+	EError Length32To8(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		const char32_t* inputBuf = static_cast<const char32_t*>(input);
+		std::size_t     units    = inputSize / 4;
+		length                   = units;
+		for (std::size_t i = 0; i < units; ++i)
+			length += (inputBuf[i] >= 0x80) + (inputBuf[i] >= 0x800) + (inputBuf[i] >= 0x1'0000);
+		return EError::Success;
+	}
+
+	EError Length32To16(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		const char32_t* inputBuf = static_cast<const char32_t*>(input);
+		std::size_t     units    = inputSize / 4;
+		length                   = units;
+		for (std::size_t i = 0; i < units; ++i)
+			length += inputBuf[i] >= 0x1'0000;
+		return EError::Success;
+	}
+
+	EError LengthLatin1To8(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		length = inputSize + CountHighBytes(static_cast<const std::uint8_t*>(input), inputSize);
+		return EError::Success;
+	}
+
 	EError ConvBlock8To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
 	{
 		outputSize               = 0;
 		const char8_t* inputBuf  = reinterpret_cast<const char8_t*>(&input);
 		char16_t*      outputBuf = reinterpret_cast<char16_t*>(&output);
-		for (std::size_t i = 0; i < inputSize;)
+
+		// Up to 3 continuation bytes belong to a sequence started in the previous block
+		std::size_t i = 0;
+		while (i < 3 && i < inputSize && (inputBuf[i] & 0xC0) == 0x80)
+			++i;
+		inputBuf += i;
+		while (i < inputSize)
 		{
-			char32_t     word      = *reinterpret_cast<const char32_t*>(inputBuf);
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf, ascii))
+			{
+				Details::StoreAscii<1, 2>(ascii, outputBuf);
+				inputBuf   += 8;
+				i          += 8;
+				outputBuf  += 8;
+				outputSize += 16;
+				continue;
+			}
+
+			char32_t     word      = LoadWord(inputBuf, sizeof(InputBlock) - i);
 			std::uint8_t size      = LUTs::UTF8_6BitClass[(word >> 3) & 0x3F];
 			char32_t     codepoint = 0;
-			bool         errored   = false;
 			switch (size)
 			{
 			case 1:
@@ -220,12 +592,20 @@ namespace UTF::Generic
 				++i;
 				break;
 			case 2:
+				if (EError error = CheckRange(word, 2); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0) != 0x80C0)
+					return EError::InvalidContinuation;
 				codepoint = (word & 0x1F) << 6 |
 							((word >> 8) & 0x3F);
 				inputBuf += 2;
 				i        += 2;
 				break;
 			case 3:
+				if (EError error = CheckRange(word, 3); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0C0) != 0x8080C0)
+					return EError::InvalidContinuation;
 				codepoint = (word & 0x0F) << 12 |
 							((word >> 8) & 0x3F) << 6 |
 							((word >> 16) & 0x3F);
@@ -233,6 +613,10 @@ namespace UTF::Generic
 				i        += 3;
 				break;
 			case 4:
+				if (EError error = CheckRange(word, 4); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0C0C0) != 0x808080C0)
+					return EError::InvalidContinuation;
 				codepoint = (word & 0x07) << 18 |
 							((word >> 8) & 0x3F) << 12 |
 							((word >> 16) & 0x3F) << 6 |
@@ -241,15 +625,8 @@ namespace UTF::Generic
 				i        += 4;
 				break;
 			default:
-				if (i >= 3)
-					return EError::InvalidLeading;
-				++inputBuf;
-				++i;
-				errored = true;
-				break;
+				return EError::InvalidLeading;
 			}
-			if (errored)
-				continue;
 			if (codepoint > 0xFFFF)
 			{
 				codepoint    = codepoint - 0x1'0000;
@@ -265,6 +642,10 @@ namespace UTF::Generic
 				++outputBuf;
 			}
 		}
+
+		// The next block skips the continuation bytes at its start, any past the last sequence here are stray
+		if (inputSize && i < sizeof(InputBlock) && (*inputBuf & 0xC0) == 0x80)
+			return EError::InvalidLeading;
 		return EError::Success;
 	}
 
@@ -273,9 +654,26 @@ namespace UTF::Generic
 		outputSize               = 0;
 		const char8_t* inputBuf  = reinterpret_cast<const char8_t*>(&input);
 		char32_t*      outputBuf = reinterpret_cast<char32_t*>(&output);
-		for (std::size_t i = 0; i < inputSize;)
+
+		// Up to 3 continuation bytes belong to a sequence started in the previous block
+		std::size_t i = 0;
+		while (i < 3 && i < inputSize && (inputBuf[i] & 0xC0) == 0x80)
+			++i;
+		inputBuf += i;
+		while (i < inputSize)
 		{
-			char32_t     word = *reinterpret_cast<const char32_t*>(inputBuf);
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf, ascii))
+			{
+				Details::StoreAscii<1, 4>(ascii, outputBuf);
+				inputBuf   += 8;
+				i          += 8;
+				outputBuf  += 8;
+				outputSize += 32;
+				continue;
+			}
+
+			char32_t     word = LoadWord(inputBuf, sizeof(InputBlock) - i);
 			std::uint8_t size = LUTs::UTF8_6BitClass[(word >> 3) & 0x3F];
 			switch (size)
 			{
@@ -285,12 +683,20 @@ namespace UTF::Generic
 				++i;
 				break;
 			case 2:
+				if (EError error = CheckRange(word, 2); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0) != 0x80C0)
+					return EError::InvalidContinuation;
 				*outputBuf = (word & 0x1F) << 6 |
 							 ((word >> 8) & 0x3F);
 				inputBuf += 2;
 				i        += 2;
 				break;
 			case 3:
+				if (EError error = CheckRange(word, 3); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0C0) != 0x8080C0)
+					return EError::InvalidContinuation;
 				*outputBuf = (word & 0x0F) << 12 |
 							 ((word >> 8) & 0x3F) << 6 |
 							 ((word >> 16) & 0x3F);
@@ -298,6 +704,10 @@ namespace UTF::Generic
 				i        += 3;
 				break;
 			case 4:
+				if (EError error = CheckRange(word, 4); error != EError::Success)
+					return error;
+				if ((word & 0xC0C0C0C0) != 0x808080C0)
+					return EError::InvalidContinuation;
 				*outputBuf = (word & 0x07) << 18 |
 							 ((word >> 8) & 0x3F) << 12 |
 							 ((word >> 16) & 0x3F) << 6 |
@@ -306,15 +716,15 @@ namespace UTF::Generic
 				i        += 4;
 				break;
 			default:
-				if (i >= 3)
-					return EError::InvalidLeading;
-				++inputBuf;
-				++i;
-				continue;
+				return EError::InvalidLeading;
 			}
 			outputSize += 4;
 			++outputBuf;
 		}
+
+		// The next block skips the continuation bytes at its start, any past the last sequence here are stray
+		if (inputSize && i < sizeof(InputBlock) && (*inputBuf & 0xC0) == 0x80)
+			return EError::InvalidLeading;
 		return EError::Success;
 	}
 
@@ -325,7 +735,18 @@ namespace UTF::Generic
 		char8_t*        outputBuf = reinterpret_cast<char8_t*>(&output);
 		for (std::size_t i = 0; i < inputSize;)
 		{
-			char32_t     word      = *reinterpret_cast<const char32_t*>(inputBuf);
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<2>(inputBuf, ascii))
+			{
+				Details::StoreAscii<2, 1>(ascii, outputBuf);
+				inputBuf   += 4;
+				i          += 8;
+				outputBuf  += 4;
+				outputSize += 4;
+				continue;
+			}
+
+			char32_t     word      = LoadWord(inputBuf, sizeof(InputBlock) - i);
 			std::uint8_t size      = LUTs::UTF16_6BitClass[(word >> 10) & 0x3F];
 			char32_t     codepoint = 0;
 			switch (size)
@@ -357,6 +778,8 @@ namespace UTF::Generic
 				i += 2;
 				break;
 			case 2:
+				if ((word & 0xFC00'FC00) != 0xDC00'D800)
+					return EError::InvalidContinuation;
 				codepoint    = ((word & 0x3FF) << 10 | ((word >> 16) & 0x3FF)) + 0x1'0000;
 				outputBuf[0] = 0xF0 | static_cast<char8_t>((codepoint >> 18) & 0x07);
 				outputBuf[1] = 0x80 | static_cast<char8_t>((codepoint >> 12) & 0x3F);
@@ -370,10 +793,14 @@ namespace UTF::Generic
 			default:
 				if (i >= 2)
 					return EError::InvalidLeading;
-				++i;
+				i += 2;
 				++inputBuf;
 			}
 		}
+
+		// Same for a low surrogate at the start of the next block
+		if (inputSize && (*inputBuf & 0xFC00) == 0xDC00)
+			return EError::InvalidLeading;
 		return EError::Success;
 	}
 
@@ -384,7 +811,18 @@ namespace UTF::Generic
 		char32_t*       outputBuf = reinterpret_cast<char32_t*>(&output);
 		for (std::size_t i = 0; i < inputSize;)
 		{
-			char32_t     word = *reinterpret_cast<const char32_t*>(inputBuf);
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<2>(inputBuf, ascii))
+			{
+				Details::StoreAscii<2, 4>(ascii, outputBuf);
+				inputBuf   += 4;
+				i          += 8;
+				outputBuf  += 4;
+				outputSize += 16;
+				continue;
+			}
+
+			char32_t     word = LoadWord(inputBuf, sizeof(InputBlock) - i);
 			std::uint8_t size = LUTs::UTF16_6BitClass[(word >> 10) & 0x3F];
 			switch (size)
 			{
@@ -396,6 +834,8 @@ namespace UTF::Generic
 				i += 2;
 				break;
 			case 2:
+				if ((word & 0xFC00'FC00) != 0xDC00'D800)
+					return EError::InvalidContinuation;
 				*outputBuf = ((word & 0x3FF) << 10 | ((word >> 16) & 0x3FF)) + 0x1'0000;
 				++outputBuf;
 				outputSize += 4;
@@ -405,10 +845,14 @@ namespace UTF::Generic
 			default:
 				if (i >= 2)
 					return EError::InvalidLeading;
-				++i;
+				i += 2;
 				++inputBuf;
 			}
 		}
+
+		// Same for a low surrogate at the start of the next block
+		if (inputSize && (*inputBuf & 0xFC00) == 0xDC00)
+			return EError::InvalidLeading;
 		return EError::Success;
 	}
 
@@ -419,7 +863,20 @@ namespace UTF::Generic
 		char8_t*        outputBuf = reinterpret_cast<char8_t*>(&output);
 		for (std::size_t i = 0; i < inputSize;)
 		{
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<4>(inputBuf, ascii))
+			{
+				Details::StoreAscii<4, 1>(ascii, outputBuf);
+				inputBuf   += 2;
+				i          += 8;
+				outputBuf  += 2;
+				outputSize += 2;
+				continue;
+			}
+
 			char32_t codepoint = *inputBuf;
+			if ((codepoint & 0xFFFF'F800) == 0xD800)
+				return EError::OOB;
 			if (codepoint < 0x80)
 			{
 				*outputBuf = static_cast<char8_t>(codepoint & 0x7F);
@@ -467,7 +924,20 @@ namespace UTF::Generic
 		char16_t*       outputBuf = reinterpret_cast<char16_t*>(&output);
 		for (std::size_t i = 0; i < inputSize;)
 		{
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<4>(inputBuf, ascii))
+			{
+				Details::StoreAscii<4, 2>(ascii, outputBuf);
+				inputBuf   += 2;
+				i          += 8;
+				outputBuf  += 2;
+				outputSize += 4;
+				continue;
+			}
+
 			char32_t codepoint = *inputBuf;
+			if ((codepoint & 0xFFFF'F800) == 0xD800)
+				return EError::OOB;
 			if (codepoint < 0x1'0000)
 			{
 				*outputBuf = static_cast<char16_t>(codepoint & 0xFFFF);
@@ -491,4 +961,463 @@ namespace UTF::Generic
 		}
 		return EError::Success;
 	}
+
+	EError ConvBlockLatin1To8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize                    = 0;
+		const std::uint8_t* inputBuf  = reinterpret_cast<const std::uint8_t*>(&input);
+		char8_t*            outputBuf = reinterpret_cast<char8_t*>(&output);
+		for (std::size_t i = 0; i < inputSize;)
+		{
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf + i, ascii))
+			{
+				std::memcpy(outputBuf, &ascii, sizeof(ascii));
+				i          += 8;
+				outputBuf  += 8;
+				outputSize += 8;
+				continue;
+			}
+
+			std::uint8_t unit = inputBuf[i];
+			if (unit < 0x80)
+			{
+				*outputBuf = unit;
+				++outputBuf;
+				++outputSize;
+			}
+			else
+			{
+				outputBuf[0] = 0xC0 | static_cast<char8_t>(unit >> 6);
+				outputBuf[1] = 0x80 | static_cast<char8_t>(unit & 0x3F);
+				outputBuf   += 2;
+				outputSize  += 2;
+			}
+			++i;
+		}
+		return EError::Success;
+	}
+
+	EError ConvBlock8ToLatin1(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize                    = 0;
+		const std::uint8_t* inputBuf  = reinterpret_cast<const std::uint8_t*>(&input);
+		std::uint8_t*       outputBuf = reinterpret_cast<std::uint8_t*>(&output);
+
+		// Up to 3 continuation bytes belong to a sequence started in the previous block
+		std::size_t i = 0;
+		while (i < 3 && i < inputSize && (inputBuf[i] & 0xC0) == 0x80)
+			++i;
+		while (i < inputSize)
+		{
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf + i, ascii))
+			{
+				std::memcpy(outputBuf, &ascii, sizeof(ascii));
+				i          += 8;
+				outputBuf  += 8;
+				outputSize += 8;
+				continue;
+			}
+
+			std::uint8_t lead = inputBuf[i];
+			if (lead < 0x80)
+			{
+				*outputBuf = lead;
+				++outputBuf;
+				++outputSize;
+				++i;
+				continue;
+			}
+			// Same leading bytes as CalcReqSize8ToLatin1, the continuation byte may be past the block
+			if ((lead & 0xFE) != 0xC2)
+				return lead >= 0xC4 && lead < 0xF5 ? EError::OOB : EError::InvalidLeading;
+			if ((inputBuf[i + 1] & 0xC0) != 0x80)
+				return EError::InvalidContinuation;
+			*outputBuf = static_cast<std::uint8_t>((lead & 0x03) << 6 | (inputBuf[i + 1] & 0x3F));
+			++outputBuf;
+			++outputSize;
+			i += 2;
+		}
+
+		// The next block skips the continuation bytes at its start, any past the last sequence here are stray
+		if (inputSize && i < sizeof(InputBlock) && (inputBuf[i] & 0xC0) == 0x80)
+			return EError::InvalidLeading;
+		return EError::Success;
+	}
+
+	// Same conversions as CalcReqSizeUnits, a word of input at a time while none of its units is past Limit
+	template <class In, class Out, char32_t Limit, EError Error>
+	static EError ConvBlockUnits(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		constexpr std::uint64_t c_Over = Details::c_LimitBits<sizeof(In), Limit>;
+		constexpr std::size_t   c_Step = 8 / sizeof(In);
+
+		const In*   inputBuf  = reinterpret_cast<const In*>(&input);
+		Out*        outputBuf = reinterpret_cast<Out*>(&output);
+		std::size_t units     = (inputSize + sizeof(In) - 1) / sizeof(In);
+		for (std::size_t i = 0; i < units;)
+		{
+			std::uint64_t word;
+			if (i + c_Step <= units)
+			{
+				std::memcpy(&word, inputBuf + i, sizeof(word));
+				if ((word & c_Over) == 0)
+				{
+					if constexpr (sizeof(In) == sizeof(Out))
+						std::memcpy(outputBuf + i, &word, sizeof(word));
+					else
+						Details::StoreAscii<sizeof(In), sizeof(Out)>(word, outputBuf + i);
+					i += c_Step;
+					continue;
+				}
+			}
+
+			if constexpr (c_Over != 0)
+			{
+				if (inputBuf[i] >= Limit)
+					return Error;
+			}
+			outputBuf[i] = static_cast<Out>(inputBuf[i]);
+			++i;
+		}
+
+		// As UTF-8 to ASCII the next block skips the continuation bytes at its start, a byte past ASCII after the block fails either way
+		if constexpr (sizeof(In) == 1 && Limit == 0x80)
+		{
+			if (inputSize && inputBuf[inputSize] >= 0x80)
+				return Error;
+		}
+		// As UTF-16 the next block skips a low surrogate at its start, which is past Latin-1 either way
+		if constexpr (sizeof(In) == 2)
+		{
+			if (inputSize && (inputBuf[units] & 0xFC00) == 0xDC00)
+				return Error;
+		}
+		outputSize = units * sizeof(Out);
+		return EError::Success;
+	}
+
+	EError ConvBlockAsciiTo8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<std::uint8_t, std::uint8_t, 0x80, EError::InvalidLeading>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlockLatin1ToAscii(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<std::uint8_t, std::uint8_t, 0x80, EError::OOB>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlockLatin1To16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<std::uint8_t, char16_t, 0x100, EError::Success>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlockLatin1To32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<std::uint8_t, char32_t, 0x100, EError::Success>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlockAsciiTo16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<std::uint8_t, char16_t, 0x80, EError::InvalidLeading>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlockAsciiTo32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<std::uint8_t, char32_t, 0x80, EError::InvalidLeading>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlock16ToLatin1(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<char16_t, std::uint8_t, 0x100, EError::OOB>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlock16ToAscii(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<char16_t, std::uint8_t, 0x80, EError::OOB>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlock32ToLatin1(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<char32_t, std::uint8_t, 0x100, EError::OOB>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBlock32ToAscii(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		return ConvBlockUnits<char32_t, std::uint8_t, 0x80, EError::OOB>(input, output, inputSize, outputSize);
+	}
+
+	EError ConvBuffer8To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock8To16>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer8To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock8To32>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer16To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock16To8>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer16To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock16To32>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer32To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock32To8>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer32To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock32To16>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBufferLatin1To8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockLatin1To8>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer8ToLatin1(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock8ToLatin1>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBufferAsciiTo8(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockAsciiTo8>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBufferLatin1ToAscii(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockLatin1ToAscii>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBufferLatin1To16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockLatin1To16>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBufferLatin1To32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockLatin1To32>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBufferAsciiTo16(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockAsciiTo16>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBufferAsciiTo32(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlockAsciiTo32>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer16ToLatin1(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock16ToLatin1>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer16ToAscii(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock16ToAscii>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer32ToLatin1(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock32ToLatin1>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+
+	EError ConvBuffer32ToAscii(const void* input, std::size_t inputSize, std::size_t readableSize, void* output, std::size_t& consumed, std::size_t& outputSize)
+	{
+		return Details::ConvBuffer<&ConvBlock32ToAscii>(input, inputSize, readableSize, output, consumed, outputSize);
+	}
+	EError Validate8(const void* input, std::size_t inputSize, std::size_t& errorOffset)
+	{
+		const std::uint8_t* inputBuf = static_cast<const std::uint8_t*>(input);
+		for (std::size_t i = 0; i < inputSize;)
+		{
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf + i, ascii))
+			{
+				i += 8;
+				continue;
+			}
+
+			std::uint8_t lead = inputBuf[i];
+			if (lead < 0x80)
+			{
+				++i;
+				continue;
+			}
+
+			// The range of the second byte depends on the leading byte, it is what rules out overlong encodings, surrogates and codepoints past U+10FFFF
+			errorOffset        = i;
+			std::size_t  size  = 0;
+			std::uint8_t lower = 0x80;
+			std::uint8_t upper = 0xBF;
+			if (lead < 0xC2)
+				return EError::InvalidLeading;
+			else if (lead < 0xE0)
+				size = 2;
+			else if (lead < 0xF0)
+			{
+				size  = 3;
+				lower = lead == 0xE0 ? 0xA0 : 0x80;
+				upper = lead == 0xED ? 0x9F : 0xBF;
+			}
+			else if (lead < 0xF5)
+			{
+				size  = 4;
+				lower = lead == 0xF0 ? 0x90 : 0x80;
+				upper = lead == 0xF4 ? 0x8F : 0xBF;
+			}
+			else
+				return EError::InvalidLeading;
+
+			if (i + 1 >= inputSize || inputBuf[i + 1] < lower || inputBuf[i + 1] > upper)
+				return EError::InvalidContinuation;
+			for (std::size_t j = 2; j < size; ++j)
+			{
+				if (i + j >= inputSize || (inputBuf[i + j] & 0xC0) != 0x80)
+					return EError::InvalidContinuation;
+			}
+			i += size;
+		}
+		errorOffset = inputSize;
+		return EError::Success;
+	}
+
+	EError Validate16(const void* input, std::size_t inputSize, std::size_t& errorOffset)
+	{
+		const char16_t* inputBuf = static_cast<const char16_t*>(input);
+		std::size_t     units    = inputSize / sizeof(char16_t);
+		for (std::size_t i = 0; i < units; ++i)
+		{
+			char16_t unit = inputBuf[i];
+			if ((unit & 0xF800) != 0xD800)
+				continue;
+
+			errorOffset = i * sizeof(char16_t);
+			if (unit >= 0xDC00)
+				return EError::InvalidLeading;
+			if (i + 1 >= units || (inputBuf[i + 1] & 0xFC00) != 0xDC00)
+				return EError::InvalidContinuation;
+			++i;
+		}
+		// A trailing odd byte is half a unit
+		errorOffset = units * sizeof(char16_t);
+		return errorOffset == inputSize ? EError::Success : EError::InvalidContinuation;
+	}
+
+	EError Validate32(const void* input, std::size_t inputSize, std::size_t& errorOffset)
+	{
+		const char32_t* inputBuf = static_cast<const char32_t*>(input);
+		std::size_t     units    = inputSize / sizeof(char32_t);
+		for (std::size_t i = 0; i < units; ++i)
+		{
+			char32_t unit = inputBuf[i];
+			if (unit > 0x10'FFFF || (unit >= 0xD800 && unit < 0xE000))
+			{
+				errorOffset = i * sizeof(char32_t);
+				return EError::OOB;
+			}
+		}
+		errorOffset = units * sizeof(char32_t);
+		return errorOffset == inputSize ? EError::Success : EError::OOB;
+	}
+
+	EError ValidateLatin1([[maybe_unused]] const void* input, std::size_t inputSize, std::size_t& errorOffset)
+	{
+		errorOffset = inputSize;
+		return EError::Success;
+	}
+
+	EError ValidateAscii(const void* input, std::size_t inputSize, std::size_t& errorOffset)
+	{
+		const std::uint8_t* inputBuf = static_cast<const std::uint8_t*>(input);
+		for (std::size_t i = 0; i < inputSize;)
+		{
+			std::uint64_t ascii;
+			if (i + 8 <= inputSize && Details::LoadAscii<1>(inputBuf + i, ascii))
+			{
+				i += 8;
+				continue;
+			}
+			if (inputBuf[i] >= 0x80)
+			{
+				errorOffset = i;
+				return EError::InvalidLeading;
+			}
+			++i;
+		}
+		errorOffset = inputSize;
+		return EError::Success;
+	}
+
+	// Each lane adds the product of the halves of its keyed word and the word itself, so a product of zero loses nothing.
+	// The scramble between rounds is what makes the order of the stripes matter.
+	EError HashStripes(std::uint64_t* lanes, const char32_t* codepoints, std::size_t stripes, std::size_t& round)
+	{
+		for (std::size_t stripe = 0; stripe < stripes; ++stripe)
+		{
+			std::uint64_t words[8];
+			std::memcpy(words, codepoints + stripe * 16, sizeof(words));
+			for (std::size_t lane = 0; lane < 8; ++lane)
+			{
+				std::uint64_t keyed  = words[lane] ^ LUTs::HashKeys[round + lane];
+				lanes[lane]         += (keyed & 0xFFFF'FFFF) * (keyed >> 32) + words[lane];
+			}
+			if (++round == LUTs::HashRoundStripes)
+			{
+				for (std::size_t lane = 0; lane < 8; ++lane)
+					lanes[lane] = (lanes[lane] ^ (lanes[lane] >> 47) ^ LUTs::HashKeys[LUTs::HashRoundStripes + lane]) * LUTs::HashPrime;
+				round = 0;
+			}
+		}
+		return EError::Success;
+	}
+
+	// Compares a word of wide units at a time against the narrow units widened into the same lanes, only the rest goes a unit at a time
+	template <class N, class W>
+	static EError AsciiMatch(const void* narrow, const void* wide, std::size_t size, std::size_t& matched)
+	{
+		constexpr std::size_t c_Step = sizeof(std::uint64_t) / sizeof(W);
+
+		const N* narrowBuf = static_cast<const N*>(narrow);
+		const W* wideBuf   = static_cast<const W*>(wide);
+		for (matched = 0; matched + c_Step <= size; matched += c_Step)
+		{
+			// The widening drops the high bits of narrow units past ASCII, those are checked before it
+			std::uint64_t narrowWord = 0;
+			std::uint64_t wideWord   = 0;
+			std::memcpy(&narrowWord, narrowBuf + matched, c_Step * sizeof(N));
+			std::memcpy(&wideWord, wideBuf + matched, sizeof(wideWord));
+			if ((narrowWord & Details::c_NonAsciiBits<sizeof(N)>) || Details::ResizeAsciiLanes<sizeof(N), sizeof(W)>(narrowWord) != wideWord)
+				break;
+		}
+		while (matched < size && narrowBuf[matched] < 0x80 && narrowBuf[matched] == wideBuf[matched])
+			++matched;
+		return EError::Success;
+	}
+
+	EError AsciiMatch8To16(const void* narrow, const void* wide, std::size_t size, std::size_t& matched)
+	{
+		return AsciiMatch<char8_t, char16_t>(narrow, wide, size, matched);
+	}
+
+	EError AsciiMatch8To32(const void* narrow, const void* wide, std::size_t size, std::size_t& matched)
+	{
+		return AsciiMatch<char8_t, char32_t>(narrow, wide, size, matched);
+	}
+
+	EError AsciiMatch16To32(const void* narrow, const void* wide, std::size_t size, std::size_t& matched)
+	{
+		return AsciiMatch<char16_t, char32_t>(narrow, wide, size, matched);
+	}
 } // namespace UTF::Generic
@@ -0,0 +1,133 @@
+#include "UTF/UTF.h"
+#include "Decode.h"
+#include "LUTs.h"
+
+#include <cstring>
+#include <span>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace UTF
+{
+	// Codepoints are hashed a stripe of alignof(InputBlock) bytes at a time, each 64 bit lane takes two of them
+	static constexpr std::size_t c_StripeCodepoints = alignof(InputBlock) / sizeof(char32_t);
+	static constexpr std::size_t c_HashLanes        = c_StripeCodepoints / 2;
+	// Input is decoded this many bytes at a time into a buffer on the stack
+	static constexpr std::size_t c_HashChunkSize = 4096;
+
+	static constexpr std::uint64_t c_Prime1 = 0x9E37'79B1'85EB'CA87;
+	static constexpr std::uint64_t c_Prime2 = 0xC2B2'AE3D'27D4'EB4F;
+	static constexpr std::uint64_t c_Prime3 = 0x1656'67B1'9E37'79F9;
+
+	struct HashState
+	{
+		HashImplF     Stripes; // Kernel of the impl the text is decoded with
+		std::uint64_t Lanes[c_HashLanes] {};
+		std::size_t   Round = 0; // Stripes since the last scramble
+		std::size_t   Count = 0; // Codepoints hashed
+	};
+
+	static void HashStripes(HashState& state, const char32_t* codepoints, std::size_t stripes)
+	{
+		if (stripes > 0)
+			state.Stripes(state.Lanes, codepoints, stripes, state.Round);
+		state.Count += stripes * c_StripeCodepoints;
+	}
+
+	// Folds the 128 bit product of a and b into 64 bits
+	static std::uint64_t MulFold(std::uint64_t a, std::uint64_t b)
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+		return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+		return (a * b) ^ __umulh(a, b);
+#endif
+	}
+
+	static std::uint64_t Avalanche(std::uint64_t hash)
+	{
+		hash ^= hash >> 33;
+		hash *= c_Prime2;
+		hash ^= hash >> 29;
+		hash *= c_Prime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	// The codepoints that do not fill a stripe are hashed zero padded, the count tells them apart from actual zeros
+	static std::uint64_t FinishHash(HashState& state, const char32_t* codepoints, std::size_t count)
+	{
+		if (count > 0)
+		{
+			char32_t stripe[c_StripeCodepoints] {};
+			std::memcpy(stripe, codepoints, count * sizeof(char32_t));
+			HashStripes(state, stripe, 1);
+			state.Count -= c_StripeCodepoints - count;
+		}
+
+		// The pairs of lanes are folded independently of each other, which keeps short keys cheap
+		std::uint64_t hash = state.Count * c_Prime1;
+		for (std::size_t lane = 0; lane < c_HashLanes; lane += 2)
+			hash += MulFold(state.Lanes[lane] ^ LUTs::HashKeys[lane + 1], state.Lanes[lane + 1] ^ LUTs::HashKeys[lane + 2]);
+		return Avalanche(hash);
+	}
+
+	template <EEncoding From>
+	static std::uint64_t HashText(const void* input, std::size_t inputSize, EImpl impl)
+	{
+		using C = Details::CharTypeT<From>;
+
+		const C*    units = static_cast<const C*>(input);
+		std::size_t size  = inputSize / sizeof(C);
+		HashState   state { .Stripes = s_HashImpls[static_cast<std::uint8_t>(impl)] };
+
+		// Short keys are decoded in one go into a buffer of c_SmallMaxSize codepoints
+		if (inputSize < c_SmallMaxSize)
+		{
+			char32_t    codepoints[c_SmallMaxSize];
+			std::size_t offset  = 0;
+			std::size_t decoded = Details::DecodeReplaced<From>(units, size, offset, inputSize, codepoints, impl);
+			std::size_t stripes = decoded / c_StripeCodepoints;
+			HashStripes(state, codepoints, stripes);
+			return FinishHash(state, codepoints + stripes * c_StripeCodepoints, decoded - stripes * c_StripeCodepoints);
+		}
+
+		// The codepoints a chunk leaves short of a full stripe are moved in front of the next one
+		alignas(OutputBlock) char32_t codepoints[c_StripeCodepoints + (Details::MaxOutputSize<From, EEncoding::UTF32>(c_HashChunkSize) + sizeof(OutputBlock)) / sizeof(char32_t)];
+		std::size_t                   pending = 0;
+		for (std::size_t offset = 0; offset < size;)
+		{
+			std::size_t available = pending + Details::DecodeReplaced<From>(units, size, offset, c_HashChunkSize, std::span<char32_t>(codepoints).subspan(pending), impl);
+			std::size_t stripes   = available / c_StripeCodepoints;
+			HashStripes(state, codepoints, stripes);
+			pending = available - stripes * c_StripeCodepoints;
+			std::memmove(codepoints, codepoints + stripes * c_StripeCodepoints, pending * sizeof(char32_t));
+		}
+		return FinishHash(state, codepoints, pending);
+	}
+
+	namespace Details
+	{
+		std::uint64_t HashCodepoints(EEncoding encoding, const void* input, std::size_t inputSize, EImpl impl)
+		{
+			if (impl == EImpl::Fastest)
+				impl = GetFastestImpl();
+			switch (encoding)
+			{
+			case EEncoding::UTF16:
+				return HashText<EEncoding::UTF16>(input, inputSize, impl);
+			case EEncoding::UTF32:
+				return HashText<EEncoding::UTF32>(input, inputSize, impl);
+			case EEncoding::Latin1:
+				return HashText<EEncoding::Latin1>(input, inputSize, impl);
+			case EEncoding::ASCII:
+				return HashText<EEncoding::ASCII>(input, inputSize, impl);
+			default:
+				return HashText<EEncoding::UTF8>(input, inputSize, impl);
+			}
+		}
+	} // namespace Details
+} // namespace UTF
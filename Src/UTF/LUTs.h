@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace UTF::LUTs
@@ -7,4 +9,131 @@ namespace UTF::LUTs
 	alignas(64) constexpr std::uint8_t UTF8_6BitClass[64] { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 2, 2, 3, 3, 4, 5, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 2, 2, 3, 3, 4, 5 };
 
 	alignas(64) constexpr std::uint8_t UTF16_6BitClass[64] { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 3, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+	// Byte i holds the index of the i'th set bit of the mask, used to left pack the selected dword lanes with a single permute.
+	alignas(64) constexpr std::array<std::uint64_t, 256> PackDWordIndices = []() {
+		std::array<std::uint64_t, 256> table {};
+		for (std::uint32_t mask = 0; mask < 256; ++mask)
+		{
+			std::uint32_t count = 0;
+			for (std::uint32_t lane = 0; lane < 8; ++lane)
+			{
+				if (mask & (1U << lane))
+					table[mask] |= static_cast<std::uint64_t>(lane) << (8 * count++);
+			}
+		}
+		return table;
+	}();
+
+	// Byte shuffles that left pack the selected word lanes of a 128 bit register, unused lanes are zeroed.
+	alignas(64) constexpr std::array<std::array<std::uint8_t, 16>, 256> PackWordShuffles = []() {
+		std::array<std::array<std::uint8_t, 16>, 256> table {};
+		for (std::uint32_t mask = 0; mask < 256; ++mask)
+		{
+			std::uint32_t count = 0;
+			for (std::uint32_t lane = 0; lane < 8; ++lane)
+			{
+				if (mask & (1U << lane))
+				{
+					table[mask][2 * count]     = static_cast<std::uint8_t>(2 * lane);
+					table[mask][2 * count + 1] = static_cast<std::uint8_t>(2 * lane + 1);
+					++count;
+				}
+			}
+			for (std::uint32_t i = 2 * count; i < 16; ++i)
+				table[mask][i] = 0x80;
+		}
+		return table;
+	}();
+
+	// Index holds the encoded length minus one of 4 codepoints, 2 bits each, rows gather the used bytes of their dword lanes.
+	alignas(64) constexpr std::array<std::array<std::uint8_t, 16>, 256> PackUTF8Shuffles = []() {
+		std::array<std::array<std::uint8_t, 16>, 256> table {};
+		for (std::uint32_t index = 0; index < 256; ++index)
+		{
+			std::uint32_t count = 0;
+			for (std::uint32_t lane = 0; lane < 4; ++lane)
+			{
+				std::uint32_t length = ((index >> (2 * lane)) & 3) + 1;
+				for (std::uint32_t i = 0; i < length; ++i)
+					table[index][count++] = static_cast<std::uint8_t>(4 * lane + i);
+			}
+			for (std::uint32_t i = count; i < 16; ++i)
+				table[index][i] = 0x80;
+		}
+		return table;
+	}();
+
+	// Number of bytes gathered by the matching PackUTF8Shuffles row.
+	alignas(64) constexpr std::array<std::uint8_t, 256> PackUTF8Lengths = []() {
+		std::array<std::uint8_t, 256> table {};
+		for (std::uint32_t index = 0; index < 256; ++index)
+			table[index] = static_cast<std::uint8_t>(4 + (index & 3) + ((index >> 2) & 3) + ((index >> 4) & 3) + ((index >> 6) & 3));
+		return table;
+	}();
+
+	// Character classes of the UTF-8 decoding DFA, after Bjoern Hoehrmann's decoder. Bytes that can't appear anywhere are class 8,
+	// continuation bytes are split by the ranges E0, ED, F0 and F4 allow and leads by how many continuation bytes they take.
+	alignas(64) constexpr std::array<std::uint8_t, 256> UTF8DFAClasses = []() {
+		std::array<std::uint8_t, 256> table {};
+		for (std::uint32_t byte = 0; byte < 256; ++byte)
+		{
+			if (byte < 0x80)
+				table[byte] = 0;
+			else if (byte < 0x90)
+				table[byte] = 1;
+			else if (byte < 0xA0)
+				table[byte] = 9;
+			else if (byte < 0xC0)
+				table[byte] = 7;
+			else if (byte < 0xC2)
+				table[byte] = 8;
+			else if (byte < 0xE0)
+				table[byte] = 2;
+			else if (byte == 0xE0)
+				table[byte] = 10;
+			else if (byte == 0xED)
+				table[byte] = 4;
+			else if (byte < 0xF0)
+				table[byte] = 3;
+			else if (byte == 0xF0)
+				table[byte] = 11;
+			else if (byte < 0xF4)
+				table[byte] = 6;
+			else if (byte == 0xF4)
+				table[byte] = 5;
+			else
+				table[byte] = 8;
+		}
+		return table;
+	}();
+
+	// Next state of the UTF-8 decoding DFA at [state + class], states are premultiplied by the 12 classes.
+	// 0 accepts, 12 rejects and never leaves again, 24, 36 and 84 wait for one, two and three more continuation bytes,
+	// 48, 60, 72 and 96 wait for the restricted second byte after E0, ED, F0 and F4.
+	alignas(64) constexpr std::uint8_t UTF8DFATransitions[108] {
+		0, 12, 24, 36, 60, 96, 84, 12, 12, 12, 48, 72,
+		12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+		12, 0, 12, 12, 12, 12, 12, 0, 12, 0, 12, 12,
+		12, 24, 12, 12, 12, 12, 12, 24, 12, 24, 12, 12,
+		12, 12, 12, 12, 12, 12, 12, 24, 12, 12, 12, 12,
+		12, 24, 12, 12, 12, 12, 12, 12, 12, 24, 12, 12,
+		12, 12, 12, 12, 12, 12, 12, 36, 12, 36, 12, 12,
+		12, 36, 12, 12, 12, 12, 12, 36, 12, 36, 12, 12,
+		12, 36, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12
+	};
+
+	// Keys of the codepoint hash, stripe i since the last scramble is keyed from HashKeys[i] on and the scramble after HashRoundStripes
+	// stripes uses the last 8. The scramble multiplies every lane by HashPrime.
+	constexpr std::size_t   HashRoundStripes = 16;
+	constexpr std::uint64_t HashPrime        = 0x9E37'79B1;
+
+	alignas(64) constexpr std::uint64_t HashKeys[HashRoundStripes + 8] {
+		0x8F2B'F796'7DAC'FDCD, 0x0998'0A82'9C52'7D4B, 0xABE2'EE39'385C'E3E2, 0x34E6'5116'E929'77F8,
+		0x22F9'F88D'41B4'A0CF, 0xDC13'F6A5'1661'03AF, 0xCF5B'5F2D'CC0C'9497, 0x5376'5256'FCC7'E454,
+		0x0F1B'9290'FE08'5F01, 0x1061'8480'8B09'4D84, 0x3225'8270'2F6A'F449, 0x8F05'88A3'CE5F'FA39,
+		0x5265'733A'6E22'02BF, 0xDBA0'3C48'60E5'EBA0, 0x685F'7160'6C7F'FDE4, 0x3154'EEF4'55E1'FDF1,
+		0xEBC9'AABC'3E33'8B14, 0xFB31'C5BD'2C32'D165, 0xB068'5D48'1437'3FCC, 0xB033'B3F1'30FF'1722,
+		0x47AA'0D4A'3923'842E, 0xF195'9376'0223'0FAE, 0xC481'5DD4'E1A5'4670, 0x1AB9'9828'E320'E4F5
+	};
 } // namespace UTF::LUTs
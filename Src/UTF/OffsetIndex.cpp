@@ -0,0 +1,146 @@
+#include "UTF/UTF.h"
+
+#include <algorithm>
+
+namespace UTF
+{
+	static constexpr std::uint8_t c_UTF8Index = static_cast<std::uint8_t>(EEncoding::UTF8);
+	// Find skips whole pieces of this many bytes with the kernels before it walks the last one a byte at a time
+	static constexpr std::size_t c_FindPieceSize = 64;
+
+	// Latin-1 and ASCII units are counted in the samples of UTF-32
+	static std::uint8_t SampleIndex(EEncoding encoding)
+	{
+		return std::min(static_cast<std::uint8_t>(encoding), static_cast<std::uint8_t>(EEncoding::UTF32));
+	}
+
+	static std::size_t CountUnits(const char8_t* bytes, std::size_t size, EEncoding encoding, EImpl impl)
+	{
+		switch (encoding)
+		{
+		case EEncoding::UTF16:
+			return Length<EEncoding::UTF8, EEncoding::UTF16>(bytes, size, impl);
+		case EEncoding::UTF32:
+		case EEncoding::Latin1:
+		case EEncoding::ASCII:
+			return CountCodepoints<EEncoding::UTF8>(bytes, size, impl);
+		default:
+			return size;
+		}
+	}
+
+	// Same count per byte as the Length kernels, the leading byte of a sequence counts for all of its units
+	static std::size_t ByteUnits(char8_t byte, EEncoding encoding)
+	{
+		if ((byte & 0xC0) == 0x80)
+			return 0;
+		return encoding == EEncoding::UTF16 && byte >= 0xF0 ? 2 : 1;
+	}
+
+	OffsetIndex::OffsetIndex(std::size_t sampleSize, EImpl impl)
+		: m_SampleSize(std::max<std::size_t>(sampleSize, 1)),
+		  m_Impl(impl == EImpl::Fastest ? GetFastestImpl() : impl),
+		  m_Samples(1),
+		  m_Total() {}
+
+	std::size_t OffsetIndex::Size(EEncoding encoding) const
+	{
+		return m_Total.Units[SampleIndex(encoding)];
+	}
+
+	void OffsetIndex::Build(std::u8string_view text)
+	{
+		m_Samples.assign(1, Sample {});
+		m_Total = Advance(text, Sample {}, text.size(), m_Samples);
+	}
+
+	void OffsetIndex::Update(std::u8string_view text, std::size_t offset, std::size_t removed, std::size_t inserted)
+	{
+		// Samples before offset still count the same bytes, the ones past the removed bytes count the same bytes from a new position
+		auto kept  = std::lower_bound(m_Samples.begin() + 1, m_Samples.end(), offset, [](const Sample& sample, std::size_t value) { return sample.Units[c_UTF8Index] < value; });
+		auto moved = std::upper_bound(kept, m_Samples.end(), offset + removed, [](std::size_t value, const Sample& sample) { return value < sample.Units[c_UTF8Index]; });
+
+		std::vector<Sample> samples;
+		if (moved == m_Samples.end())
+		{
+			m_Total = Advance(text, kept[-1], text.size(), samples);
+		}
+		else
+		{
+			// Everything past the first moved sample changes by as much as the sample itself
+			Sample before = *moved;
+			Sample after  = Advance(text, kept[-1], moved->Units[c_UTF8Index] - removed + inserted, samples);
+			auto   move   = [&](Sample& sample) {
+				for (std::uint8_t encoding = 0; encoding < c_SampledCount; ++encoding)
+					sample.Units[encoding] = sample.Units[encoding] - before.Units[encoding] + after.Units[encoding];
+			};
+			std::for_each(moved, m_Samples.end(), move);
+			move(m_Total);
+		}
+
+		m_Samples.insert(m_Samples.erase(kept, moved), samples.begin(), samples.end());
+	}
+
+	std::size_t OffsetIndex::Translate(std::u8string_view text, std::size_t offset, EEncoding from, EEncoding to) const
+	{
+		std::size_t position = 0;
+		if (from == EEncoding::UTF8)
+		{
+			position = std::min(offset, text.size());
+			for (std::size_t i = 0; i < 3 && position > 0 && position < text.size() && (text[position] & 0xC0) == 0x80; ++i)
+				--position;
+		}
+		else
+		{
+			position = Find(text, offset, from);
+		}
+		return to == EEncoding::UTF8 ? position : Count(text, position, to);
+	}
+
+	// Counts from sample up to end, the samples every m_SampleSize bytes before end are appended to samples
+	OffsetIndex::Sample OffsetIndex::Advance(std::u8string_view text, Sample sample, std::size_t end, std::vector<Sample>& samples) const
+	{
+		while (sample.Units[c_UTF8Index] < end)
+		{
+			const char8_t* bytes = text.data() + sample.Units[c_UTF8Index];
+			std::size_t    size  = std::min(m_SampleSize, end - sample.Units[c_UTF8Index]);
+			for (std::uint8_t encoding = 0; encoding < c_SampledCount; ++encoding)
+				sample.Units[encoding] += CountUnits(bytes, size, static_cast<EEncoding>(encoding), m_Impl);
+			if (sample.Units[c_UTF8Index] < end)
+				samples.push_back(sample);
+		}
+		return sample;
+	}
+
+	// Units of encoding in front of the byte at offset
+	std::size_t OffsetIndex::Count(std::u8string_view text, std::size_t offset, EEncoding encoding) const
+	{
+		auto sample = std::upper_bound(m_Samples.begin(), m_Samples.end(), offset, [](std::size_t value, const Sample& sample) { return value < sample.Units[c_UTF8Index]; }) - 1;
+		return sample->Units[SampleIndex(encoding)] + CountUnits(text.data() + sample->Units[c_UTF8Index], offset - sample->Units[c_UTF8Index], encoding, m_Impl);
+	}
+
+	// Byte offset of the sequence that holds unit offset of encoding, the end of the text when there is none
+	std::size_t OffsetIndex::Find(std::u8string_view text, std::size_t offset, EEncoding encoding) const
+	{
+		std::uint8_t index    = SampleIndex(encoding);
+		auto         sample   = std::upper_bound(m_Samples.begin(), m_Samples.end(), offset, [index](std::size_t value, const Sample& sample) { return value < sample.Units[index]; }) - 1;
+		std::size_t  position = sample->Units[c_UTF8Index];
+		std::size_t  count    = sample->Units[index];
+		while (position + c_FindPieceSize <= text.size())
+		{
+			std::size_t units = CountUnits(text.data() + position, c_FindPieceSize, encoding, m_Impl);
+			if (count + units > offset)
+				break;
+			count    += units;
+			position += c_FindPieceSize;
+		}
+		for (; position < text.size(); ++position)
+		{
+			std::size_t units = ByteUnits(text[position], encoding);
+			if (count + units > offset)
+				break;
+			count += units;
+		}
+		return position;
+	}
+} // namespace UTF
@@ -1,64 +1,1828 @@
 #include "UTF/SIMD.h"
+#include "LUTs.h"
+#include "UTF/Generic.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#include <immintrin.h>
+
+	#include <algorithm>
+	#include <bit>
+	#include <cstring>
+
+	// Only called once the CPU reported AVX2, the rest of the build keeps targeting the baseline ISA
+	#if defined(__clang__)
+		#pragma clang attribute push(__attribute__((target("avx2,bmi,bmi2,popcnt"))), apply_to = function)
+	#elif defined(__GNUC__)
+		#pragma GCC push_options
+		#pragma GCC target("avx2,bmi,bmi2,popcnt")
+	#endif
+
+	#include "ConvBuffer.h"
+#endif
 
 namespace UTF::SIMD
 {
+#if defined(__x86_64__) || defined(_M_X64)
+	// Byte class masks of 64 consecutive UTF-8 bytes, bit i describes byte i.
+	// The leading bytes E0, ED, F0 and F4 narrow the range of the byte after them, which rules out the overlong three and four byte
+	// sequences, surrogates and codepoints past U+10FFFF.
+	struct UTF8Masks
+	{
+		std::uint64_t High; // >= 0x80
+		std::uint64_t Ge2;  // >= 0xC0, leading byte of 2 or more bytes
+		std::uint64_t Ge3;  // >= 0xE0, leading byte of 3 or more bytes
+		std::uint64_t Ge4;  // >= 0xF0, leading byte of 4 bytes
+		std::uint64_t Bad;  // C0, C1 and >= 0xF5, never valid as every sequence they start is overlong or past U+10FFFF
+		std::uint64_t E0;   // == 0xE0, overlong when the byte after it is below 0xA0
+		std::uint64_t ED;   // == 0xED, a surrogate when the byte after it is from 0xA0 on
+		std::uint64_t F0;   // == 0xF0, overlong when the byte after it is below 0x90
+		std::uint64_t F4;   // == 0xF4, past U+10FFFF when the byte after it is from 0x90 on
+		std::uint64_t Ge90; // >= 0x90
+		std::uint64_t GeA0; // >= 0xA0
+	};
+
+	static std::uint64_t MoveMask(__m256i lo, __m256i hi)
+	{
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(lo)) | static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(hi))) << 32;
+	}
+
+	// Signed compares, the high bit mask filters out the ASCII bytes that compare greater as well
+	static std::uint64_t Greater(__m256i lo, __m256i hi, std::uint8_t value)
+	{
+		__m256i bound = _mm256_set1_epi8(static_cast<char>(value));
+		return MoveMask(_mm256_cmpgt_epi8(lo, bound), _mm256_cmpgt_epi8(hi, bound));
+	}
+
+	static std::uint64_t Equal(__m256i lo, __m256i hi, std::uint8_t value)
+	{
+		__m256i match = _mm256_set1_epi8(static_cast<char>(value));
+		return MoveMask(_mm256_cmpeq_epi8(lo, match), _mm256_cmpeq_epi8(hi, match));
+	}
+
+	static UTF8Masks ClassifyUTF8(const std::uint8_t* bytes)
+	{
+		__m256i       lo   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));
+		__m256i       hi   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + 32));
+		std::uint64_t high = MoveMask(lo, hi);
+		return {
+			.High = high,
+			.Ge2  = high & Greater(lo, hi, 0xBF),
+			.Ge3  = high & Greater(lo, hi, 0xDF),
+			.Ge4  = high & Greater(lo, hi, 0xEF),
+			.Bad  = (high & Greater(lo, hi, 0xF4)) | Equal(lo, hi, 0xC0) | Equal(lo, hi, 0xC1),
+			.E0   = Equal(lo, hi, 0xE0),
+			.ED   = Equal(lo, hi, 0xED),
+			.F0   = Equal(lo, hi, 0xF0),
+			.F4   = Equal(lo, hi, 0xF4),
+			.Ge90 = high & Greater(lo, hi, 0x8F),
+			.GeA0 = high & Greater(lo, hi, 0x9F)
+		};
+	}
+
+	static std::uint64_t RangeMask(std::size_t begin, std::size_t end)
+	{
+		std::uint64_t endMask = end >= 64 ? ~0ULL : ((1ULL << end) - 1);
+		return endMask & (~0ULL << begin);
+	}
+
+	// Decodes the 8 codepoints that would start at bytes[0..7] if each of them was a leading byte, reads bytes[0..15].
+	// Lanes that hold a continuation byte produce garbage and have to be dropped by the caller.
+	static __m256i DecodeUTF8Lanes(const std::uint8_t* bytes)
+	{
+		const __m256i c_Gather    = _mm256_setr_epi8(0, 1, 2, 3, 1, 2, 3, 4, 2, 3, 4, 5, 3, 4, 5, 6, 4, 5, 6, 7, 5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10);
+		const __m256i c_LeadMasks = _mm256_setr_epi8(0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0, 0, 0, 0, 0x1F, 0x1F, 0x0F, 0x07, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0, 0, 0, 0, 0x1F, 0x1F, 0x0F, 0x07);
+		const __m256i c_Shifts    = _mm256_setr_epi8(18, 18, 18, 18, 18, 18, 18, 18, 0, 0, 0, 0, 12, 12, 6, 0, 18, 18, 18, 18, 18, 18, 18, 18, 0, 0, 0, 0, 12, 12, 6, 0);
+
+		__m256i lanes   = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))), c_Gather);
+		__m256i nibbles = _mm256_and_si256(_mm256_srli_epi32(lanes, 4), _mm256_set1_epi32(0x0F));
+		__m256i masks   = _mm256_and_si256(_mm256_shuffle_epi8(c_LeadMasks, nibbles), _mm256_set1_epi32(0x3F3F'3FFF));
+		__m256i shifts  = _mm256_and_si256(_mm256_shuffle_epi8(c_Shifts, nibbles), _mm256_set1_epi32(0xFF));
+		// (b0 << 6 | b1) and (b2 << 6 | b3), then (b0 << 18 | b1 << 12 | b2 << 6 | b3), then drop the bytes past the sequence
+		__m256i pairs   = _mm256_maddubs_epi16(_mm256_and_si256(lanes, masks), _mm256_set1_epi32(0x0140'0140));
+		__m256i merged  = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x0001'1000));
+		return _mm256_srlv_epi32(merged, shifts);
+	}
+
+	static __m256i PackDWords(__m256i lanes, std::uint32_t mask)
+	{
+		__m256i indices = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(LUTs::PackDWordIndices[mask])));
+		return _mm256_permutevar8x32_epi32(lanes, indices);
+	}
+
+	// Stores a whole vector when it fits inside the output block, otherwise only the used leading bytes.
+	static void StoreOutput(OutputBlock& output, std::size_t offset, __m128i value, std::size_t used)
+	{
+		if (offset + sizeof(__m128i) <= sizeof(OutputBlock))
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output.Bytes + offset), value);
+		else
+			std::memcpy(output.Bytes + offset, &value, used);
+	}
+
+	static void StoreOutput(OutputBlock& output, std::size_t offset, __m256i value, std::size_t used)
+	{
+		if (offset + sizeof(__m256i) <= sizeof(OutputBlock))
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(output.Bytes + offset), value);
+		else
+			std::memcpy(output.Bytes + offset, &value, used);
+	}
+
+	// Writes count UTF-32 codepoints as UTF-16, splitting the ones above U+FFFF into surrogate pairs.
+	static std::size_t StoreUTF16(OutputBlock& output, std::size_t offset, __m256i codepoints, std::uint32_t count, bool hasSupplementary)
+	{
+		if (!hasSupplementary)
+		{
+			__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(codepoints, codepoints), 0b00'00'10'00);
+			StoreOutput(output, offset, _mm256_castsi256_si128(packed), count * 2);
+			return count * 2;
+		}
+
+		__m256i isSupplementary = _mm256_cmpgt_epi32(codepoints, _mm256_set1_epi32(0xFFFF));
+		__m256i offsets         = _mm256_sub_epi32(codepoints, _mm256_set1_epi32(0x1'0000));
+		__m256i high            = _mm256_or_si256(_mm256_srli_epi32(offsets, 10), _mm256_set1_epi32(0xD800));
+		__m256i low             = _mm256_or_si256(_mm256_and_si256(offsets, _mm256_set1_epi32(0x3FF)), _mm256_set1_epi32(0xDC00));
+		__m256i units           = _mm256_blendv_epi8(codepoints, _mm256_or_si256(high, _mm256_slli_epi32(low, 16)), isSupplementary);
+		// Every lane keeps its low word, supplementary lanes keep their high word as well
+		__m256i       keep     = _mm256_or_si256(isSupplementary, _mm256_set1_epi32(0xFFFF));
+		std::uint32_t keepBits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_packs_epi16(keep, _mm256_setzero_si256())));
+		std::uint32_t keepLo   = keepBits & ((1U << (2 * std::min<std::uint32_t>(count, 4))) - 1);
+		std::uint32_t keepHi   = (keepBits >> 16) & ((1U << (2 * (std::max<std::uint32_t>(count, 4) - 4))) - 1);
+
+		std::size_t loSize = std::popcount(keepLo) * 2;
+		std::size_t hiSize = std::popcount(keepHi) * 2;
+		__m128i     lo     = _mm_shuffle_epi8(_mm256_castsi256_si128(units), _mm_load_si128(reinterpret_cast<const __m128i*>(LUTs::PackWordShuffles[keepLo].data())));
+		__m128i     hi     = _mm_shuffle_epi8(_mm256_extracti128_si256(units, 1), _mm_load_si128(reinterpret_cast<const __m128i*>(LUTs::PackWordShuffles[keepHi].data())));
+		StoreOutput(output, offset, lo, loSize);
+		StoreOutput(output, offset + loSize, hi, hiSize);
+		return loSize + hiSize;
+	}
+
+	// Zeroes the lanes at and past count.
+	static __m256i FirstLanes(__m256i lanes, std::uint32_t count)
+	{
+		__m256i indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		return _mm256_and_si256(lanes, _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), indices));
+	}
+
+	// Writes the first count codepoints as UTF-8, returns the number of bytes written.
+	static std::size_t StoreUTF8(OutputBlock& output, std::size_t offset, __m256i codepoints, std::uint32_t count)
+	{
+		// Cleared lanes encode as a single byte each, which always lands after the used bytes
+		codepoints        = FirstLanes(codepoints, count);
+		__m256i isMulti   = _mm256_cmpgt_epi32(codepoints, _mm256_set1_epi32(0x7F));
+		if (_mm256_testz_si256(isMulti, isMulti))
+		{
+			__m256i bytes = _mm256_packus_epi16(_mm256_packus_epi32(codepoints, codepoints), _mm256_setzero_si256());
+			bytes         = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1));
+			StoreOutput(output, offset, _mm256_castsi256_si128(bytes), count);
+			return count;
+		}
+
+		__m256i is3    = _mm256_cmpgt_epi32(codepoints, _mm256_set1_epi32(0x7FF));
+		__m256i is4    = _mm256_cmpgt_epi32(codepoints, _mm256_set1_epi32(0xFFFF));
+		__m256i extra  = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_add_epi32(_mm256_add_epi32(isMulti, is3), is4));
+		__m256i shifts = _mm256_sub_epi32(_mm256_set1_epi32(24), _mm256_slli_epi32(extra, 3));
+		// Spread the 6 bit groups in reverse, (cp & 0x3F) << 24 | ... | cp >> 18, mark them all as continuations and
+		// shift out the unused groups, the leading byte is then the lowest byte and only needs its length prefix
+		__m256i groups = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32(codepoints, 24), _mm256_set1_epi32(0x3F00'0000)),
+														 _mm256_and_si256(_mm256_slli_epi32(codepoints, 10), _mm256_set1_epi32(0x003F'0000))),
+										 _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(codepoints, 4), _mm256_set1_epi32(0x0000'3F00)),
+														 _mm256_srli_epi32(codepoints, 18)));
+		__m256i prefix = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(0x7F80), extra), _mm256_set1_epi32(0xF0));
+		__m256i bytes  = _mm256_or_si256(_mm256_srlv_epi32(_mm256_or_si256(groups, _mm256_set1_epi32(static_cast<int>(0x8080'8080))), shifts), prefix);
+		bytes          = _mm256_blendv_epi8(codepoints, bytes, isMulti);
+
+		// Gather the 2 bit lengths of each half into a LUT index
+		std::uint32_t lengthBits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_slli_epi32(extra, 7), _mm256_slli_epi32(extra, 14))));
+		std::uint32_t indexLo    = lengthBits & 0x3333;
+		std::uint32_t indexHi    = (lengthBits >> 16) & 0x3333;
+		indexLo                  = (indexLo | indexLo >> 2) & 0x0F0F;
+		indexHi                  = (indexHi | indexHi >> 2) & 0x0F0F;
+		indexLo                  = (indexLo | indexLo >> 4) & 0xFF;
+		indexHi                  = (indexHi | indexHi >> 4) & 0xFF;
+
+		__m128i     lo     = _mm_shuffle_epi8(_mm256_castsi256_si128(bytes), _mm_load_si128(reinterpret_cast<const __m128i*>(LUTs::PackUTF8Shuffles[indexLo].data())));
+		std::size_t loSize = LUTs::PackUTF8Lengths[indexLo];
+		if (count <= 4)
+		{
+			StoreOutput(output, offset, lo, loSize - (4 - count));
+			return loSize - (4 - count);
+		}
+		__m128i     hi     = _mm_shuffle_epi8(_mm256_extracti128_si256(bytes, 1), _mm_load_si128(reinterpret_cast<const __m128i*>(LUTs::PackUTF8Shuffles[indexHi].data())));
+		std::size_t hiSize = LUTs::PackUTF8Lengths[indexHi] - (8 - count);
+		StoreOutput(output, offset, lo, loSize);
+		StoreOutput(output, offset + loSize, hi, hiSize);
+		return loSize + hiSize;
+	}
+
+	// Surrogate masks of the 64 UTF-16 units of a block, bit i describes unit i.
+	static void ClassifyUTF16(const InputBlock& input, std::uint64_t& high, std::uint64_t& low)
+	{
+		high = 0;
+		low  = 0;
+		for (std::size_t half = 0; half < 2; ++half)
+		{
+			__m256i a     = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + half * 64)), _mm256_set1_epi16(static_cast<short>(0xFC00)));
+			__m256i b     = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + half * 64 + 32)), _mm256_set1_epi16(static_cast<short>(0xFC00)));
+			__m256i highA = _mm256_cmpeq_epi16(a, _mm256_set1_epi16(static_cast<short>(0xD800)));
+			__m256i highB = _mm256_cmpeq_epi16(b, _mm256_set1_epi16(static_cast<short>(0xD800)));
+			__m256i lowA  = _mm256_cmpeq_epi16(a, _mm256_set1_epi16(static_cast<short>(0xDC00)));
+			__m256i lowB  = _mm256_cmpeq_epi16(b, _mm256_set1_epi16(static_cast<short>(0xDC00)));
+			high         |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(highA, highB), 0b11'01'10'00)))) << (half * 32);
+			low          |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(lowA, lowB), 0b11'01'10'00)))) << (half * 32);
+		}
+	}
+
+	// Validates UTF-8 a 64 byte window at a time and counts the codepoints with popcounts, sequences have to end inside the input.
+	template <EEncoding To>
+	static EError CalcReqSizeFrom8(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize = 0;
+
+		const std::uint8_t*      bytes     = static_cast<const std::uint8_t*>(input);
+		std::size_t              leaders   = 0;
+		std::size_t              fourBytes = 0;
+		std::uint64_t            carry     = 0;
+		std::uint64_t            afterE0   = 0;
+		std::uint64_t            afterED   = 0;
+		std::uint64_t            afterF0   = 0;
+		std::uint64_t            afterF4   = 0;
+		alignas(64) std::uint8_t tail[64];
+		for (std::size_t offset = 0; offset < inputSize; offset += 64)
+		{
+			const std::uint8_t* window = bytes + offset;
+			std::size_t         length = std::min<std::size_t>(inputSize - offset, 64);
+			if (length < 64)
+			{
+				std::memcpy(tail, window, length);
+				std::memset(tail + length, 0, sizeof(tail) - length);
+				window = tail;
+			}
+
+			UTF8Masks masks = ClassifyUTF8(window);
+			if (!(masks.High | carry))
+			{
+				leaders += length;
+				continue;
+			}
+
+			// Same checks as ConvBlockFrom8, the zeroes past the input fail any sequence that is cut off
+			std::uint64_t range      = RangeMask(0, length);
+			std::uint64_t cont       = masks.High & ~masks.Ge2;
+			std::uint64_t required   = carry | masks.Ge2 << 1 | masks.Ge3 << 2 | masks.Ge4 << 3;
+			std::uint64_t fromA0     = afterE0 | masks.E0 << 1;
+			std::uint64_t belowA0    = afterED | masks.ED << 1;
+			std::uint64_t from90     = afterF0 | masks.F0 << 1;
+			std::uint64_t below90    = afterF4 | masks.F4 << 1;
+			std::uint64_t leadErrors = (masks.Bad & range) | (cont & range & ~required);
+			std::uint64_t contErrors = (required & ~cont) | (fromA0 & ~masks.GeA0) | (belowA0 & masks.GeA0) | (from90 & ~masks.Ge90) | (below90 & masks.Ge90);
+			carry                    = masks.Ge2 >> 63 | masks.Ge3 >> 62 | masks.Ge4 >> 61;
+			afterE0                  = masks.E0 >> 63;
+			afterED                  = masks.ED >> 63;
+			afterF0                  = masks.F0 >> 63;
+			afterF4                  = masks.F4 >> 63;
+			if (leadErrors | contErrors)
+				return std::countr_zero(leadErrors) < std::countr_zero(contErrors) ? EError::InvalidLeading : EError::InvalidContinuation;
+
+			leaders   += std::popcount(range & ~cont);
+			fourBytes += std::popcount(masks.Ge4);
+		}
+		if (carry)
+			return EError::InvalidContinuation;
+
+		if constexpr (To == EEncoding::UTF16)
+			requiredSize = 2 * (leaders + fourBytes);
+		else
+			requiredSize = 4 * leaders;
+		return EError::Success;
+	}
+
+	// Validates UTF-16 32 units at a time, the UTF-8 size is one byte per unit plus one from 0x80 and one more from 0x800 on,
+	// with every surrogate taking one back so that a pair adds up to 4.
+	template <EEncoding To>
+	static EError CalcReqSizeFrom16(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize = 0;
+
+		const std::uint8_t*      bytes = static_cast<const std::uint8_t*>(input);
+		std::size_t              size  = 0;
+		std::uint64_t            carry = 0;
+		alignas(64) std::uint8_t tail[64];
+		for (std::size_t offset = 0; offset < inputSize; offset += 64)
+		{
+			const std::uint8_t* window = bytes + offset;
+			std::size_t         length = std::min<std::size_t>(inputSize - offset, 64);
+			std::size_t         units  = (length + 1) / 2;
+			if (length < 64)
+			{
+				std::memcpy(tail, window, length);
+				std::memset(tail + length, 0, sizeof(tail) - length);
+				window = tail;
+			}
+
+			__m256i a        = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(window));
+			__m256i b        = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(window + 32));
+			__m256i nonASCII = _mm256_set1_epi16(static_cast<short>(0xFF80));
+			if (!carry && _mm256_testz_si256(_mm256_or_si256(a, b), nonASCII))
+			{
+				size += To == EEncoding::UTF8 ? units : 4 * units;
+				continue;
+			}
+
+			__m256i       surrogateBits = _mm256_set1_epi16(static_cast<short>(0xFC00));
+			__m256i       maskedA       = _mm256_and_si256(a, surrogateBits);
+			__m256i       maskedB       = _mm256_and_si256(b, surrogateBits);
+			__m256i       highA         = _mm256_cmpeq_epi16(maskedA, _mm256_set1_epi16(static_cast<short>(0xD800)));
+			__m256i       highB         = _mm256_cmpeq_epi16(maskedB, _mm256_set1_epi16(static_cast<short>(0xD800)));
+			__m256i       lowA          = _mm256_cmpeq_epi16(maskedA, _mm256_set1_epi16(static_cast<short>(0xDC00)));
+			__m256i       lowB          = _mm256_cmpeq_epi16(maskedB, _mm256_set1_epi16(static_cast<short>(0xDC00)));
+			std::uint64_t high          = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(highA, highB), 0b11'01'10'00)));
+			std::uint64_t low           = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(lowA, lowB), 0b11'01'10'00)));
+
+			std::uint64_t range      = RangeMask(0, units);
+			std::uint64_t required   = carry | (high & range) << 1;
+			std::uint64_t leadErrors = low & range & ~required;
+			std::uint64_t contErrors = required & ~low & 0xFFFF'FFFF;
+			carry                    = required >> 32;
+			if (leadErrors | contErrors)
+				return std::countr_zero(leadErrors) < std::countr_zero(contErrors) ? EError::InvalidLeading : EError::InvalidContinuation;
+
+			if constexpr (To == EEncoding::UTF8)
+			{
+				// Lanes past the input are zero and count for nothing
+				__m256i       zero     = _mm256_setzero_si256();
+				__m256i       ge80A    = _mm256_cmpeq_epi16(_mm256_and_si256(a, nonASCII), zero);
+				__m256i       ge80B    = _mm256_cmpeq_epi16(_mm256_and_si256(b, nonASCII), zero);
+				__m256i       ge800A   = _mm256_cmpeq_epi16(_mm256_and_si256(a, _mm256_set1_epi16(static_cast<short>(0xF800))), zero);
+				__m256i       ge800B   = _mm256_cmpeq_epi16(_mm256_and_si256(b, _mm256_set1_epi16(static_cast<short>(0xF800))), zero);
+				std::uint32_t below80  = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_packs_epi16(ge80A, ge80B)));
+				std::uint32_t below800 = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_packs_epi16(ge800A, ge800B)));
+				size                  += 3 * units - (std::popcount(below80) - (32 - units)) - (std::popcount(below800) - (32 - units)) - std::popcount(high | low);
+			}
+			else
+			{
+				size += 4 * (units - std::popcount(low & range));
+			}
+		}
+		if (carry)
+			return EError::InvalidContinuation;
+
+		requiredSize = size;
+		return EError::Success;
+	}
+
+	// Whether a lane is past U+10FFFF or a surrogate, neither has an encoding in UTF-8 or UTF-16
+	static bool InvalidCodepoints(__m256i codepoints)
+	{
+		__m256i limit     = _mm256_set1_epi32(0x10'FFFF);
+		__m256i inRange   = _mm256_cmpeq_epi32(_mm256_max_epu32(codepoints, limit), limit);
+		__m256i surrogate = _mm256_cmpeq_epi32(_mm256_and_si256(codepoints, _mm256_set1_epi32(static_cast<int>(0xFFFF'F800))), _mm256_set1_epi32(0xD800));
+		return _mm256_movemask_epi8(_mm256_andnot_si256(surrogate, inRange)) != -1;
+	}
+
+	template <EEncoding To>
+	static EError CalcReqSizeFrom32(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		requiredSize = 0;
+
+		const std::uint8_t* bytes = static_cast<const std::uint8_t*>(input);
+		std::size_t         units = (inputSize + 3) / 4;
+		std::size_t         size  = 0;
+		for (std::size_t unit = 0; unit < units; unit += 8)
+		{
+			std::uint32_t count      = static_cast<std::uint32_t>(std::min<std::size_t>(units - unit, 8));
+			__m256i       lanes      = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+			__m256i       codepoints = count == 8 ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + unit * 4)) : _mm256_maskload_epi32(reinterpret_cast<const int*>(bytes + unit * 4), lanes);
+			if (InvalidCodepoints(codepoints))
+				return EError::OOB;
+
+			// Valid codepoints are positive, so signed compares work, lanes past the input are zero
+			std::uint32_t supplementary = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(codepoints, _mm256_set1_epi32(0xFFFF)))));
+			if constexpr (To == EEncoding::UTF8)
+			{
+				std::uint32_t ge80  = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(codepoints, _mm256_set1_epi32(0x7F)))));
+				std::uint32_t ge800 = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(codepoints, _mm256_set1_epi32(0x7FF)))));
+				size               += count + std::popcount(ge80) + std::popcount(ge800) + std::popcount(supplementary);
+			}
+			else
+			{
+				size += 2 * (count + std::popcount(supplementary));
+			}
+		}
+		requiredSize = size;
+		return EError::Success;
+	}
+
+	// Windows of 32 bytes where every byte from 0x80 on is C2 or C3 or the continuation byte after one, carry is a leading byte that
+	// ended the window before. The first window that breaks this and the bytes after the last one are left to Generic.
+	static EError CalcReqSize8ToLatin1AVX2(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		const std::uint8_t* bytes  = static_cast<const std::uint8_t*>(input);
+		std::size_t         size   = 0;
+		std::size_t         offset = 0;
+		std::uint32_t       carry  = 0;
+		for (; offset + 32 <= inputSize; offset += 32)
+		{
+			__m256i       window = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + offset));
+			std::uint32_t high   = static_cast<std::uint32_t>(_mm256_movemask_epi8(window));
+			if ((high | carry) == 0)
+			{
+				size += 32;
+				continue;
+			}
+
+			std::uint32_t leads = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(window, _mm256_set1_epi8(static_cast<char>(0xFE))), _mm256_set1_epi8(static_cast<char>(0xC2)))));
+			std::uint32_t ge2   = high & static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(window, _mm256_set1_epi8(static_cast<char>(0xBF)))));
+			std::uint32_t conts = high & ~ge2;
+			if (ge2 != leads || conts != (leads << 1 | carry))
+				break;
+			size  += 32 - std::popcount(conts);
+			carry  = leads >> 31;
+		}
+
+		// The leading byte the last window ended with is sized again along with its continuation byte
+		std::size_t start = offset - carry;
+		std::size_t tail  = 0;
+		EError      error = Generic::CalcReqSize8ToLatin1(bytes + start, inputSize - start, tail);
+		requiredSize      = size - carry + tail;
+		return error;
+	}
+
+	// Same units as Generic::CalcReqSizeLatin1To16 and the others, 32 bytes are checked against the limit at a time
+	template <class In, class Out, char32_t Limit, EError Error>
+	static EError CalcReqSizeUnits(const void* input, std::size_t inputSize, std::size_t& requiredSize)
+	{
+		constexpr std::uint64_t c_Over = Details::c_LimitBits<sizeof(In), Limit>;
+
+		const std::uint8_t* bytes = static_cast<const std::uint8_t*>(input);
+		std::size_t         size  = inputSize / sizeof(In) * sizeof(In);
+		requiredSize              = 0;
+		if constexpr (c_Over != 0)
+		{
+			__m256i     over   = _mm256_set1_epi64x(static_cast<long long>(c_Over));
+			std::size_t offset = 0;
+			for (; offset + 32 <= size; offset += 32)
+			{
+				if (!_mm256_testz_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + offset)), over))
+					return Error;
+			}
+			for (; offset < size; offset += sizeof(In))
+			{
+				In unit;
+				std::memcpy(&unit, bytes + offset, sizeof(unit));
+				if (unit >= Limit)
+					return Error;
+			}
+		}
+		requiredSize = size / sizeof(In) * sizeof(Out);
+		return EError::Success;
+	}
+
+	// Adds up 32 byte counters
+	static std::size_t SumBytes(__m256i counters)
+	{
+		__m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+		__m128i half = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+		return static_cast<std::size_t>(_mm_cvtsi128_si64(half) + _mm_extract_epi64(half, 1));
+	}
+
+	// Counts the continuation bytes, and for UTF-16 the leading bytes of 4 byte sequences, in byte counters that are summed every
+	// 255 vectors. The bytes after the last whole vector are left to Generic.
+	template <EEncoding To>
+	static EError LengthFrom8(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		const std::uint8_t* bytes     = static_cast<const std::uint8_t*>(input);
+		std::size_t         vectors   = inputSize / 32;
+		std::size_t         leaders   = vectors * 32;
+		std::size_t         fourBytes = 0;
+		for (std::size_t vector = 0; vector < vectors;)
+		{
+			std::size_t end        = std::min<std::size_t>(vectors, vector + 255);
+			__m256i     contCounts = _mm256_setzero_si256();
+			__m256i     fourCounts = _mm256_setzero_si256();
+			for (; vector < end; ++vector)
+			{
+				// Matches are -1, continuation bytes are the signed bytes below -64
+				__m256i window = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + vector * 32));
+				contCounts     = _mm256_sub_epi8(contCounts, _mm256_cmpgt_epi8(_mm256_set1_epi8(-64), window));
+				if constexpr (To == EEncoding::UTF16)
+					fourCounts = _mm256_sub_epi8(fourCounts, _mm256_cmpeq_epi8(_mm256_max_epu8(window, _mm256_set1_epi8(static_cast<char>(0xF0))), window));
+			}
+			leaders -= SumBytes(contCounts);
+			if constexpr (To == EEncoding::UTF16)
+				fourBytes += SumBytes(fourCounts);
+		}
+
+		std::size_t tail = 0;
+		if constexpr (To == EEncoding::UTF16)
+			Generic::Length8To16(bytes + vectors * 32, inputSize - vectors * 32, tail);
+		else
+			Generic::Length8To32(bytes + vectors * 32, inputSize - vectors * 32, tail);
+		length = leaders + fourBytes + tail;
+		return EError::Success;
+	}
+
+	// 16 units at a time with the same counts as Generic, the compare masks hold two bits per unit.
+	template <EEncoding To>
+	static EError LengthFrom16(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		const std::uint8_t* bytes   = static_cast<const std::uint8_t*>(input);
+		std::size_t         vectors = inputSize / 32;
+		std::size_t         bits    = 0;
+		for (std::size_t vector = 0; vector < vectors; ++vector)
+		{
+			__m256i window = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + vector * 32));
+			if constexpr (To == EEncoding::UTF8)
+			{
+				// One byte per unit, one more from 0x80 and from 0x800 on, each surrogate takes one back so a pair adds up to 4
+				__m256i zero      = _mm256_setzero_si256();
+				__m256i masked    = _mm256_and_si256(window, _mm256_set1_epi16(static_cast<short>(0xF800)));
+				__m256i below80   = _mm256_cmpeq_epi16(_mm256_and_si256(window, _mm256_set1_epi16(static_cast<short>(0xFF80))), zero);
+				__m256i below800  = _mm256_cmpeq_epi16(masked, zero);
+				__m256i surrogate = _mm256_cmpeq_epi16(masked, _mm256_set1_epi16(static_cast<short>(0xD800)));
+				bits             += 96 - std::popcount(static_cast<std::uint32_t>(_mm256_movemask_epi8(below80))) - std::popcount(static_cast<std::uint32_t>(_mm256_movemask_epi8(below800))) - std::popcount(static_cast<std::uint32_t>(_mm256_movemask_epi8(surrogate)));
+			}
+			else
+			{
+				__m256i low  = _mm256_cmpeq_epi16(_mm256_and_si256(window, _mm256_set1_epi16(static_cast<short>(0xFC00))), _mm256_set1_epi16(static_cast<short>(0xDC00)));
+				bits        += 32 - std::popcount(static_cast<std::uint32_t>(_mm256_movemask_epi8(low)));
+			}
+		}
+
+		std::size_t tail = 0;
+		if constexpr (To == EEncoding::UTF8)
+			Generic::Length16To8(bytes + vectors * 32, inputSize - vectors * 32, tail);
+		else
+			Generic::Length16To32(bytes + vectors * 32, inputSize - vectors * 32, tail);
+		length = bits / 2 + tail;
+		return EError::Success;
+	}
+
+	// Unsigned compares, so that units past U+10FFFF count the same as on Generic
+	template <EEncoding To>
+	static EError LengthFrom32(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		const std::uint8_t* bytes   = static_cast<const std::uint8_t*>(input);
+		std::size_t         vectors = inputSize / 32;
+		std::size_t         size    = vectors * 8;
+		for (std::size_t vector = 0; vector < vectors; ++vector)
+		{
+			__m256i window        = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + vector * 32));
+			__m256i supplementary = _mm256_cmpeq_epi32(_mm256_max_epu32(window, _mm256_set1_epi32(0x1'0000)), window);
+			size                 += std::popcount(static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(supplementary))));
+			if constexpr (To == EEncoding::UTF8)
+			{
+				__m256i ge80  = _mm256_cmpeq_epi32(_mm256_max_epu32(window, _mm256_set1_epi32(0x80)), window);
+				__m256i ge800 = _mm256_cmpeq_epi32(_mm256_max_epu32(window, _mm256_set1_epi32(0x800)), window);
+				size         += std::popcount(static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(ge80)))) + std::popcount(static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(ge800))));
+			}
+		}
+
+		std::size_t tail = 0;
+		if constexpr (To == EEncoding::UTF8)
+			Generic::Length32To8(bytes + vectors * 32, inputSize - vectors * 32, tail);
+		else
+			Generic::Length32To16(bytes + vectors * 32, inputSize - vectors * 32, tail);
+		length = size + tail;
+		return EError::Success;
+	}
+
+	// Every byte from 0x80 on takes one more byte in UTF-8, those are the sign bits
+	static EError LengthLatin1To8AVX2(const void* input, std::size_t inputSize, std::size_t& length)
+	{
+		const std::uint8_t* bytes   = static_cast<const std::uint8_t*>(input);
+		std::size_t         vectors = inputSize / 32;
+		std::size_t         size    = vectors * 32;
+		for (std::size_t vector = 0; vector < vectors; ++vector)
+			size += std::popcount(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + vector * 32)))));
+
+		std::size_t tail = 0;
+		Generic::LengthLatin1To8(bytes + vectors * 32, inputSize - vectors * 32, tail);
+		length = size + tail;
+		return EError::Success;
+	}
+
+	template <EEncoding To>
+	static EError ConvBlockFrom8(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize = 0;
+		if (inputSize == 0)
+			return EError::Success;
+
+		// Up to 3 continuation bytes belong to a sequence started in the previous block
+		std::size_t start = 0;
+		while (start < 3 && start < inputSize && (input.Bytes[start] & 0xC0) == 0x80)
+			++start;
+
+		std::uint64_t carry   = 0;
+		std::uint64_t afterE0 = 0;
+		std::uint64_t afterED = 0;
+		std::uint64_t afterF0 = 0;
+		std::uint64_t afterF4 = 0;
+		for (std::size_t window = 0; window < inputSize; window += 64)
+		{
+			UTF8Masks     masks = ClassifyUTF8(input.Bytes + window);
+			std::uint64_t range = RangeMask(start > window ? start - window : 0, inputSize - window);
+			std::uint64_t cont  = masks.High & ~masks.Ge2;
+			std::uint64_t ge2   = masks.Ge2 & range;
+			std::uint64_t ge3   = masks.Ge3 & range;
+			std::uint64_t ge4   = masks.Ge4 & range;
+			std::uint64_t e0    = masks.E0 & range;
+			std::uint64_t ed    = masks.ED & range;
+			std::uint64_t f0    = masks.F0 & range;
+			std::uint64_t f4    = masks.F4 & range;
+
+			// Every leading byte requires the following bytes to be continuations, any other continuation is stray. After E0 the first
+			// of them also has to be from 0xA0 on and after F0 from 0x90 on, or the sequence is overlong. After ED it has to be below 0xA0,
+			// or it is a surrogate, after F4 below 0x90, or it is past U+10FFFF.
+			std::uint64_t required   = carry | ge2 << 1 | ge3 << 2 | ge4 << 3;
+			std::uint64_t fromA0     = afterE0 | e0 << 1;
+			std::uint64_t belowA0    = afterED | ed << 1;
+			std::uint64_t from90     = afterF0 | f0 << 1;
+			std::uint64_t below90    = afterF4 | f4 << 1;
+			std::uint64_t leadErrors = (masks.Bad & range) | (cont & range & ~required);
+			std::uint64_t contErrors = (required & ~cont) | (fromA0 & ~masks.GeA0) | (belowA0 & masks.GeA0) | (from90 & ~masks.Ge90) | (below90 & masks.Ge90);
+			carry                    = ge2 >> 63 | ge3 >> 62 | ge4 >> 61;
+			afterE0                  = e0 >> 63;
+			afterED                  = ed >> 63;
+			afterF0                  = f0 >> 63;
+			afterF4                  = f4 >> 63;
+			if (carry && window + 64 >= inputSize)
+			{
+				// The last sequences continue past the input, into the padding of the block
+				std::uint64_t nextCont = 0;
+				std::uint64_t nextGe90 = 0;
+				std::uint64_t nextGeA0 = 0;
+				if (window + 64 < sizeof(InputBlock))
+				{
+					UTF8Masks next = ClassifyUTF8(input.Bytes + window + 64);
+					nextCont       = next.High & ~next.Ge2;
+					nextGe90       = next.Ge90;
+					nextGeA0       = next.GeA0;
+				}
+				if ((carry & ~nextCont) | (afterE0 & ~nextGeA0) | (afterED & nextGeA0) | (afterF0 & ~nextGe90) | (afterF4 & nextGe90))
+					contErrors |= 1ULL << 63;
+			}
+			if (leadErrors | contErrors)
+				return std::countr_zero(leadErrors) < std::countr_zero(contErrors) ? EError::InvalidLeading : EError::InvalidContinuation;
+			if (window + 64 >= inputSize)
+			{
+				// The next block skips the continuation bytes at its start, any past the last sequence here are stray
+				std::size_t next = inputSize + std::popcount(required & ~RangeMask(0, inputSize - window)) + std::popcount(carry);
+				if (next < sizeof(InputBlock) && (input.Bytes[next] & 0xC0) == 0x80)
+					return EError::InvalidLeading;
+			}
+
+			std::uint64_t leaders = range & ~cont;
+			for (std::size_t group = 0; group < 64 && window + group < inputSize; group += 8)
+			{
+				const std::uint8_t* bytes = input.Bytes + window + group;
+
+				// Whole runs of ASCII are widened without decoding
+				if ((group & 31) == 0 &&
+					window + group + 32 <= inputSize &&
+					((masks.High >> group) & 0xFFFF'FFFF) == 0)
+				{
+					__m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+					__m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 16));
+					if constexpr (To == EEncoding::UTF16)
+					{
+						StoreOutput(output, outputSize, _mm256_cvtepu8_epi16(lo), 32);
+						StoreOutput(output, outputSize + 32, _mm256_cvtepu8_epi16(hi), 32);
+						outputSize += 64;
+					}
+					else
+					{
+						StoreOutput(output, outputSize, _mm256_cvtepu8_epi32(lo), 32);
+						StoreOutput(output, outputSize + 32, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)), 32);
+						StoreOutput(output, outputSize + 64, _mm256_cvtepu8_epi32(hi), 32);
+						StoreOutput(output, outputSize + 96, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)), 32);
+						outputSize += 128;
+					}
+					group += 24;
+					continue;
+				}
+
+				std::uint32_t groupLeaders = static_cast<std::uint32_t>(leaders >> group) & 0xFF;
+				if (!groupLeaders)
+					continue;
+
+				// The lanes of the very last group would read past the end of the block
+				alignas(16) std::uint8_t tail[16] {};
+				if (window + group + 16 > sizeof(InputBlock))
+				{
+					std::memcpy(tail, bytes, sizeof(InputBlock) - window - group);
+					bytes = tail;
+				}
+
+				std::uint32_t count      = std::popcount(groupLeaders);
+				__m256i       codepoints = PackDWords(DecodeUTF8Lanes(bytes), groupLeaders);
+				if constexpr (To == EEncoding::UTF16)
+				{
+					outputSize += StoreUTF16(output, outputSize, codepoints, count, (ge4 >> group) & groupLeaders);
+				}
+				else
+				{
+					StoreOutput(output, outputSize, codepoints, count * 4);
+					outputSize += count * 4;
+				}
+			}
+		}
+		return EError::Success;
+	}
+
+	template <EEncoding To>
+	static EError ConvBlockFrom16(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize = 0;
+
+		std::uint64_t high, low;
+		ClassifyUTF16(input, high, low);
+
+		// A low surrogate at the start belongs to a pair started in the previous block
+		std::size_t   units    = (inputSize + 1) / 2;
+		std::uint64_t range    = RangeMask(low & 1, units);
+		std::uint64_t leaders  = high & range;
+		std::uint64_t required = leaders << 1;
+		if ((required & ~low) || (leaders >> 63))
+			return EError::InvalidContinuation;
+		if (low & range & ~required)
+			return EError::InvalidLeading;
+
+		// Same for a low surrogate at the start of the next block
+		std::size_t next = units < 64 ? units + ((required >> units) & 1) : 64;
+		if (inputSize && next < 64 && ((low >> next) & 1))
+			return EError::InvalidLeading;
+
+		std::uint64_t keep = range & ~low;
+		for (std::size_t group = 0; group < units; group += 8)
+		{
+			const std::uint8_t* bytes = input.Bytes + group * 2;
+
+			if constexpr (To == EEncoding::UTF8)
+			{
+				// Whole runs of ASCII are narrowed without encoding
+				if (group + 16 <= units && ((keep >> group) & 0xFFFF) == 0xFFFF)
+				{
+					__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));
+					if (_mm256_testz_si256(chunk, _mm256_set1_epi16(static_cast<short>(0xFF80))))
+					{
+						__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(chunk, chunk), 0b00'00'10'00);
+						StoreOutput(output, outputSize, _mm256_castsi256_si128(packed), 16);
+						outputSize += 16;
+						group      += 8;
+						continue;
+					}
+				}
+			}
+
+			std::uint32_t groupKeep  = static_cast<std::uint32_t>(keep >> group) & 0xFF;
+			std::uint32_t count      = std::popcount(groupKeep);
+			__m256i       codepoints = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)));
+			if ((leaders >> group) & 0xFF)
+			{
+				// Combine each high surrogate with the unit after it, the low surrogate lanes get dropped
+				std::uint16_t nextUnit = 0;
+				if (group + 8 < 64)
+					std::memcpy(&nextUnit, bytes + 16, sizeof(nextUnit));
+				__m256i next   = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(codepoints, _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 7)), _mm256_set1_epi32(nextUnit), 0x80);
+				__m256i pairs  = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(codepoints, 10), next), _mm256_set1_epi32(0x1'0000 - (0xD800 << 10) - 0xDC00));
+				__m256i isHigh = _mm256_cmpeq_epi32(_mm256_and_si256(codepoints, _mm256_set1_epi32(0xFC00)), _mm256_set1_epi32(0xD800));
+				codepoints     = _mm256_blendv_epi8(codepoints, pairs, isHigh);
+			}
+			if (groupKeep & (groupKeep + 1))
+				codepoints = PackDWords(codepoints, groupKeep);
+			if (!count)
+				continue;
+
+			if constexpr (To == EEncoding::UTF8)
+			{
+				outputSize += StoreUTF8(output, outputSize, codepoints, count);
+			}
+			else
+			{
+				StoreOutput(output, outputSize, codepoints, count * 4);
+				outputSize += count * 4;
+			}
+		}
+		return EError::Success;
+	}
+
+	template <EEncoding To>
+	static EError ConvBlockFrom32(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize = 0;
+
+		std::size_t units = (inputSize + 3) / 4;
+		for (std::size_t group = 0; group < units; group += 8)
+		{
+			std::uint32_t count      = static_cast<std::uint32_t>(std::min<std::size_t>(units - group, 8));
+			__m256i       codepoints = FirstLanes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + group * 4)), count);
+			if (InvalidCodepoints(codepoints))
+				return EError::OOB;
+
+			if constexpr (To == EEncoding::UTF8)
+			{
+				outputSize += StoreUTF8(output, outputSize, codepoints, count);
+			}
+			else
+			{
+				__m256i isSupplementary = _mm256_cmpgt_epi32(codepoints, _mm256_set1_epi32(0xFFFF));
+				outputSize             += StoreUTF16(output, outputSize, codepoints, count, !_mm256_testz_si256(isSupplementary, isSupplementary));
+			}
+		}
+		return EError::Success;
+	}
+
+	// Loads a vector of W units worth of N units, zero extended into the lanes of W units
+	template <class N, class W>
+	static __m256i LoadWidened(const N* units)
+	{
+		if constexpr (sizeof(N) == 1 && sizeof(W) == 2)
+			return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(units)));
+		else if constexpr (sizeof(N) == 1)
+			return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(units)));
+		else
+			return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(units)));
+	}
+
+	// Latin-1 past ASCII takes two bytes, 8 bytes at a time are widened into dword lanes and packed with the UTF-8 shuffles.
+	static EError ConvBlockLatin1To8AVX2(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize = 0;
+		for (std::size_t offset = 0; offset < inputSize;)
+		{
+			if (offset + 32 <= inputSize)
+			{
+				__m256i window = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + offset));
+				if (_mm256_movemask_epi8(window) == 0)
+				{
+					StoreOutput(output, outputSize, window, 32);
+					outputSize += 32;
+					offset     += 32;
+					continue;
+				}
+			}
+
+			std::uint32_t count = static_cast<std::uint32_t>(std::min<std::size_t>(inputSize - offset, 8));
+			__m128i       bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input.Bytes + offset));
+			offset             += count;
+			if ((_mm_movemask_epi8(bytes) & ((1U << count) - 1)) == 0)
+			{
+				StoreOutput(output, outputSize, bytes, count);
+				outputSize += count;
+				continue;
+			}
+
+			// 110000xx 10xxxxxx with the leading byte in the low byte, lanes past count are zero and take a byte each at the end
+			__m256i units = FirstLanes(_mm256_cvtepu8_epi32(bytes), count);
+			__m256i isTwo = _mm256_cmpgt_epi32(units, _mm256_set1_epi32(0x7F));
+			__m256i two   = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(units, 6), _mm256_set1_epi32(0x80C0)), _mm256_slli_epi32(_mm256_and_si256(units, _mm256_set1_epi32(0x3F)), 8));
+			units         = _mm256_blendv_epi8(units, two, isTwo);
+
+			// The lengths of PackUTF8Shuffles take 2 bits a lane, spread from the bit of every lane that takes two bytes
+			std::uint32_t twoBits = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(isTwo)));
+			std::uint32_t indexLo = twoBits & 0x0F;
+			std::uint32_t indexHi = twoBits >> 4;
+			indexLo               = (indexLo | indexLo << 2) & 0x33;
+			indexHi               = (indexHi | indexHi << 2) & 0x33;
+			indexLo               = (indexLo | indexLo << 1) & 0x55;
+			indexHi               = (indexHi | indexHi << 1) & 0x55;
+
+			__m128i     lo     = _mm_shuffle_epi8(_mm256_castsi256_si128(units), _mm_load_si128(reinterpret_cast<const __m128i*>(LUTs::PackUTF8Shuffles[indexLo].data())));
+			std::size_t loSize = LUTs::PackUTF8Lengths[indexLo];
+			if (count <= 4)
+			{
+				StoreOutput(output, outputSize, lo, loSize - (4 - count));
+				outputSize += loSize - (4 - count);
+				continue;
+			}
+			__m128i     hi     = _mm_shuffle_epi8(_mm256_extracti128_si256(units, 1), _mm_load_si128(reinterpret_cast<const __m128i*>(LUTs::PackUTF8Shuffles[indexHi].data())));
+			std::size_t hiSize = LUTs::PackUTF8Lengths[indexHi] - (8 - count);
+			StoreOutput(output, outputSize, lo, loSize);
+			StoreOutput(output, outputSize + loSize, hi, hiSize);
+			outputSize += loSize + hiSize;
+		}
+		return EError::Success;
+	}
+
+	// Same leading bytes as Generic::ConvBlock8ToLatin1, checked on the masks of the whole block. Every leading byte is merged with
+	// the byte after it, then the continuation bytes are dropped 8 bytes at a time with the shuffles that left pack dword lanes.
+	static EError ConvBlock8ToLatin1AVX2(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		outputSize = 0;
+		if (inputSize == 0)
+			return EError::Success;
+
+		alignas(32) std::uint8_t values[64];
+		std::uint64_t            high  = 0;
+		std::uint64_t            ge2   = 0;
+		std::uint64_t            leads = 0;
+		for (std::size_t half = 0; half < 2; ++half)
+		{
+			__m256i bytes  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + half * 32));
+			__m256i next   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + half * 32 + 1));
+			__m256i isLead = _mm256_cmpeq_epi8(_mm256_and_si256(bytes, _mm256_set1_epi8(static_cast<char>(0xFE))), _mm256_set1_epi8(static_cast<char>(0xC2)));
+			// The word shift moves the low bits of a byte into the top of the one above, the mask drops what came from below
+			__m256i merged = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(bytes, 6), _mm256_set1_epi8(static_cast<char>(0xC0))), _mm256_and_si256(next, _mm256_set1_epi8(0x3F)));
+			_mm256_store_si256(reinterpret_cast<__m256i*>(values + half * 32), _mm256_blendv_epi8(bytes, merged, isLead));
+
+			std::uint32_t halfHigh  = static_cast<std::uint32_t>(_mm256_movemask_epi8(bytes));
+			high                   |= static_cast<std::uint64_t>(halfHigh) << (half * 32);
+			ge2                    |= static_cast<std::uint64_t>(halfHigh & static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(static_cast<char>(0xBF)))))) << (half * 32);
+			leads                  |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(isLead))) << (half * 32);
+		}
+
+		// Up to 3 continuation bytes belong to a sequence started in the previous block
+		std::uint64_t range = RangeMask(0, inputSize);
+		std::uint64_t conts = high & ~ge2 & range;
+		std::size_t   skip  = std::min<std::size_t>(std::countr_one(conts), 3);
+		conts              &= ~0ULL << skip;
+		if ((ge2 & range) != (leads & range))
+			return EError::InvalidLeading;
+		if (conts != (leads << 1 & range))
+			return EError::InvalidContinuation;
+		// The byte after the block continues the last sequence here, otherwise it can't be a continuation byte
+		bool lastLead = (leads >> (inputSize - 1) & 1) && inputSize > skip;
+		if (lastLead != ((input.Bytes[inputSize] & 0xC0) == 0x80))
+			return lastLead ? EError::InvalidContinuation : EError::InvalidLeading;
+
+		std::uint64_t keep = range & ~conts & (~0ULL << skip);
+		for (std::size_t group = 0; group < 8 && group * 8 < inputSize; ++group)
+		{
+			std::uint32_t groupKeep = static_cast<std::uint32_t>(keep >> (group * 8) & 0xFF);
+			__m128i       packed    = _mm_shuffle_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values + group * 8)), _mm_cvtsi64_si128(static_cast<long long>(LUTs::PackDWordIndices[groupKeep])));
+			StoreOutput(output, outputSize, packed, 8);
+			outputSize += std::popcount(groupKeep);
+		}
+		return EError::Success;
+	}
+
+	// Same conversions as Generic::ConvBlockLatin1To16 and the others. The units of the whole block are checked against Limit at once,
+	// the ones past it belong to the next block. Narrowing packs with unsigned saturation, which keeps every unit below 0x100 as it is.
+	template <class In, class Out, char32_t Limit, EError Error>
+	static EError ConvBlockUnits(const InputBlock& input, OutputBlock& output, std::size_t inputSize, std::size_t& outputSize)
+	{
+		constexpr std::uint64_t c_Over  = Details::c_LimitBits<sizeof(In), Limit>;
+		constexpr std::size_t   c_Chunk = sizeof(In) < sizeof(Out) ? 32 * sizeof(In) / sizeof(Out) : 32;
+
+		std::size_t size = (inputSize + sizeof(In) - 1) / sizeof(In) * sizeof(In);
+		outputSize       = 0;
+		if constexpr (c_Over != 0)
+		{
+			__m256i       over  = _mm256_set1_epi64x(static_cast<long long>(c_Over));
+			__m256i       lo    = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes)), over);
+			__m256i       hi    = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + 32)), over);
+			std::uint64_t clear = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, _mm256_setzero_si256()))) |
+								  static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, _mm256_setzero_si256())))) << 32;
+			if (~clear & RangeMask(0, size))
+				return Error;
+		}
+		// Same checks of the unit after the block as Generic::ConvBlockUnits
+		if constexpr (sizeof(In) == 1 && Limit == 0x80)
+		{
+			if (inputSize && input.Bytes[inputSize] >= 0x80)
+				return Error;
+		}
+		if constexpr (sizeof(In) == 2)
+		{
+			if (inputSize && (reinterpret_cast<const char16_t*>(input.Bytes)[size / 2] & 0xFC00) == 0xDC00)
+				return Error;
+		}
+
+		for (std::size_t offset = 0; offset < size; offset += c_Chunk)
+		{
+			std::size_t at = offset / sizeof(In) * sizeof(Out);
+			if constexpr (sizeof(In) == sizeof(Out))
+			{
+				StoreOutput(output, at, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + offset)), 32);
+			}
+			else if constexpr (sizeof(In) < sizeof(Out))
+			{
+				StoreOutput(output, at, LoadWidened<In, Out>(reinterpret_cast<const In*>(input.Bytes + offset)), 32);
+			}
+			else if constexpr (sizeof(In) == 2)
+			{
+				__m256i units = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + offset));
+				__m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(units, units), 0b00'00'10'00);
+				StoreOutput(output, at, _mm256_castsi256_si128(bytes), 16);
+			}
+			else
+			{
+				__m256i units = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.Bytes + offset));
+				__m256i bytes = _mm256_packus_epi16(_mm256_packus_epi32(units, units), _mm256_setzero_si256());
+				bytes         = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1));
+				StoreOutput(output, at, _mm256_castsi256_si128(bytes), 8);
+			}
+		}
+		outputSize = size / sizeof(In) * sizeof(Out);
+		return EError::Success;
+	}
+
+	// Three nibble check, every bit is one kind of error and only shows up when the lookups by the high and low nibble of the previous
+	// byte and the high nibble of the current byte all agree on it. This covers overlong encodings, surrogates and codepoints past U+10FFFF.
+	static constexpr std::uint8_t c_TooShort   = 1 << 0; // Leading byte followed by ASCII or another leading byte
+	static constexpr std::uint8_t c_TooLong    = 1 << 1; // ASCII followed by a continuation byte
+	static constexpr std::uint8_t c_Overlong3  = 1 << 2; // E0 80..9F
+	static constexpr std::uint8_t c_TooLarge   = 1 << 3; // F4 90..BF, F5..FF 90..BF
+	static constexpr std::uint8_t c_Surrogate  = 1 << 4; // ED A0..BF
+	static constexpr std::uint8_t c_Overlong2  = 1 << 5; // C0..C1
+	static constexpr std::uint8_t c_TooLarge80 = 1 << 6; // F5..FF 80..8F
+	static constexpr std::uint8_t c_Overlong4  = 1 << 6; // F0 80..8F
+	static constexpr std::uint8_t c_TwoConts   = 1 << 7; // Two continuation bytes, only valid as the 2nd and 3rd or 3rd and 4th byte of a sequence
+	static constexpr std::uint8_t c_Carry      = c_TooShort | c_TooLong | c_TwoConts;
+
+	alignas(16) static constexpr std::uint8_t c_Byte1High[16] = {
+		c_TooLong, c_TooLong, c_TooLong, c_TooLong, c_TooLong, c_TooLong, c_TooLong, c_TooLong,
+		c_TwoConts, c_TwoConts, c_TwoConts, c_TwoConts,
+		c_TooShort | c_Overlong2,
+		c_TooShort,
+		c_TooShort | c_Overlong3 | c_Surrogate,
+		c_TooShort | c_TooLarge | c_TooLarge80 | c_Overlong4
+	};
+	alignas(16) static constexpr std::uint8_t c_Byte1Low[16] = {
+		c_Carry | c_Overlong3 | c_Overlong2 | c_Overlong4,
+		c_Carry | c_Overlong2,
+		c_Carry,
+		c_Carry,
+		c_Carry | c_TooLarge,
+		c_Carry | c_TooLarge | c_TooLarge80,
+		c_Carry | c_TooLarge | c_TooLarge80,
+		c_Carry | c_TooLarge | c_TooLarge80,
+		c_Carry | c_TooLarge | c_TooLarge80,
+		c_Carry | c_TooLarge | c_TooLarge80,
+		c_Carry | c_TooLarge | c_TooLarge80,
+		c_Carry | c_TooLarge | c_TooLarge80,
+		c_Carry | c_TooLarge | c_TooLarge80,
+		c_Carry | c_TooLarge | c_TooLarge80 | c_Surrogate,
+		c_Carry | c_TooLarge | c_TooLarge80,
+		c_Carry | c_TooLarge | c_TooLarge80
+	};
+	alignas(16) static constexpr std::uint8_t c_Byte2High[16] = {
+		c_TooShort, c_TooShort, c_TooShort, c_TooShort, c_TooShort, c_TooShort, c_TooShort, c_TooShort,
+		c_TooLong | c_Overlong2 | c_TwoConts | c_Overlong3 | c_TooLarge80 | c_Overlong4,
+		c_TooLong | c_Overlong2 | c_TwoConts | c_Overlong3 | c_TooLarge,
+		c_TooLong | c_Overlong2 | c_TwoConts | c_Surrogate | c_TooLarge,
+		c_TooLong | c_Overlong2 | c_TwoConts | c_Surrogate | c_TooLarge,
+		c_TooShort, c_TooShort, c_TooShort, c_TooShort
+	};
+
+	static __m256i LoadNibbleTable(const std::uint8_t (&table)[16])
+	{
+		return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+	}
+
+	// Error bits of the 32 bytes in input, prev holds the 32 bytes before them
+	static __m256i UTF8Errors(__m256i input, __m256i prev)
+	{
+		const __m256i c_LowNibble = _mm256_set1_epi8(0x0F);
+
+		__m256i shifted   = _mm256_permute2x128_si256(prev, input, 0x21);
+		__m256i prev1     = _mm256_alignr_epi8(input, shifted, 15);
+		__m256i prev2     = _mm256_alignr_epi8(input, shifted, 14);
+		__m256i prev3     = _mm256_alignr_epi8(input, shifted, 13);
+		__m256i byte1High = _mm256_shuffle_epi8(LoadNibbleTable(c_Byte1High), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), c_LowNibble));
+		__m256i byte1Low  = _mm256_shuffle_epi8(LoadNibbleTable(c_Byte1Low), _mm256_and_si256(prev1, c_LowNibble));
+		__m256i byte2High = _mm256_shuffle_epi8(LoadNibbleTable(c_Byte2High), _mm256_and_si256(_mm256_srli_epi16(input, 4), c_LowNibble));
+		__m256i special   = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+		// Bytes two after a leading byte of 3 or more, or three after one of 4, are the continuation bytes c_TwoConts expects
+		__m256i third  = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+		__m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+		__m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+		return _mm256_xor_si256(must23, special);
+	}
+
+	// Non zero for bytes in the last three that start a sequence which does not end before the vector does
+	static __m256i UTF8Incomplete(__m256i input)
+	{
+		const __m256i c_Max = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xEF), static_cast<char>(0xDF), static_cast<char>(0xBF));
+		return _mm256_subs_epu8(input, c_Max);
+	}
+
+	// Checks 64 bytes at a time and stops at the first window with an error, the Generic check then finds where it is.
+	static EError ValidateUTF8(const void* input, std::size_t inputSize, std::size_t& errorOffset)
+	{
+		const std::uint8_t* bytes  = static_cast<const std::uint8_t*>(input);
+		__m256i             prev   = _mm256_setzero_si256();
+		__m256i             errors = _mm256_setzero_si256();
+		std::size_t         offset = 0;
+		for (; offset + 64 <= inputSize; offset += 64)
+		{
+			__m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + offset));
+			__m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + offset + 32));
+			if (_mm256_movemask_epi8(_mm256_or_si256(lo, hi)) == 0)
+			{
+				// ASCII cannot continue a sequence left open by the previous window
+				errors = _mm256_or_si256(errors, UTF8Incomplete(prev));
+			}
+			else
+			{
+				errors = _mm256_or_si256(errors, UTF8Errors(lo, prev));
+				errors = _mm256_or_si256(errors, UTF8Errors(hi, lo));
+			}
+			prev = hi;
+			if (!_mm256_testz_si256(errors, errors))
+				break;
+		}
+
+		// The rest is checked from the leading byte of a sequence the last window may have left open
+		std::size_t start = offset;
+		for (std::size_t back = 1; back <= 3 && back <= offset; ++back)
+		{
+			std::uint8_t byte = bytes[offset - back];
+			if ((byte & 0xC0) == 0x80)
+				continue;
+			if (byte >= 0xC0)
+				start = offset - back;
+			break;
+		}
+		EError error  = Generic::Validate8(bytes + start, inputSize - start, errorOffset);
+		errorOffset  += start;
+		return error;
+	}
+
+	static EError ValidateAsciiAVX2(const void* input, std::size_t inputSize, std::size_t& errorOffset)
+	{
+		const std::uint8_t* bytes  = static_cast<const std::uint8_t*>(input);
+		std::size_t         offset = 0;
+		for (; offset + 32 <= inputSize; offset += 32)
+		{
+			if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + offset))) != 0)
+				break;
+		}
+
+		// Generic finds the byte in the window that stopped the loop
+		EError error  = Generic::ValidateAscii(bytes + offset, inputSize - offset, errorOffset);
+		errorOffset  += offset;
+		return error;
+	}
+
+	// Multiplies the 64 bit lanes by a 32 bit constant, AVX2 only multiplies 32 bit halves
+	static __m256i MulLanes(__m256i lanes, std::uint64_t factor)
+	{
+		__m256i multiplier = _mm256_set1_epi64x(static_cast<long long>(factor));
+		__m256i high       = _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(lanes, 32), multiplier), 32);
+		return _mm256_add_epi64(_mm256_mul_epu32(lanes, multiplier), high);
+	}
+
+	// The 8 lanes are two vectors, a stripe is two loads
+	static EError HashStripesAVX2(std::uint64_t* lanes, const char32_t* codepoints, std::size_t stripes, std::size_t& round)
+	{
+		__m256i low  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+		__m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes + 4));
+		for (std::size_t stripe = 0; stripe < stripes; ++stripe)
+		{
+			__m256i lowWords   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codepoints + stripe * 16));
+			__m256i highWords  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codepoints + stripe * 16 + 8));
+			__m256i lowKeyed   = _mm256_xor_si256(lowWords, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(LUTs::HashKeys + round)));
+			__m256i highKeyed  = _mm256_xor_si256(highWords, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(LUTs::HashKeys + round + 4)));
+			low                = _mm256_add_epi64(low, _mm256_add_epi64(_mm256_mul_epu32(lowKeyed, _mm256_srli_epi64(lowKeyed, 32)), lowWords));
+			high               = _mm256_add_epi64(high, _mm256_add_epi64(_mm256_mul_epu32(highKeyed, _mm256_srli_epi64(highKeyed, 32)), highWords));
+			if (++round == LUTs::HashRoundStripes)
+			{
+				low   = _mm256_xor_si256(_mm256_xor_si256(low, _mm256_srli_epi64(low, 47)), _mm256_load_si256(reinterpret_cast<const __m256i*>(LUTs::HashKeys + LUTs::HashRoundStripes)));
+				high  = _mm256_xor_si256(_mm256_xor_si256(high, _mm256_srli_epi64(high, 47)), _mm256_load_si256(reinterpret_cast<const __m256i*>(LUTs::HashKeys + LUTs::HashRoundStripes + 4)));
+				low   = MulLanes(low, LUTs::HashPrime);
+				high  = MulLanes(high, LUTs::HashPrime);
+				round = 0;
+			}
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), low);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + 4), high);
+		return EError::Success;
+	}
+
+	// Widened narrow units past ASCII keep their high bits, so only they need checking, wide units that differ from them fail the compare anyway
+	template <class N, class W>
+	static EError AsciiMatchAVX2(const void* narrow, const void* wide, std::size_t size, std::size_t& matched, EError (*rest)(const void*, const void*, std::size_t, std::size_t&))
+	{
+		constexpr std::size_t c_Step = sizeof(__m256i) / sizeof(W);
+
+		const N* narrowBuf = static_cast<const N*>(narrow);
+		const W* wideBuf   = static_cast<const W*>(wide);
+		__m256i  nonAscii  = sizeof(W) == 2 ? _mm256_set1_epi16(static_cast<short>(0xFF80)) : _mm256_set1_epi32(static_cast<int>(0xFFFF'FF80));
+		for (matched = 0; matched + c_Step <= size; matched += c_Step)
+		{
+			__m256i widened = LoadWidened<N, W>(narrowBuf + matched);
+			__m256i units   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(wideBuf + matched));
+			__m256i errors  = _mm256_or_si256(_mm256_xor_si256(widened, units), _mm256_and_si256(widened, nonAscii));
+			if (!_mm256_testz_si256(errors, errors))
+				break;
+		}
+		std::size_t tail  = 0;
+		EError      error = rest(narrowBuf + matched, wideBuf + matched, size - matched, tail);
+		matched          += tail;
+		return error;
+	}
+#endif
+
 	EError CalcReqSize8To16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeFrom8<EEncoding::UTF16>(input, inputSize, requiredSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError CalcReqSize8To32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeFrom8<EEncoding::UTF32>(input, inputSize, requiredSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError CalcReqSize16To8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeFrom16<EEncoding::UTF8>(input, inputSize, requiredSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError CalcReqSize16To32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeFrom16<EEncoding::UTF32>(input, inputSize, requiredSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError CalcReqSize32To8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeFrom32<EEncoding::UTF8>(input, inputSize, requiredSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError CalcReqSize32To16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeFrom32<EEncoding::UTF16>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSizeLatin1To8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return LengthLatin1To8AVX2(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSize8ToLatin1([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSize8ToLatin1AVX2(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSizeAsciiTo8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<std::uint8_t, std::uint8_t, 0x80, EError::InvalidLeading>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSizeLatin1ToAscii([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<std::uint8_t, std::uint8_t, 0x80, EError::OOB>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSizeLatin1To16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<std::uint8_t, char16_t, 0x100, EError::Success>(input, inputSize, requiredSize);
+#else
 		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSizeLatin1To32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<std::uint8_t, char32_t, 0x100, EError::Success>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSizeAsciiTo16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<std::uint8_t, char16_t, 0x80, EError::InvalidLeading>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSizeAsciiTo32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<std::uint8_t, char32_t, 0x80, EError::InvalidLeading>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSize16ToLatin1([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<char16_t, std::uint8_t, 0x100, EError::OOB>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSize16ToAscii([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<char16_t, std::uint8_t, 0x80, EError::OOB>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSize32ToLatin1([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<char32_t, std::uint8_t, 0x100, EError::OOB>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError CalcReqSize32ToAscii([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& requiredSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return CalcReqSizeUnits<char32_t, std::uint8_t, 0x80, EError::OOB>(input, inputSize, requiredSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError Length8To16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& length)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return LengthFrom8<EEncoding::UTF16>(input, inputSize, length);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError Length8To32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& length)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return LengthFrom8<EEncoding::UTF32>(input, inputSize, length);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError Length16To8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& length)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return LengthFrom16<EEncoding::UTF8>(input, inputSize, length);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError Length16To32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& length)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return LengthFrom16<EEncoding::UTF32>(input, inputSize, length);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError Length32To8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& length)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return LengthFrom32<EEncoding::UTF8>(input, inputSize, length);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError Length32To16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& length)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return LengthFrom32<EEncoding::UTF16>(input, inputSize, length);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError LengthLatin1To8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& length)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return LengthLatin1To8AVX2(input, inputSize, length);
+#else
+		return EError::MissingImpl;
+#endif
 	}
 
 	EError ConvBlock8To16([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockFrom8<EEncoding::UTF16>(input, output, inputSize, outputSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError ConvBlock8To32([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockFrom8<EEncoding::UTF32>(input, output, inputSize, outputSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError ConvBlock16To8([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockFrom16<EEncoding::UTF8>(input, output, inputSize, outputSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError ConvBlock16To32([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockFrom16<EEncoding::UTF32>(input, output, inputSize, outputSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError ConvBlock32To8([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockFrom32<EEncoding::UTF8>(input, output, inputSize, outputSize);
+#else
 		return EError::MissingImpl;
+#endif
 	}
 
 	EError ConvBlock32To16([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
 	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockFrom32<EEncoding::UTF16>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlockLatin1To8([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockLatin1To8AVX2(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlock8ToLatin1([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlock8ToLatin1AVX2(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlockAsciiTo8([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<std::uint8_t, std::uint8_t, 0x80, EError::InvalidLeading>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlockLatin1ToAscii([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<std::uint8_t, std::uint8_t, 0x80, EError::OOB>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlockLatin1To16([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<std::uint8_t, char16_t, 0x100, EError::Success>(input, output, inputSize, outputSize);
+#else
 		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlockLatin1To32([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<std::uint8_t, char32_t, 0x100, EError::Success>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlockAsciiTo16([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<std::uint8_t, char16_t, 0x80, EError::InvalidLeading>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlockAsciiTo32([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<std::uint8_t, char32_t, 0x80, EError::InvalidLeading>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlock16ToLatin1([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<char16_t, std::uint8_t, 0x100, EError::OOB>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlock16ToAscii([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<char16_t, std::uint8_t, 0x80, EError::OOB>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlock32ToLatin1([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<char32_t, std::uint8_t, 0x100, EError::OOB>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBlock32ToAscii([[maybe_unused]] const InputBlock& input, [[maybe_unused]] OutputBlock& output, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ConvBlockUnits<char32_t, std::uint8_t, 0x80, EError::OOB>(input, output, inputSize, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer8To16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockFrom8<EEncoding::UTF16>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer8To32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockFrom8<EEncoding::UTF32>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer16To8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockFrom16<EEncoding::UTF8>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer16To32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockFrom16<EEncoding::UTF32>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer32To8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockFrom32<EEncoding::UTF8>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer32To16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockFrom32<EEncoding::UTF16>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBufferLatin1To8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockLatin1To8AVX2>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer8ToLatin1([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlock8ToLatin1AVX2>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBufferAsciiTo8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<std::uint8_t, std::uint8_t, 0x80, EError::InvalidLeading>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBufferLatin1ToAscii([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<std::uint8_t, std::uint8_t, 0x80, EError::OOB>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBufferLatin1To16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<std::uint8_t, char16_t, 0x100, EError::Success>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBufferLatin1To32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<std::uint8_t, char32_t, 0x100, EError::Success>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBufferAsciiTo16([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<std::uint8_t, char16_t, 0x80, EError::InvalidLeading>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBufferAsciiTo32([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<std::uint8_t, char32_t, 0x80, EError::InvalidLeading>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer16ToLatin1([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<char16_t, std::uint8_t, 0x100, EError::OOB>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer16ToAscii([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<char16_t, std::uint8_t, 0x80, EError::OOB>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer32ToLatin1([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<char32_t, std::uint8_t, 0x100, EError::OOB>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ConvBuffer32ToAscii([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t readableSize, [[maybe_unused]] void* output, [[maybe_unused]] std::size_t& consumed, [[maybe_unused]] std::size_t& outputSize)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return Details::ConvBuffer<&ConvBlockUnits<char32_t, std::uint8_t, 0x80, EError::OOB>>(input, inputSize, readableSize, output, consumed, outputSize);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError Validate8([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& errorOffset)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ValidateUTF8(input, inputSize, errorOffset);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError ValidateAscii([[maybe_unused]] const void* input, [[maybe_unused]] std::size_t inputSize, [[maybe_unused]] std::size_t& errorOffset)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return ValidateAsciiAVX2(input, inputSize, errorOffset);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError HashStripes([[maybe_unused]] std::uint64_t* lanes, [[maybe_unused]] const char32_t* codepoints, [[maybe_unused]] std::size_t stripes, [[maybe_unused]] std::size_t& round)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return HashStripesAVX2(lanes, codepoints, stripes, round);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError AsciiMatch8To16([[maybe_unused]] const void* narrow, [[maybe_unused]] const void* wide, [[maybe_unused]] std::size_t size, [[maybe_unused]] std::size_t& matched)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return AsciiMatchAVX2<char8_t, char16_t>(narrow, wide, size, matched, &Generic::AsciiMatch8To16);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError AsciiMatch8To32([[maybe_unused]] const void* narrow, [[maybe_unused]] const void* wide, [[maybe_unused]] std::size_t size, [[maybe_unused]] std::size_t& matched)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return AsciiMatchAVX2<char8_t, char32_t>(narrow, wide, size, matched, &Generic::AsciiMatch8To32);
+#else
+		return EError::MissingImpl;
+#endif
+	}
+
+	EError AsciiMatch16To32([[maybe_unused]] const void* narrow, [[maybe_unused]] const void* wide, [[maybe_unused]] std::size_t size, [[maybe_unused]] std::size_t& matched)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return AsciiMatchAVX2<char16_t, char32_t>(narrow, wide, size, matched, &Generic::AsciiMatch16To32);
+#else
+		return EError::MissingImpl;
+#endif
 	}
 } // namespace UTF::SIMD
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#if defined(__clang__)
+		#pragma clang attribute pop
+	#elif defined(__GNUC__)
+		#pragma GCC pop_options
+	#endif
+#endif
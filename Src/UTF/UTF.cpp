@@ -1,50 +1,480 @@
-#if false
+#include "UTF/UTF.h"
 
-	#include "UTF/UTF.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#elif defined(__x86_64__)
+	#include <cpuid.h>
+#endif
 
 namespace UTF
 {
 	CalcReqSizeImplF s_CalcReqSizeImpls[c_EncodingCount][c_EncodingCount][c_ImplCount];
 	ConvBlockImplF   s_ConvBlockImpls[c_EncodingCount][c_EncodingCount][c_ImplCount];
+	ConvBufferImplF  s_ConvBufferImpls[c_EncodingCount][c_EncodingCount][c_ImplCount];
+	LengthImplF      s_LengthImpls[c_EncodingCount][c_EncodingCount][c_ImplCount];
+	ValidateImplF    s_ValidateImpls[c_EncodingCount][c_ImplCount];
+	HashImplF        s_HashImpls[c_ImplCount];
+	AsciiMatchImplF  s_AsciiMatchImpls[c_EncodingCount][c_EncodingCount][c_ImplCount];
+	static EImpl     s_FastestImpl   = EImpl::Generic;
+	static EImpl     s_SupportedImpl = EImpl::Generic;
+
+#if defined(__x86_64__) || defined(_M_X64)
+	static void CPUID(std::uint32_t leaf, std::uint32_t subleaf, std::uint32_t (&regs)[4])
+	{
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+		for (std::size_t i = 0; i < 4; ++i)
+			regs[i] = static_cast<std::uint32_t>(info[i]);
+	#else
+		__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+	#endif
+	}
+
+	static std::uint64_t XGetBV()
+	{
+	#if defined(_MSC_VER)
+		return _xgetbv(0);
+	#else
+		std::uint32_t lo, hi;
+		__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+		return lo | static_cast<std::uint64_t>(hi) << 32;
+	#endif
+	}
+#endif
+
+	// Highest tier both the CPU and the OS support, the OS has to save the wider registers as well.
+	static EImpl DetectImpl()
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		std::uint32_t regs[4];
+		CPUID(0, 0, regs);
+		if (regs[0] < 7)
+			return EImpl::Generic;
+
+		CPUID(1, 0, regs);
+		bool osxsave = regs[2] & (1U << 27);
+		bool popcnt  = regs[2] & (1U << 23);
+		if (!osxsave || !popcnt)
+			return EImpl::Generic;
+
+		std::uint64_t xcr0 = XGetBV();
+		CPUID(7, 0, regs);
+		bool avx2 = (xcr0 & 0x06) == 0x06 &&
+					(regs[1] & (1U << 3)) &&  // BMI1
+					(regs[1] & (1U << 5)) &&  // AVX2
+					(regs[1] & (1U << 8));    // BMI2
+		if (!avx2 || !SIMD::c_Supported)
+			return EImpl::Generic;
+
+		bool avx512 = (xcr0 & 0xE6) == 0xE6 &&
+					  (regs[1] & (1U << 16)) && // AVX512F
+					  (regs[1] & (1U << 30)) && // AVX512BW
+					  (regs[1] & (1U << 31)) && // AVX512VL
+					  (regs[2] & (1U << 1)) &&  // AVX512VBMI
+					  (regs[2] & (1U << 6));    // AVX512VBMI2
+		if (!avx512 || !AVX512::c_Supported)
+			return EImpl::SIMD;
+		return EImpl::AVX512;
+#else
+		return EImpl::Generic;
+#endif
+	}
+
+	// UTF_IMPL=Generic|SIMD|AVX512 lowers the tier picked for EImpl::Fastest, higher tiers than supported are ignored.
+	static EImpl OverrideImpl(EImpl supported)
+	{
+		const char* value = std::getenv("UTF_IMPL");
+		if (!value)
+			return supported;
+
+		std::string_view name   = value;
+		EImpl            forced = supported;
+		if (name == "Generic")
+			forced = EImpl::Generic;
+		else if (name == "SIMD")
+			forced = EImpl::SIMD;
+		else if (name == "AVX512")
+			forced = EImpl::AVX512;
+		return forced < supported ? forced : supported;
+	}
 
 	static struct Initializer
 	{
-		void SetFuncs(EEncoding from, EEncoding to, EImpl impl, CalcReqSizeImplF calcFunc, ConvBlockImplF convFunc)
+		void SetFuncs(EEncoding from, EEncoding to, EImpl impl, CalcReqSizeImplF calcFunc, ConvBlockImplF convFunc, ConvBufferImplF bufferFunc)
 		{
 			s_CalcReqSizeImpls[static_cast<std::uint8_t>(from)][static_cast<std::uint8_t>(to)][static_cast<std::uint8_t>(impl)] = calcFunc;
 			s_ConvBlockImpls[static_cast<std::uint8_t>(from)][static_cast<std::uint8_t>(to)][static_cast<std::uint8_t>(impl)]   = convFunc;
+			s_ConvBufferImpls[static_cast<std::uint8_t>(from)][static_cast<std::uint8_t>(to)][static_cast<std::uint8_t>(impl)]  = bufferFunc;
+		}
+
+		void SetLengthFunc(EEncoding from, EEncoding to, EImpl impl, LengthImplF lengthFunc)
+		{
+			s_LengthImpls[static_cast<std::uint8_t>(from)][static_cast<std::uint8_t>(to)][static_cast<std::uint8_t>(impl)] = lengthFunc;
+		}
+
+		void SetValidateFunc(EEncoding encoding, EImpl impl, ValidateImplF validateFunc)
+		{
+			s_ValidateImpls[static_cast<std::uint8_t>(encoding)][static_cast<std::uint8_t>(impl)] = validateFunc;
+		}
+
+		void SetHashFunc(EImpl impl, HashImplF hashFunc)
+		{
+			s_HashImpls[static_cast<std::uint8_t>(impl)] = hashFunc;
+		}
+
+		void SetAsciiMatchFunc(EEncoding narrow, EEncoding wide, EImpl impl, AsciiMatchImplF matchFunc)
+		{
+			s_AsciiMatchImpls[static_cast<std::uint8_t>(narrow)][static_cast<std::uint8_t>(wide)][static_cast<std::uint8_t>(impl)] = matchFunc;
 		}
 
 		Initializer()
 		{
-			SetFuncs(EEncoding::UTF8, EEncoding::UTF8, EImpl::Generic, nullptr, nullptr);
-			SetFuncs(EEncoding::UTF8, EEncoding::UTF8, EImpl::SIMD, nullptr, nullptr);
-			SetFuncs(EEncoding::UTF8, EEncoding::UTF16, EImpl::Generic, &Generic::CalcReqSize8To16, &Generic::ConvBlock8To16);
-			SetFuncs(EEncoding::UTF8, EEncoding::UTF16, EImpl::SIMD, &SIMD::CalcReqSize8To16, &SIMD::ConvBlock8To16);
-			SetFuncs(EEncoding::UTF8, EEncoding::UTF32, EImpl::Generic, &Generic::CalcReqSize8To32, &Generic::ConvBlock8To32);
-			SetFuncs(EEncoding::UTF8, EEncoding::UTF32, EImpl::SIMD, &SIMD::CalcReqSize8To32, &SIMD::ConvBlock8To32);
-			SetFuncs(EEncoding::UTF16, EEncoding::UTF8, EImpl::Generic, &Generic::CalcReqSize16To8, &Generic::ConvBlock16To8);
-			SetFuncs(EEncoding::UTF16, EEncoding::UTF8, EImpl::SIMD, &SIMD::CalcReqSize16To8, &SIMD::ConvBlock16To8);
-			SetFuncs(EEncoding::UTF16, EEncoding::UTF16, EImpl::Generic, nullptr, nullptr);
-			SetFuncs(EEncoding::UTF16, EEncoding::UTF16, EImpl::SIMD, nullptr, nullptr);
-			SetFuncs(EEncoding::UTF16, EEncoding::UTF32, EImpl::Generic, &Generic::CalcReqSize16To32, &Generic::ConvBlock16To32);
-			SetFuncs(EEncoding::UTF16, EEncoding::UTF32, EImpl::SIMD, &SIMD::CalcReqSize16To32, &SIMD::ConvBlock16To32);
-			SetFuncs(EEncoding::UTF32, EEncoding::UTF8, EImpl::Generic, &Generic::CalcReqSize32To8, &Generic::ConvBlock32To8);
-			SetFuncs(EEncoding::UTF32, EEncoding::UTF8, EImpl::SIMD, &SIMD::CalcReqSize32To8, &SIMD::ConvBlock32To8);
-			SetFuncs(EEncoding::UTF32, EEncoding::UTF16, EImpl::Generic, &Generic::CalcReqSize32To16, &Generic::ConvBlock32To16);
-			SetFuncs(EEncoding::UTF32, EEncoding::UTF16, EImpl::SIMD, &SIMD::CalcReqSize32To16, &SIMD::ConvBlock32To16);
-			SetFuncs(EEncoding::UTF32, EEncoding::UTF32, EImpl::Generic, nullptr, nullptr);
-			SetFuncs(EEncoding::UTF32, EEncoding::UTF32, EImpl::SIMD, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF8, EImpl::Generic, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF8, EImpl::SIMD, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF8, EImpl::AVX512, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF8, EImpl::DFA, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF16, EImpl::Generic, &Generic::CalcReqSize8To16, &Generic::ConvBlock8To16, &Generic::ConvBuffer8To16);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF16, EImpl::SIMD, &SIMD::CalcReqSize8To16, &SIMD::ConvBlock8To16, &SIMD::ConvBuffer8To16);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF16, EImpl::AVX512, &AVX512::CalcReqSize8To16, &AVX512::ConvBlock8To16, &AVX512::ConvBuffer8To16);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF16, EImpl::DFA, &DFA::CalcReqSize8To16, &DFA::ConvBlock8To16, &DFA::ConvBuffer8To16);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF32, EImpl::Generic, &Generic::CalcReqSize8To32, &Generic::ConvBlock8To32, &Generic::ConvBuffer8To32);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF32, EImpl::SIMD, &SIMD::CalcReqSize8To32, &SIMD::ConvBlock8To32, &SIMD::ConvBuffer8To32);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF32, EImpl::AVX512, &AVX512::CalcReqSize8To32, &AVX512::ConvBlock8To32, &AVX512::ConvBuffer8To32);
+			SetFuncs(EEncoding::UTF8, EEncoding::UTF32, EImpl::DFA, &DFA::CalcReqSize8To32, &DFA::ConvBlock8To32, &DFA::ConvBuffer8To32);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF8, EImpl::Generic, &Generic::CalcReqSize16To8, &Generic::ConvBlock16To8, &Generic::ConvBuffer16To8);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF8, EImpl::SIMD, &SIMD::CalcReqSize16To8, &SIMD::ConvBlock16To8, &SIMD::ConvBuffer16To8);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF8, EImpl::AVX512, &AVX512::CalcReqSize16To8, &AVX512::ConvBlock16To8, &AVX512::ConvBuffer16To8);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF8, EImpl::DFA, &Generic::CalcReqSize16To8, &Generic::ConvBlock16To8, &Generic::ConvBuffer16To8);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF16, EImpl::Generic, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF16, EImpl::SIMD, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF16, EImpl::AVX512, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF16, EImpl::DFA, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF32, EImpl::Generic, &Generic::CalcReqSize16To32, &Generic::ConvBlock16To32, &Generic::ConvBuffer16To32);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF32, EImpl::SIMD, &SIMD::CalcReqSize16To32, &SIMD::ConvBlock16To32, &SIMD::ConvBuffer16To32);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF32, EImpl::AVX512, &AVX512::CalcReqSize16To32, &AVX512::ConvBlock16To32, &AVX512::ConvBuffer16To32);
+			SetFuncs(EEncoding::UTF16, EEncoding::UTF32, EImpl::DFA, &Generic::CalcReqSize16To32, &Generic::ConvBlock16To32, &Generic::ConvBuffer16To32);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF8, EImpl::Generic, &Generic::CalcReqSize32To8, &Generic::ConvBlock32To8, &Generic::ConvBuffer32To8);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF8, EImpl::SIMD, &SIMD::CalcReqSize32To8, &SIMD::ConvBlock32To8, &SIMD::ConvBuffer32To8);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF8, EImpl::AVX512, &AVX512::CalcReqSize32To8, &AVX512::ConvBlock32To8, &AVX512::ConvBuffer32To8);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF8, EImpl::DFA, &Generic::CalcReqSize32To8, &Generic::ConvBlock32To8, &Generic::ConvBuffer32To8);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF16, EImpl::Generic, &Generic::CalcReqSize32To16, &Generic::ConvBlock32To16, &Generic::ConvBuffer32To16);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF16, EImpl::SIMD, &SIMD::CalcReqSize32To16, &SIMD::ConvBlock32To16, &SIMD::ConvBuffer32To16);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF16, EImpl::AVX512, &AVX512::CalcReqSize32To16, &AVX512::ConvBlock32To16, &AVX512::ConvBuffer32To16);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF16, EImpl::DFA, &Generic::CalcReqSize32To16, &Generic::ConvBlock32To16, &Generic::ConvBuffer32To16);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF32, EImpl::Generic, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF32, EImpl::SIMD, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF32, EImpl::AVX512, nullptr, nullptr, nullptr);
+			SetFuncs(EEncoding::UTF32, EEncoding::UTF32, EImpl::DFA, nullptr, nullptr, nullptr);
+
+			// Latin-1 and ASCII have no DFA kernels, the Generic ones are as strict. ASCII to UTF-8 and Latin-1 and UTF-8 to ASCII only check the bytes are ASCII.
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF8, EImpl::Generic, &Generic::CalcReqSizeLatin1To8, &Generic::ConvBlockLatin1To8, &Generic::ConvBufferLatin1To8);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF8, EImpl::SIMD, &SIMD::CalcReqSizeLatin1To8, &SIMD::ConvBlockLatin1To8, &SIMD::ConvBufferLatin1To8);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF8, EImpl::AVX512, &SIMD::CalcReqSizeLatin1To8, &SIMD::ConvBlockLatin1To8, &SIMD::ConvBufferLatin1To8);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF8, EImpl::DFA, &Generic::CalcReqSizeLatin1To8, &Generic::ConvBlockLatin1To8, &Generic::ConvBufferLatin1To8);
+			SetFuncs(EEncoding::UTF8, EEncoding::Latin1, EImpl::Generic, &Generic::CalcReqSize8ToLatin1, &Generic::ConvBlock8ToLatin1, &Generic::ConvBuffer8ToLatin1);
+			SetFuncs(EEncoding::UTF8, EEncoding::Latin1, EImpl::SIMD, &SIMD::CalcReqSize8ToLatin1, &SIMD::ConvBlock8ToLatin1, &SIMD::ConvBuffer8ToLatin1);
+			SetFuncs(EEncoding::UTF8, EEncoding::Latin1, EImpl::AVX512, &SIMD::CalcReqSize8ToLatin1, &SIMD::ConvBlock8ToLatin1, &SIMD::ConvBuffer8ToLatin1);
+			SetFuncs(EEncoding::UTF8, EEncoding::Latin1, EImpl::DFA, &Generic::CalcReqSize8ToLatin1, &Generic::ConvBlock8ToLatin1, &Generic::ConvBuffer8ToLatin1);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF8, EImpl::Generic, &Generic::CalcReqSizeAsciiTo8, &Generic::ConvBlockAsciiTo8, &Generic::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF8, EImpl::SIMD, &SIMD::CalcReqSizeAsciiTo8, &SIMD::ConvBlockAsciiTo8, &SIMD::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF8, EImpl::AVX512, &SIMD::CalcReqSizeAsciiTo8, &SIMD::ConvBlockAsciiTo8, &SIMD::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF8, EImpl::DFA, &Generic::CalcReqSizeAsciiTo8, &Generic::ConvBlockAsciiTo8, &Generic::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::ASCII, EEncoding::Latin1, EImpl::Generic, &Generic::CalcReqSizeAsciiTo8, &Generic::ConvBlockAsciiTo8, &Generic::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::ASCII, EEncoding::Latin1, EImpl::SIMD, &SIMD::CalcReqSizeAsciiTo8, &SIMD::ConvBlockAsciiTo8, &SIMD::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::ASCII, EEncoding::Latin1, EImpl::AVX512, &SIMD::CalcReqSizeAsciiTo8, &SIMD::ConvBlockAsciiTo8, &SIMD::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::ASCII, EEncoding::Latin1, EImpl::DFA, &Generic::CalcReqSizeAsciiTo8, &Generic::ConvBlockAsciiTo8, &Generic::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::UTF8, EEncoding::ASCII, EImpl::Generic, &Generic::CalcReqSizeAsciiTo8, &Generic::ConvBlockAsciiTo8, &Generic::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::UTF8, EEncoding::ASCII, EImpl::SIMD, &SIMD::CalcReqSizeAsciiTo8, &SIMD::ConvBlockAsciiTo8, &SIMD::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::UTF8, EEncoding::ASCII, EImpl::AVX512, &SIMD::CalcReqSizeAsciiTo8, &SIMD::ConvBlockAsciiTo8, &SIMD::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::UTF8, EEncoding::ASCII, EImpl::DFA, &Generic::CalcReqSizeAsciiTo8, &Generic::ConvBlockAsciiTo8, &Generic::ConvBufferAsciiTo8);
+			SetFuncs(EEncoding::Latin1, EEncoding::ASCII, EImpl::Generic, &Generic::CalcReqSizeLatin1ToAscii, &Generic::ConvBlockLatin1ToAscii, &Generic::ConvBufferLatin1ToAscii);
+			SetFuncs(EEncoding::Latin1, EEncoding::ASCII, EImpl::SIMD, &SIMD::CalcReqSizeLatin1ToAscii, &SIMD::ConvBlockLatin1ToAscii, &SIMD::ConvBufferLatin1ToAscii);
+			SetFuncs(EEncoding::Latin1, EEncoding::ASCII, EImpl::AVX512, &SIMD::CalcReqSizeLatin1ToAscii, &SIMD::ConvBlockLatin1ToAscii, &SIMD::ConvBufferLatin1ToAscii);
+			SetFuncs(EEncoding::Latin1, EEncoding::ASCII, EImpl::DFA, &Generic::CalcReqSizeLatin1ToAscii, &Generic::ConvBlockLatin1ToAscii, &Generic::ConvBufferLatin1ToAscii);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF16, EImpl::Generic, &Generic::CalcReqSizeLatin1To16, &Generic::ConvBlockLatin1To16, &Generic::ConvBufferLatin1To16);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF16, EImpl::SIMD, &SIMD::CalcReqSizeLatin1To16, &SIMD::ConvBlockLatin1To16, &SIMD::ConvBufferLatin1To16);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF16, EImpl::AVX512, &SIMD::CalcReqSizeLatin1To16, &SIMD::ConvBlockLatin1To16, &SIMD::ConvBufferLatin1To16);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF16, EImpl::DFA, &Generic::CalcReqSizeLatin1To16, &Generic::ConvBlockLatin1To16, &Generic::ConvBufferLatin1To16);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF32, EImpl::Generic, &Generic::CalcReqSizeLatin1To32, &Generic::ConvBlockLatin1To32, &Generic::ConvBufferLatin1To32);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF32, EImpl::SIMD, &SIMD::CalcReqSizeLatin1To32, &SIMD::ConvBlockLatin1To32, &SIMD::ConvBufferLatin1To32);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF32, EImpl::AVX512, &SIMD::CalcReqSizeLatin1To32, &SIMD::ConvBlockLatin1To32, &SIMD::ConvBufferLatin1To32);
+			SetFuncs(EEncoding::Latin1, EEncoding::UTF32, EImpl::DFA, &Generic::CalcReqSizeLatin1To32, &Generic::ConvBlockLatin1To32, &Generic::ConvBufferLatin1To32);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF16, EImpl::Generic, &Generic::CalcReqSizeAsciiTo16, &Generic::ConvBlockAsciiTo16, &Generic::ConvBufferAsciiTo16);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF16, EImpl::SIMD, &SIMD::CalcReqSizeAsciiTo16, &SIMD::ConvBlockAsciiTo16, &SIMD::ConvBufferAsciiTo16);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF16, EImpl::AVX512, &SIMD::CalcReqSizeAsciiTo16, &SIMD::ConvBlockAsciiTo16, &SIMD::ConvBufferAsciiTo16);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF16, EImpl::DFA, &Generic::CalcReqSizeAsciiTo16, &Generic::ConvBlockAsciiTo16, &Generic::ConvBufferAsciiTo16);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF32, EImpl::Generic, &Generic::CalcReqSizeAsciiTo32, &Generic::ConvBlockAsciiTo32, &Generic::ConvBufferAsciiTo32);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF32, EImpl::SIMD, &SIMD::CalcReqSizeAsciiTo32, &SIMD::ConvBlockAsciiTo32, &SIMD::ConvBufferAsciiTo32);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF32, EImpl::AVX512, &SIMD::CalcReqSizeAsciiTo32, &SIMD::ConvBlockAsciiTo32, &SIMD::ConvBufferAsciiTo32);
+			SetFuncs(EEncoding::ASCII, EEncoding::UTF32, EImpl::DFA, &Generic::CalcReqSizeAsciiTo32, &Generic::ConvBlockAsciiTo32, &Generic::ConvBufferAsciiTo32);
+			SetFuncs(EEncoding::UTF16, EEncoding::Latin1, EImpl::Generic, &Generic::CalcReqSize16ToLatin1, &Generic::ConvBlock16ToLatin1, &Generic::ConvBuffer16ToLatin1);
+			SetFuncs(EEncoding::UTF16, EEncoding::Latin1, EImpl::SIMD, &SIMD::CalcReqSize16ToLatin1, &SIMD::ConvBlock16ToLatin1, &SIMD::ConvBuffer16ToLatin1);
+			SetFuncs(EEncoding::UTF16, EEncoding::Latin1, EImpl::AVX512, &SIMD::CalcReqSize16ToLatin1, &SIMD::ConvBlock16ToLatin1, &SIMD::ConvBuffer16ToLatin1);
+			SetFuncs(EEncoding::UTF16, EEncoding::Latin1, EImpl::DFA, &Generic::CalcReqSize16ToLatin1, &Generic::ConvBlock16ToLatin1, &Generic::ConvBuffer16ToLatin1);
+			SetFuncs(EEncoding::UTF16, EEncoding::ASCII, EImpl::Generic, &Generic::CalcReqSize16ToAscii, &Generic::ConvBlock16ToAscii, &Generic::ConvBuffer16ToAscii);
+			SetFuncs(EEncoding::UTF16, EEncoding::ASCII, EImpl::SIMD, &SIMD::CalcReqSize16ToAscii, &SIMD::ConvBlock16ToAscii, &SIMD::ConvBuffer16ToAscii);
+			SetFuncs(EEncoding::UTF16, EEncoding::ASCII, EImpl::AVX512, &SIMD::CalcReqSize16ToAscii, &SIMD::ConvBlock16ToAscii, &SIMD::ConvBuffer16ToAscii);
+			SetFuncs(EEncoding::UTF16, EEncoding::ASCII, EImpl::DFA, &Generic::CalcReqSize16ToAscii, &Generic::ConvBlock16ToAscii, &Generic::ConvBuffer16ToAscii);
+			SetFuncs(EEncoding::UTF32, EEncoding::Latin1, EImpl::Generic, &Generic::CalcReqSize32ToLatin1, &Generic::ConvBlock32ToLatin1, &Generic::ConvBuffer32ToLatin1);
+			SetFuncs(EEncoding::UTF32, EEncoding::Latin1, EImpl::SIMD, &SIMD::CalcReqSize32ToLatin1, &SIMD::ConvBlock32ToLatin1, &SIMD::ConvBuffer32ToLatin1);
+			SetFuncs(EEncoding::UTF32, EEncoding::Latin1, EImpl::AVX512, &SIMD::CalcReqSize32ToLatin1, &SIMD::ConvBlock32ToLatin1, &SIMD::ConvBuffer32ToLatin1);
+			SetFuncs(EEncoding::UTF32, EEncoding::Latin1, EImpl::DFA, &Generic::CalcReqSize32ToLatin1, &Generic::ConvBlock32ToLatin1, &Generic::ConvBuffer32ToLatin1);
+			SetFuncs(EEncoding::UTF32, EEncoding::ASCII, EImpl::Generic, &Generic::CalcReqSize32ToAscii, &Generic::ConvBlock32ToAscii, &Generic::ConvBuffer32ToAscii);
+			SetFuncs(EEncoding::UTF32, EEncoding::ASCII, EImpl::SIMD, &SIMD::CalcReqSize32ToAscii, &SIMD::ConvBlock32ToAscii, &SIMD::ConvBuffer32ToAscii);
+			SetFuncs(EEncoding::UTF32, EEncoding::ASCII, EImpl::AVX512, &SIMD::CalcReqSize32ToAscii, &SIMD::ConvBlock32ToAscii, &SIMD::ConvBuffer32ToAscii);
+			SetFuncs(EEncoding::UTF32, EEncoding::ASCII, EImpl::DFA, &Generic::CalcReqSize32ToAscii, &Generic::ConvBlock32ToAscii, &Generic::ConvBuffer32ToAscii);
+
+			// Counting is bound by the loads, the AVX512 tier uses the SIMD kernels as well
+			SetLengthFunc(EEncoding::UTF8, EEncoding::UTF16, EImpl::Generic, &Generic::Length8To16);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::UTF16, EImpl::SIMD, &SIMD::Length8To16);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::UTF16, EImpl::AVX512, &SIMD::Length8To16);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::UTF16, EImpl::DFA, &Generic::Length8To16);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::UTF32, EImpl::Generic, &Generic::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::UTF32, EImpl::SIMD, &SIMD::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::UTF32, EImpl::AVX512, &SIMD::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::UTF32, EImpl::DFA, &Generic::Length8To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::UTF8, EImpl::Generic, &Generic::Length16To8);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::UTF8, EImpl::SIMD, &SIMD::Length16To8);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::UTF8, EImpl::AVX512, &SIMD::Length16To8);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::UTF8, EImpl::DFA, &Generic::Length16To8);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::UTF32, EImpl::Generic, &Generic::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::UTF32, EImpl::SIMD, &SIMD::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::UTF32, EImpl::AVX512, &SIMD::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::UTF32, EImpl::DFA, &Generic::Length16To32);
+			SetLengthFunc(EEncoding::UTF32, EEncoding::UTF8, EImpl::Generic, &Generic::Length32To8);
+			SetLengthFunc(EEncoding::UTF32, EEncoding::UTF8, EImpl::SIMD, &SIMD::Length32To8);
+			SetLengthFunc(EEncoding::UTF32, EEncoding::UTF8, EImpl::AVX512, &SIMD::Length32To8);
+			SetLengthFunc(EEncoding::UTF32, EEncoding::UTF8, EImpl::DFA, &Generic::Length32To8);
+			SetLengthFunc(EEncoding::UTF32, EEncoding::UTF16, EImpl::Generic, &Generic::Length32To16);
+			SetLengthFunc(EEncoding::UTF32, EEncoding::UTF16, EImpl::SIMD, &SIMD::Length32To16);
+			SetLengthFunc(EEncoding::UTF32, EEncoding::UTF16, EImpl::AVX512, &SIMD::Length32To16);
+			SetLengthFunc(EEncoding::UTF32, EEncoding::UTF16, EImpl::DFA, &Generic::Length32To16);
+			// UTF-8 and UTF-16 take a Latin-1 or ASCII unit per codepoint
+			SetLengthFunc(EEncoding::Latin1, EEncoding::UTF8, EImpl::Generic, &Generic::LengthLatin1To8);
+			SetLengthFunc(EEncoding::Latin1, EEncoding::UTF8, EImpl::SIMD, &SIMD::LengthLatin1To8);
+			SetLengthFunc(EEncoding::Latin1, EEncoding::UTF8, EImpl::AVX512, &SIMD::LengthLatin1To8);
+			SetLengthFunc(EEncoding::Latin1, EEncoding::UTF8, EImpl::DFA, &Generic::LengthLatin1To8);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::Latin1, EImpl::Generic, &Generic::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::Latin1, EImpl::SIMD, &SIMD::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::Latin1, EImpl::AVX512, &SIMD::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::Latin1, EImpl::DFA, &Generic::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::ASCII, EImpl::Generic, &Generic::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::ASCII, EImpl::SIMD, &SIMD::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::ASCII, EImpl::AVX512, &SIMD::Length8To32);
+			SetLengthFunc(EEncoding::UTF8, EEncoding::ASCII, EImpl::DFA, &Generic::Length8To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::Latin1, EImpl::Generic, &Generic::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::Latin1, EImpl::SIMD, &SIMD::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::Latin1, EImpl::AVX512, &SIMD::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::Latin1, EImpl::DFA, &Generic::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::ASCII, EImpl::Generic, &Generic::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::ASCII, EImpl::SIMD, &SIMD::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::ASCII, EImpl::AVX512, &SIMD::Length16To32);
+			SetLengthFunc(EEncoding::UTF16, EEncoding::ASCII, EImpl::DFA, &Generic::Length16To32);
+
+			// The AVX512 tier implies AVX2, it validates UTF-8 and ASCII with the SIMD kernels. UTF-16 and UTF-32 only need a compare per unit, every byte is Latin-1.
+			SetValidateFunc(EEncoding::UTF8, EImpl::Generic, &Generic::Validate8);
+			SetValidateFunc(EEncoding::UTF8, EImpl::SIMD, &SIMD::Validate8);
+			SetValidateFunc(EEncoding::UTF8, EImpl::AVX512, &SIMD::Validate8);
+			SetValidateFunc(EEncoding::UTF8, EImpl::DFA, &Generic::Validate8);
+			SetValidateFunc(EEncoding::UTF16, EImpl::Generic, &Generic::Validate16);
+			SetValidateFunc(EEncoding::UTF16, EImpl::SIMD, &Generic::Validate16);
+			SetValidateFunc(EEncoding::UTF16, EImpl::AVX512, &Generic::Validate16);
+			SetValidateFunc(EEncoding::UTF16, EImpl::DFA, &Generic::Validate16);
+			SetValidateFunc(EEncoding::UTF32, EImpl::Generic, &Generic::Validate32);
+			SetValidateFunc(EEncoding::UTF32, EImpl::SIMD, &Generic::Validate32);
+			SetValidateFunc(EEncoding::UTF32, EImpl::AVX512, &Generic::Validate32);
+			SetValidateFunc(EEncoding::UTF32, EImpl::DFA, &Generic::Validate32);
+			SetValidateFunc(EEncoding::Latin1, EImpl::Generic, &Generic::ValidateLatin1);
+			SetValidateFunc(EEncoding::Latin1, EImpl::SIMD, &Generic::ValidateLatin1);
+			SetValidateFunc(EEncoding::Latin1, EImpl::AVX512, &Generic::ValidateLatin1);
+			SetValidateFunc(EEncoding::Latin1, EImpl::DFA, &Generic::ValidateLatin1);
+			SetValidateFunc(EEncoding::ASCII, EImpl::Generic, &Generic::ValidateAscii);
+			SetValidateFunc(EEncoding::ASCII, EImpl::SIMD, &SIMD::ValidateAscii);
+			SetValidateFunc(EEncoding::ASCII, EImpl::AVX512, &SIMD::ValidateAscii);
+			SetValidateFunc(EEncoding::ASCII, EImpl::DFA, &Generic::ValidateAscii);
+
+			// Hashing the decoded codepoints is the same on every impl, only the decoding is strict under DFA
+			SetHashFunc(EImpl::Generic, &Generic::HashStripes);
+			SetHashFunc(EImpl::SIMD, &SIMD::HashStripes);
+			SetHashFunc(EImpl::AVX512, &SIMD::HashStripes);
+			SetHashFunc(EImpl::DFA, &Generic::HashStripes);
+
+			// Only ASCII is matched, which decodes the same under DFA
+			SetAsciiMatchFunc(EEncoding::UTF8, EEncoding::UTF16, EImpl::Generic, &Generic::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::UTF8, EEncoding::UTF16, EImpl::SIMD, &SIMD::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::UTF8, EEncoding::UTF16, EImpl::AVX512, &SIMD::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::UTF8, EEncoding::UTF16, EImpl::DFA, &Generic::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::UTF8, EEncoding::UTF32, EImpl::Generic, &Generic::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::UTF8, EEncoding::UTF32, EImpl::SIMD, &SIMD::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::UTF8, EEncoding::UTF32, EImpl::AVX512, &SIMD::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::UTF8, EEncoding::UTF32, EImpl::DFA, &Generic::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::UTF16, EEncoding::UTF32, EImpl::Generic, &Generic::AsciiMatch16To32);
+			SetAsciiMatchFunc(EEncoding::UTF16, EEncoding::UTF32, EImpl::SIMD, &SIMD::AsciiMatch16To32);
+			SetAsciiMatchFunc(EEncoding::UTF16, EEncoding::UTF32, EImpl::AVX512, &SIMD::AsciiMatch16To32);
+			SetAsciiMatchFunc(EEncoding::UTF16, EEncoding::UTF32, EImpl::DFA, &Generic::AsciiMatch16To32);
+			// Latin-1 and ASCII bytes widen the same as UTF-8 ones, only the ASCII is matched
+			SetAsciiMatchFunc(EEncoding::Latin1, EEncoding::UTF16, EImpl::Generic, &Generic::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::Latin1, EEncoding::UTF16, EImpl::SIMD, &SIMD::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::Latin1, EEncoding::UTF16, EImpl::AVX512, &SIMD::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::Latin1, EEncoding::UTF16, EImpl::DFA, &Generic::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::Latin1, EEncoding::UTF32, EImpl::Generic, &Generic::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::Latin1, EEncoding::UTF32, EImpl::SIMD, &SIMD::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::Latin1, EEncoding::UTF32, EImpl::AVX512, &SIMD::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::Latin1, EEncoding::UTF32, EImpl::DFA, &Generic::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::ASCII, EEncoding::UTF16, EImpl::Generic, &Generic::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::ASCII, EEncoding::UTF16, EImpl::SIMD, &SIMD::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::ASCII, EEncoding::UTF16, EImpl::AVX512, &SIMD::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::ASCII, EEncoding::UTF16, EImpl::DFA, &Generic::AsciiMatch8To16);
+			SetAsciiMatchFunc(EEncoding::ASCII, EEncoding::UTF32, EImpl::Generic, &Generic::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::ASCII, EEncoding::UTF32, EImpl::SIMD, &SIMD::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::ASCII, EEncoding::UTF32, EImpl::AVX512, &SIMD::AsciiMatch8To32);
+			SetAsciiMatchFunc(EEncoding::ASCII, EEncoding::UTF32, EImpl::DFA, &Generic::AsciiMatch8To32);
+
+			// Tiers the CPU lacks use the best one it has, so explicitly requested impls never run unsupported instructions
+			std::uint8_t supported = static_cast<std::uint8_t>(DetectImpl());
+			for (std::uint8_t impl = supported + 1; impl <= static_cast<std::uint8_t>(EImpl::AVX512); ++impl)
+				s_HashImpls[impl] = s_HashImpls[supported];
+			for (std::uint8_t from = 0; from < c_EncodingCount; ++from)
+			{
+				for (std::uint8_t impl = supported + 1; impl <= static_cast<std::uint8_t>(EImpl::AVX512); ++impl)
+					s_ValidateImpls[from][impl] = s_ValidateImpls[from][supported];
+				for (std::uint8_t to = 0; to < c_EncodingCount; ++to)
+				{
+					for (std::uint8_t impl = supported + 1; impl <= static_cast<std::uint8_t>(EImpl::AVX512); ++impl)
+					{
+						s_CalcReqSizeImpls[from][to][impl] = s_CalcReqSizeImpls[from][to][supported];
+						s_ConvBlockImpls[from][to][impl]   = s_ConvBlockImpls[from][to][supported];
+						s_ConvBufferImpls[from][to][impl]  = s_ConvBufferImpls[from][to][supported];
+						s_LengthImpls[from][to][impl]      = s_LengthImpls[from][to][supported];
+						s_AsciiMatchImpls[from][to][impl]  = s_AsciiMatchImpls[from][to][supported];
+					}
+				}
+			}
+			s_SupportedImpl = static_cast<EImpl>(supported);
+			s_FastestImpl   = OverrideImpl(s_SupportedImpl);
 		}
 	} s_Initializer;
 
 	EImpl GetFastestImpl()
 	{
-		if constexpr (SIMD::c_Supported)
-			return EImpl::SIMD;
-		else
-			return EImpl::Generic;
+		return s_FastestImpl;
 	}
-} // namespace UTF
 
-#endif
\ No newline at end of file
+	EImpl GetSupportedImpl()
+	{
+		return s_SupportedImpl;
+	}
+
+	namespace Details
+	{
+		std::size_t HardwareThreads()
+		{
+			static const std::size_t s_Threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+			return s_Threads;
+		}
+
+		struct ParallelJob
+		{
+			ParallelTaskF Task;
+			void*         Userdata;
+			std::size_t   Count;
+			std::size_t   Next     = 0;
+			std::size_t   Finished = 0;
+		};
+
+		// Workers are started the first time they are needed and then wait for the indices of every later ParallelFor, instead of
+		// threads being started and joined for each call. Jobs of several callers share the workers, every index is claimed under the lock.
+		struct WorkerPool
+		{
+		public:
+			void Run(ParallelJob& job)
+			{
+				std::unique_lock lock(m_Lock);
+				StartWorkers(std::min(job.Count, HardwareThreads()) - 1);
+				m_Jobs.push_back(&job);
+				m_WorkAvailable.notify_all();
+
+				// The caller runs indices of its own job as well, so the job completes even when no worker could be started
+				while (job.Next < job.Count)
+				{
+					std::size_t index = Claim(job);
+					lock.unlock();
+					job.Task(job.Userdata, index);
+					lock.lock();
+					++job.Finished;
+				}
+				m_JobDone.wait(lock, [&]() { return job.Finished == job.Count; });
+			}
+
+		private:
+			// Jobs leave the queue with their last index, so the ones in it always have an index left
+			std::size_t Claim(ParallelJob& job)
+			{
+				std::size_t index = job.Next++;
+				if (job.Next == job.Count)
+					m_Jobs.erase(std::find(m_Jobs.begin(), m_Jobs.end(), &job));
+				return index;
+			}
+
+			void StartWorkers(std::size_t count)
+			{
+				// A worker that fails to start is tried again by the next call
+				try
+				{
+					for (; m_Workers < count; ++m_Workers)
+						std::thread(&WorkerPool::Work, this).detach();
+				}
+				catch (const std::system_error&)
+				{
+				}
+				catch (const std::bad_alloc&)
+				{
+				}
+			}
+
+			void Work()
+			{
+				std::unique_lock lock(m_Lock);
+				while (true)
+				{
+					m_WorkAvailable.wait(lock, [&]() { return !m_Jobs.empty(); });
+					ParallelJob& job   = *m_Jobs.front();
+					std::size_t  index = Claim(job);
+					lock.unlock();
+					job.Task(job.Userdata, index);
+					lock.lock();
+					if (++job.Finished == job.Count)
+						m_JobDone.notify_all();
+				}
+			}
+
+		private:
+			std::mutex                m_Lock;
+			std::condition_variable   m_WorkAvailable;
+			std::condition_variable   m_JobDone;
+			std::vector<ParallelJob*> m_Jobs;
+			std::size_t               m_Workers = 0;
+		};
+
+		void ParallelFor(std::size_t count, ParallelTaskF task, void* userdata)
+		{
+			if (count == 0)
+				return;
+			// Never destroyed, the detached workers may still be waiting on it while the process exits
+			static WorkerPool& s_Pool = *new WorkerPool();
+			ParallelJob        job { .Task = task, .Userdata = userdata, .Count = count };
+			s_Pool.Run(job);
+		}
+	} // namespace Details
+} // namespace UTF
\ No newline at end of file
@@ -4,6 +4,7 @@
 #undef NDEBUG
 #include <cassert>
 
+extern void MemoryTests();
 extern void UTFTests();
 
 struct AssertType
@@ -65,5 +66,6 @@ void RegisterTests()
 		.ExpectCrash();
 	Testing::PopGroup();
 
+	MemoryTests();
 	UTFTests();
 }
\ No newline at end of file
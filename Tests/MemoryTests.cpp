@@ -0,0 +1,172 @@
+#include <Memory/Arena.h>
+#include <Memory/Memory.h>
+#include <Memory/Pool.h>
+#include <Testing/Testing.h>
+
+#include <cstring>
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+static void AlignedAlignTest()
+{
+	Testing::Expect(Memory::AlignCeil(65, 64) == 128);
+	Testing::Expect(Memory::AlignCeil(64, 64) == 64);
+	Testing::Expect(Memory::AlignFloor(127, 64) == 64);
+	Testing::Expect(Memory::AlignFloor(0, 64) == 0);
+}
+
+static void AlignedMallocTest()
+{
+	for (std::size_t alignment : { 1, 16, 64, 4096 })
+	{
+		void* ptr = Memory::AlignedMalloc(alignment, 100);
+		Testing::Expect(ptr != nullptr);
+		Testing::Expect(reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0);
+		std::memset(ptr, 0xCC, 100);
+		Memory::AlignedFree(ptr, alignment);
+	}
+}
+
+static void ArenaAllocateTest()
+{
+	Memory::Arena arena(1024);
+	auto*         first  = static_cast<std::uint8_t*>(arena.Allocate(10, 1));
+	auto*         second = static_cast<std::uint8_t*>(arena.Allocate(10, 64));
+	Testing::Expect(first && second);
+	Testing::Expect(reinterpret_cast<std::uintptr_t>(second) % 64 == 0);
+	Testing::Expect(second >= first + 10);
+
+	// Too large for a regular chunk, gets one of its own
+	void* large = arena.Allocate(4096, 16);
+	Testing::Expect(large != nullptr);
+	std::memset(large, 0xCC, 4096);
+	Testing::Expect(arena.Capacity() >= 1024 + 4096);
+}
+
+static void ArenaRewindTest()
+{
+	Memory::Arena arena(1024);
+	arena.Allocate(100);
+	auto  marker = arena.Mark();
+	void* first  = arena.Allocate(100);
+	for (std::size_t i = 0; i < 64; ++i)
+		arena.Allocate(100);
+	std::size_t capacity = arena.Capacity();
+
+	// The same work after a rewind reuses the chunks it grew
+	arena.Rewind(marker);
+	Testing::Expect(arena.Allocate(100) == first);
+	for (std::size_t i = 0; i < 64; ++i)
+		arena.Allocate(100);
+	Testing::Expect(arena.Capacity() == capacity);
+
+	arena.Reset();
+	arena.Trim();
+	Testing::Expect(arena.Capacity() == 0);
+}
+
+static void ArenaScopeTest()
+{
+	Memory::Arena arena;
+	void*         before = nullptr;
+	{
+		Memory::ArenaScope scope(arena);
+		before = arena.Allocate(32);
+	}
+	Testing::Expect(arena.Allocate(32) == before);
+}
+
+static void ArenaAllocatorTest()
+{
+	Memory::Arena                                                     arena;
+	std::vector<std::uint32_t, Memory::ArenaAllocator<std::uint32_t>> values(arena);
+	for (std::uint32_t i = 0; i < 10000; ++i)
+		values.push_back(i);
+	Testing::Expect(values.size() == 10000 && values[9999] == 9999);
+}
+
+static void PoolAllocateTest()
+{
+	Memory::Pool pool;
+	for (std::size_t size = 1; size <= Memory::c_PoolMaxSize * 2; size = size * 3 / 2 + 1)
+	{
+		void* ptr = pool.Allocate(size);
+		Testing::Expect(ptr != nullptr);
+		Testing::Expect(reinterpret_cast<std::uintptr_t>(ptr) % std::min<std::size_t>(std::bit_floor(size), 16) == 0);
+		std::memset(ptr, 0xCC, size);
+		pool.Deallocate(ptr, size);
+	}
+}
+
+static void PoolReuseTest()
+{
+	Memory::Pool pool;
+	void*        first = pool.Allocate(48);
+	void*        next  = pool.Allocate(48);
+	Testing::Expect(static_cast<std::uint8_t*>(next) == static_cast<std::uint8_t*>(first) + 64);
+	pool.Deallocate(first, 48);
+	Testing::Expect(pool.Allocate(64) == first);
+}
+
+static void PoolAllocatorTest()
+{
+	Memory::Pool                                                     pool;
+	std::vector<std::uint32_t, Memory::PoolAllocator<std::uint32_t>> values(pool);
+	for (std::uint32_t i = 0; i < 10000; ++i)
+		values.push_back(i);
+	Testing::Expect(values.size() == 10000 && values[9999] == 9999);
+}
+
+static void AlignedTests()
+{
+	Testing::PushGroup("Aligned");
+	Testing::Test("Align")
+		.OnTest(AlignedAlignTest);
+	Testing::Test("Malloc")
+		.OnTest(AlignedMallocTest);
+	Testing::PopGroup();
+}
+
+static void ArenaTests()
+{
+	Testing::PushGroup("Arena");
+	Testing::Test("Allocate")
+		.OnTest(ArenaAllocateTest)
+		.Time();
+	Testing::Test("Rewind")
+		.OnTest(ArenaRewindTest)
+		.Time();
+	Testing::Test("Scope")
+		.OnTest(ArenaScopeTest);
+	Testing::Test("Allocator")
+		.OnTest(ArenaAllocatorTest)
+		.Time();
+	Testing::PopGroup();
+}
+
+static void PoolTests()
+{
+	Testing::PushGroup("Pool");
+	Testing::Test("Allocate")
+		.OnTest(PoolAllocateTest)
+		.Time();
+	Testing::Test("Reuse")
+		.OnTest(PoolReuseTest);
+	Testing::Test("Allocator")
+		.OnTest(PoolAllocatorTest)
+		.Time();
+	Testing::PopGroup();
+}
+
+void MemoryTests()
+{
+	Testing::PushGroup("Memory");
+
+	AlignedTests();
+	ArenaTests();
+	PoolTests();
+
+	Testing::PopGroup();
+}
\ No newline at end of file
@@ -1,12 +1,27 @@
-#if false
+#include <Testing/Testing.h>
+#include <UTF/UTF.h>
 
-	#include <Testing/Testing.h>
-	#include <UTF/UTF.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <tuple>
 
 constexpr const char c_U8Str[]  = "\x7F\x7F\x7F\x7F\x7F\x7F\x7F\x7F\x7F\x7F\x7F\x7F\x7F\x7F\x7F\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xDF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xEF\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF\xF4\x8F\xBF\xBF";
 constexpr const char c_U16Str[] = "\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\x7F\x00\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\x07\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\xFF\xDB\xFF\xDF\x00";
 constexpr const char c_U32Str[] = "\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\x7F\x00\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\x07\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x00\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\xFF\xFF\x10\x00\x00\x00\x00";
 
+// Tiers the CPU lacks run a lower tier's kernels, so their tests are reported as one skipped test in place of the group
+static bool ImplDetected(UTF::EImpl impl, const char* name)
+{
+	if (UTF::GetSupportedImpl() >= impl)
+		return true;
+	Testing::Test(name).OnTest([]() { Testing::Skip(); });
+	return false;
+}
+
 template <UTF::EEncoding From, UTF::EEncoding To, UTF::EImpl Impl>
 static void RequiredSizeTest(const void* testString, size_t testStringSize, size_t expectedSize)
 {
@@ -15,6 +30,27 @@ static void RequiredSizeTest(const void* testString, size_t testStringSize, size
 	Testing::Expect(requiredSize == expectedSize);
 }
 
+// The input is copied to an allocation of exactly its size, so reads past the sequence it ends in show up under the sanitizers
+template <UTF::EEncoding From, UTF::EEncoding To, UTF::EImpl Impl, class C>
+static void TruncatedSizeCheck(std::initializer_list<C> units)
+{
+	auto input = std::make_unique<C[]>(units.size());
+	std::copy(units.begin(), units.end(), input.get());
+	size_t requiredSize = 0;
+	Testing::Expect(UTF::CalcReqSize<From, To>(input.get(), units.size() * sizeof(C), requiredSize, Impl) == UTF::EError::InvalidContinuation);
+}
+
+template <UTF::EImpl Impl>
+static void TruncatedSizeTest()
+{
+	TruncatedSizeCheck<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, Impl>({ char8_t { 0xC3 } });
+	TruncatedSizeCheck<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, Impl>({ char8_t { 0xC3 } });
+	TruncatedSizeCheck<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, Impl>({ char8_t { 'a' }, char8_t { 0xF0 }, char8_t { 0x9F }, char8_t { 0x98 } });
+	TruncatedSizeCheck<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, Impl>({ char8_t { 'a' }, char8_t { 0xF0 }, char8_t { 0x9F }, char8_t { 0x98 } });
+	TruncatedSizeCheck<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8, Impl>({ char16_t { 0xD83D } });
+	TruncatedSizeCheck<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32, Impl>({ char16_t { 'a' }, char16_t { 0xD83D } });
+}
+
 template <UTF::EEncoding From, UTF::EEncoding To, UTF::EImpl Impl>
 static void ConvBlockTest(const void* inputStart, size_t inputSize, size_t actualSize, const void* expected, size_t expectedSize)
 {
@@ -29,6 +65,40 @@ static void ConvBlockTest(const void* inputStart, size_t inputSize, size_t actua
 	Testing::Expect(memcmp(&output, expected, expectedSize) == 0);
 }
 
+// Four byte sequences past U+10FFFF or overlong fail in the block kernels and the size count, at the start of the block and across its end
+template <UTF::EImpl Impl>
+static void MaxCodepointBlockTest()
+{
+	for (std::string_view sequence : { "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF7\xBF\xBF\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF" })
+	{
+		for (size_t offset : { 0, 1, 60, 61, 62, 63 })
+		{
+			UTF::InputBlock  input;
+			UTF::OutputBlock output;
+			memset(&input, 'a', sizeof(input));
+			memcpy(input.Bytes + offset, sequence.data(), sequence.size());
+			size_t outputSize   = 0;
+			size_t requiredSize = 0;
+			Testing::Expect(UTF::ConvBlock<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(input, output, 64, outputSize, Impl) != UTF::EError::Success);
+			Testing::Expect(UTF::ConvBlock<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32>(input, output, 64, outputSize, Impl) != UTF::EError::Success);
+			Testing::Expect(UTF::CalcReqSize<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(input.Bytes, offset + sequence.size(), requiredSize, Impl) != UTF::EError::Success);
+			Testing::Expect(UTF::CalcReqSize<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32>(input.Bytes, offset + sequence.size(), requiredSize, Impl) != UTF::EError::Success);
+		}
+	}
+
+	// U+10000 and U+10FFFF themselves still convert
+	for (std::string_view sequence : { "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF" })
+	{
+		UTF::InputBlock  input;
+		UTF::OutputBlock output;
+		memset(&input, 'a', sizeof(input));
+		memcpy(input.Bytes + 62, sequence.data(), sequence.size());
+		size_t outputSize = 0;
+		Testing::Expect(UTF::ConvBlock<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32>(input, output, 64, outputSize, Impl) == UTF::EError::Success);
+		Testing::Expect(outputSize == 63 * 4);
+	}
+}
+
 template <UTF::EEncoding From, UTF::EEncoding To, UTF::EImpl Impl>
 static void ConvTest(const void* testString, size_t testStringSize, const void* expected, size_t expectedSize)
 {
@@ -37,8 +107,754 @@ static void ConvTest(const void* testString, size_t testStringSize, const void*
 	auto input  = std::basic_string_view<C2>(reinterpret_cast<const C2*>(testString), testStringSize / sizeof(C2));
 	auto output = std::basic_string_view<C1>(reinterpret_cast<const C1*>(expected), expectedSize / sizeof(C1));
 
-	auto result = UTF::Convert<C1, C2>(input, Impl);
+	auto result = UTF::Convert<C1, C2>(input, Impl, UTF::EConvertPolicy::TwoPass);
+	Testing::Expect(result == output);
+	result = UTF::Convert<C1, C2>(input, Impl, UTF::EConvertPolicy::SinglePass);
+	Testing::Expect(result == output);
+
+	// The result can be placed in an arena as well
+	Memory::Arena arena;
+	auto          arenaResult = UTF::Convert<C1, C2>(input, Impl, UTF::EConvertPolicy::Auto, UTF::EErrorPolicy::Error, Memory::ArenaAllocator<C1>(arena));
+	Testing::Expect(arenaResult == output);
+}
+
+static void ScratchTest()
+{
+	// Scratch buffers larger than a chunk are not kept by the arena they came from, neither the single pass buffer nor the windows
+	// input the sizing pass rejected is converted in
+	std::u8string  input(UTF::c_SinglePassMaxSize, u8'a');
+	Memory::Arena  scratch;
+	std::u32string output;
+	Testing::Expect(UTF::ConvertInto<char32_t, char8_t>(input, output, UTF::EImpl::Fastest, UTF::EConvertPolicy::SinglePass, UTF::EErrorPolicy::Error, scratch).Error == UTF::EError::Success);
+	Testing::Expect(output.size() == input.size() && scratch.Capacity() <= Memory::c_ArenaChunkSize);
+	input.push_back(u8'\xFF');
+	Testing::Expect(UTF::ConvertInto<char32_t, char8_t>(input, output, UTF::EImpl::Fastest, UTF::EConvertPolicy::TwoPass, UTF::EErrorPolicy::Error, scratch).Error != UTF::EError::Success);
+	Testing::Expect(scratch.Capacity() <= Memory::c_ArenaChunkSize);
+}
+
+template <UTF::EEncoding From, UTF::EEncoding To>
+static void ParallelConvTest(const void* testString, size_t testStringSize, const void* expected, size_t expectedSize)
+{
+	using C1 = UTF::Details::CharTypeT<To>;
+	using C2 = UTF::Details::CharTypeT<From>;
+
+	// Enough repetitions for several chunks, the splits land inside sequences of every length
+	std::basic_string<C2> input;
+	std::basic_string<C1> output;
+	while (input.size() * sizeof(C2) < 4 * UTF::c_ParallelChunkSize)
+	{
+		input.append(reinterpret_cast<const C2*>(testString), testStringSize / sizeof(C2));
+		output.append(reinterpret_cast<const C1*>(expected), expectedSize / sizeof(C1));
+	}
+
+	auto result = UTF::Convert<C1, C2>(input, UTF::EImpl::Fastest, UTF::EConvertPolicy::Parallel);
+	Testing::Expect(result == output);
+
+	// Callers on several threads share the workers
+	std::basic_string<C1> results[3];
+	{
+		std::jthread threads[3];
+		for (size_t index = 0; index < 3; ++index)
+			threads[index] = std::jthread([&, index]() { results[index] = UTF::Convert<C1, C2>(input, UTF::EImpl::Fastest, UTF::EConvertPolicy::Parallel); });
+	}
+	Testing::Expect(std::ranges::all_of(results, [&](auto& threadResult) { return threadResult == output; }));
+}
+
+template <UTF::EEncoding From, UTF::EEncoding To>
+static void SmallConvTest(const void* testString, size_t testStringSize)
+{
+	using C1   = UTF::Details::CharTypeT<To>;
+	using C2   = UTF::Details::CharTypeT<From>;
+	auto input = std::basic_string_view<C2>(reinterpret_cast<const C2*>(testString), testStringSize / sizeof(C2));
+
+	// Every piece short enough for the small path that starts and ends on a sequence boundary, checked against the kernels
+	for (size_t offset = 0; offset < input.size(); offset += UTF::Details::SequenceLength(input[offset]))
+	{
+		for (size_t end = offset + 1; end <= input.size() && (end - offset) * sizeof(C2) < UTF::c_SmallMaxSize; ++end)
+		{
+			if (end < input.size() && UTF::Details::SequenceStart(input.data(), end) != end)
+				continue;
+			auto piece = input.substr(offset, end - offset);
+			Testing::Expect(UTF::Convert<C1, C2>(piece) == UTF::Convert<C1, C2>(piece, UTF::EImpl::Generic, UTF::EConvertPolicy::SinglePass));
+		}
+	}
+
+	// A short ASCII result never leaves the string's own buffer
+	Testing::Expect(UTF::Convert<C1, C2>(input.substr(0, 3)).capacity() == std::basic_string<C1>().capacity());
+}
+
+template <class C1, class C2>
+static void SmallInvalidTest(std::initializer_list<std::basic_string_view<C2>> inputs)
+{
+	for (auto input : inputs)
+	{
+		std::basic_string<C1> small;
+		std::basic_string<C1> kernel;
+		auto                  smallResult  = UTF::ConvertInto<C1, C2>(input, small);
+		auto                  kernelResult = UTF::ConvertInto<C1, C2>(input, kernel, UTF::EImpl::Generic, UTF::EConvertPolicy::SinglePass);
+		Testing::Expect(smallResult.Error != UTF::EError::Success && smallResult.Error == kernelResult.Error);
+		Testing::Expect(small.empty());
+	}
+}
+
+template <class C1>
+static void StrictTest(std::initializer_list<std::u8string_view> inputs)
+{
+	// Overlong encodings, surrogates and codepoints past U+10FFFF
+	for (auto input : inputs)
+	{
+		std::basic_string<C1> result;
+		Testing::Expect(UTF::ConvertInto<C1, char8_t>(input, result, UTF::EImpl::DFA).Error != UTF::EError::Success);
+		Testing::Expect(result.empty());
+	}
+}
+
+template <UTF::EEncoding From, UTF::EEncoding To, UTF::EImpl Impl>
+static void ConvIntoTest(const void* testString, size_t testStringSize, const void* expected, size_t expectedSize)
+{
+	using C1    = UTF::Details::CharTypeT<To>;
+	using C2    = UTF::Details::CharTypeT<From>;
+	auto input  = std::span<const C2>(reinterpret_cast<const C2*>(testString), testStringSize / sizeof(C2));
+	auto output = std::basic_string_view<C1>(reinterpret_cast<const C1*>(expected), expectedSize / sizeof(C1));
+
+	// Half of the output only fits a part, the rest is converted by resuming from where it stopped
+	std::basic_string<C1> result(output.size(), '\0');
+	auto                  first = UTF::ConvertInto<C1, C2>(input, std::span<C1>(result).first(result.size() / 2), Impl);
+	Testing::Expect(first.Error == UTF::EError::OutputTooSmall);
+	auto second = UTF::ConvertInto<C1, C2>(input.subspan(first.Consumed), std::span<C1>(result).subspan(first.Written), Impl);
+	Testing::Expect(second.Error == UTF::EError::Success);
+	Testing::Expect(first.Written + second.Written == output.size());
+	Testing::Expect(result == output);
+}
+
+template <UTF::EEncoding From, UTF::EEncoding To>
+static void TranscoderTest(const void* testString, size_t testStringSize, const void* expected, size_t expectedSize)
+{
+	using C1    = UTF::Details::CharTypeT<To>;
+	using C2    = UTF::Details::CharTypeT<From>;
+	auto input  = std::basic_string_view<C2>(reinterpret_cast<const C2*>(testString), testStringSize / sizeof(C2));
+	auto output = std::basic_string_view<C1>(reinterpret_cast<const C1*>(expected), expectedSize / sizeof(C1));
+
+	// Chunk sizes that cut through sequences at every possible position
+	for (size_t chunkSize : { 1, 2, 3, 7, 61 })
+	{
+		UTF::Transcoder<From, To> transcoder;
+		std::basic_string<C1>     result;
+		for (size_t offset = 0; offset < input.size(); offset += chunkSize)
+			Testing::Expect(transcoder.Feed(input.substr(offset, chunkSize), result) == UTF::EError::Success);
+		Testing::Expect(transcoder.Finish() == UTF::EError::Success);
+		Testing::Expect(result == output);
+	}
+}
+
+template <UTF::EEncoding From, UTF::EEncoding To>
+static void BatchTest(const void* testString, size_t testStringSize, const void* expected, size_t expectedSize)
+{
+	using C1    = UTF::Details::CharTypeT<To>;
+	using C2    = UTF::Details::CharTypeT<From>;
+	auto input  = std::basic_string_view<C2>(reinterpret_cast<const C2*>(testString), testStringSize / sizeof(C2));
+	auto output = std::basic_string_view<C1>(reinterpret_cast<const C1*>(expected), expectedSize / sizeof(C1));
+
+	// Pieces of most lengths up to past a block, followed by an empty one, the whole string and one too long to be staged
+	std::basic_string<C2> repeated;
+	while (repeated.size() * sizeof(C2) <= UTF::c_BatchMaxStagedSize)
+		repeated.append(input);
+	std::vector<std::basic_string_view<C2>> pieces;
+	for (size_t offset = 0, length = 1; offset < input.size(); length = length % 80 + 7)
+	{
+		size_t end = offset + length >= input.size() ? input.size() : UTF::Details::SequenceStart(input.data(), offset + length);
+		if (end == offset)
+			end += UTF::Details::SequenceLength(input[offset]);
+		pieces.push_back(input.substr(offset, end - offset));
+		offset = end;
+	}
+	pieces.push_back({});
+	pieces.push_back(input);
+	pieces.push_back(repeated);
+
+	for (auto impl : { UTF::EImpl::Generic, UTF::EImpl::SIMD, UTF::EImpl::AVX512 })
+	{
+		std::basic_string<C1> result;
+		std::vector<size_t>   offsets;
+		auto                  batch = UTF::ConvertBatch<C1, C2>(pieces, result, offsets, impl);
+		Testing::Expect(batch.Error == UTF::EError::Success && batch.Converted == pieces.size());
+		Testing::Expect(std::basic_string_view<C1>(result).substr(0, output.size()) == output);
+		for (size_t i = 0; i < pieces.size(); ++i)
+			Testing::Expect(std::basic_string_view<C1>(result).substr(offsets[i], offsets[i + 1] - offsets[i]) == UTF::Convert<C1, C2>(pieces[i], impl));
+	}
+}
+
+static void BatchInvalidTest()
+{
+	// Both halves are invalid on their own, even though they would form a sequence if packed next to each other
+	std::u8string_view pieces[] { u8"ab", u8"\xC3", u8"\xA9", u8"cd" };
+	for (auto impl : { UTF::EImpl::Generic, UTF::EImpl::SIMD, UTF::EImpl::AVX512 })
+	{
+		std::u16string      result;
+		std::vector<size_t> offsets;
+		auto                batch = UTF::ConvertBatch<char16_t, char8_t>(pieces, result, offsets, impl);
+		Testing::Expect(batch.Error != UTF::EError::Success && batch.Converted == 1);
+		Testing::Expect(result.substr(offsets[0], offsets[1] - offsets[0]) == u"ab");
+	}
+}
+
+template <UTF::EEncoding From, UTF::EEncoding To>
+static void ConvFileTest(const void* testString, size_t testStringSize, const void* expected, size_t expectedSize)
+{
+	// Enough repetitions for several windows, the window ends land inside sequences of every length
+	std::string input;
+	std::string output;
+	while (input.size() < 2 * UTF::c_FileWindowSize + 1)
+	{
+		input.append(reinterpret_cast<const char*>(testString), testStringSize);
+		output.append(reinterpret_cast<const char*>(expected), expectedSize);
+	}
+
+	auto inPath  = (std::filesystem::temp_directory_path() / "UTFTests.in").string();
+	auto outPath = (std::filesystem::temp_directory_path() / "UTFTests.out").string();
+	std::ofstream(inPath, std::ios::binary).write(input.data(), input.size());
+	Testing::Expect(UTF::ConvertFile(inPath, outPath, From, To) == UTF::EError::Success);
+
+	std::ifstream file(outPath, std::ios::binary);
+	std::string   result { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	file.close();
 	Testing::Expect(result == output);
+	std::filesystem::remove(inPath);
+	std::filesystem::remove(outPath);
+}
+
+static void ConvFileErrorTest()
+{
+	// Half a UTF-16 unit at the end is rejected before the output is written, and the output is removed again
+	auto inPath  = (std::filesystem::temp_directory_path() / "UTFTests.in").string();
+	auto outPath = (std::filesystem::temp_directory_path() / "UTFTests.out").string();
+	std::ofstream(inPath, std::ios::binary).write("a\0b", 3);
+	Testing::Expect(UTF::ConvertFile(inPath, outPath, UTF::EEncoding::UTF16, UTF::EEncoding::UTF8) == UTF::EError::FileError);
+	Testing::Expect(!std::filesystem::exists(outPath));
+	Testing::Expect(UTF::ConvertFile(inPath, outPath, static_cast<UTF::EEncoding>(UTF::c_EncodingCount), UTF::EEncoding::UTF8) == UTF::EError::MissingImpl);
+	Testing::Expect(UTF::ConvertFile(inPath, outPath, UTF::EEncoding::UTF8, static_cast<UTF::EEncoding>(0xFF)) == UTF::EError::MissingImpl);
+	Testing::Expect(UTF::ConvertFile(inPath, inPath, UTF::EEncoding::UTF8, UTF::EEncoding::UTF16) == UTF::EError::FileError);
+	std::filesystem::remove(inPath);
+}
+
+template <UTF::EEncoding Encoding, UTF::EImpl Impl>
+static void ValidateTest(const void* testString, size_t testStringSize, std::initializer_list<std::pair<std::basic_string_view<UTF::Details::CharTypeT<Encoding>>, size_t>> invalid)
+{
+	using C = UTF::Details::CharTypeT<Encoding>;
+	auto valid = UTF::Validate<Encoding>(testString, testStringSize, Impl);
+	Testing::Expect(valid.Valid && valid.ErrorOffset == testStringSize);
+
+	// Each case is tried on its own and after enough ASCII for the vectorized checks, offsets are in units of the input
+	for (auto [input, offset] : invalid)
+	{
+		std::basic_string<C> padded(100, C { 'a' });
+		padded.append(input);
+		auto result = UTF::Validate<Encoding>(input.data(), input.size() * sizeof(C), Impl);
+		Testing::Expect(!result.Valid && result.ErrorOffset == offset * sizeof(C));
+		result = UTF::Validate<Encoding>(padded.data(), padded.size() * sizeof(C), Impl);
+		Testing::Expect(!result.Valid && result.ErrorOffset == (100 + offset) * sizeof(C));
+	}
+}
+
+template <UTF::EImpl Impl>
+static void ValidateImplTest()
+{
+	ValidateTest<UTF::EEncoding::UTF8, Impl>(c_U8Str, sizeof(c_U8Str) - 1, { { u8"\x80", 0 }, { u8"\xC0\x80", 0 }, { u8"ab\xE0\x80\x80", 2 }, { u8"\xED\xA0\x80", 0 }, { u8"a\xF4\x90\x80\x80", 1 }, { u8"\xF5", 0 }, { u8"abc\xE2\x82", 3 }, { u8"\xC3\xA9\xA9", 2 } });
+	ValidateTest<UTF::EEncoding::UTF16, Impl>(c_U16Str, sizeof(c_U16Str) - 2, { { u"a\xDC00", 1 }, { u"ab\xD800", 2 }, { u"\xD800" "a", 0 } });
+	ValidateTest<UTF::EEncoding::UTF32, Impl>(c_U32Str, sizeof(c_U32Str) - 4, { { U"a\x110000", 1 }, { U"\xD800", 0 } });
+}
+
+template <class C1, class C2, UTF::EImpl Impl>
+static void ReplaceTest(std::initializer_list<std::pair<std::basic_string_view<C2>, std::basic_string_view<C1>>> cases)
+{
+	// Each case is tried on its own and after ASCII that puts it across a block boundary or past the first chunk of the kernel calls.
+	// EErrorPolicy::Error rejects every case on every impl.
+	for (auto [input, expected] : cases)
+	{
+		for (std::size_t padding : { 0, 62, 2000 })
+		{
+			std::basic_string<C2> paddedInput(padding, C2 { 'a' });
+			std::basic_string<C1> paddedExpected(padding, C1 { 'a' });
+			paddedInput.append(input);
+			paddedExpected.append(expected);
+			for (auto policy : { UTF::EConvertPolicy::Auto, UTF::EConvertPolicy::TwoPass, UTF::EConvertPolicy::SinglePass })
+			{
+				std::basic_string<C1> output;
+				Testing::Expect(UTF::ConvertInto<C1, C2>(paddedInput, output, Impl, policy).Error != UTF::EError::Success && output.empty());
+				Testing::Expect(UTF::Convert<C1, C2>(paddedInput, Impl, policy, UTF::EErrorPolicy::Replace) == paddedExpected);
+			}
+		}
+	}
+}
+
+template <UTF::EImpl Impl>
+static void ReplaceImplTest()
+{
+	ReplaceTest<char16_t, char8_t, Impl>({ { u8"a\xF0\x90\x80" "b", u"a\xFFFD" "b" }, { u8"\xE2\x82", u"\xFFFD" }, { u8"\x80\x80", u"\xFFFD\xFFFD" }, { u8"\xC3\xA9\xA9", u"\xE9\xFFFD" }, { u8"\xF8\x80" "a", u"\xFFFD\xFFFD" "a" }, { u8"\xE2\x82\xAC\xE2" "a", u"\x20AC\xFFFD" "a" } });
+	ReplaceTest<char32_t, char8_t, Impl>({ { u8"a\xF0\x90\x80" "b", U"a\xFFFD" "b" }, { u8"\xF0\x9F\x98\x80\x80", U"\x1F600\xFFFD" } });
+	ReplaceTest<char8_t, char16_t, Impl>({ { u"a\xDC00", u8"a\uFFFD" }, { u"\xD800" "a", u8"\uFFFD" "a" }, { u"\xD800\xD800\xDC00", u8"\uFFFD\U00010000" } });
+	ReplaceTest<char8_t, char32_t, Impl>({ { U"a\x110000", u8"a\uFFFD" }, { U"a\xD800", u8"a\uFFFD" }, { U"\xDFFF" "b", u8"\uFFFD" "b" } });
+	ReplaceTest<char16_t, char32_t, Impl>({ { U"\xD800\xDC00", u"\xFFFD\xFFFD" } });
+	// Surrogates, overlong encodings and codepoints past U+10FFFF
+	ReplaceTest<char16_t, char8_t, Impl>({ { u8"\xED\xA0\x80", u"\xFFFD\xFFFD\xFFFD" }, { u8"\xC0\x80", u"\xFFFD\xFFFD" }, { u8"a\xF4\x90\x80\x80", u"a\xFFFD\xFFFD\xFFFD\xFFFD" }, { u8"\xE0\x80\xAF", u"\xFFFD\xFFFD\xFFFD" } });
+	ReplaceTest<char32_t, char8_t, Impl>({ { u8"\xED\xA0\x80", U"\xFFFD\xFFFD\xFFFD" }, { u8"A\xF4\x90\x80\x80" "B", U"A\xFFFD\xFFFD\xFFFD\xFFFD" "B" }, { u8"\xE0\x80\xAF", U"\xFFFD\xFFFD\xFFFD" }, { u8"\xF0\x8F\xBF\xBF", U"\xFFFD\xFFFD\xFFFD\xFFFD" } });
+
+	// Sizing, hashing and comparing replace them the same way, the ASCII in front puts them past the small paths
+	std::u8string strict(200, u8'a');
+	strict.append(u8"\xED\xA0\x80\xC0\x80" "b" "\xF4\x90\x80\x80\xE0\x80\xAF");
+	std::u32string replaced = UTF::Convert<char32_t, char8_t>(strict, Impl, UTF::EConvertPolicy::Auto, UTF::EErrorPolicy::Replace);
+	size_t         requiredSize = 0;
+	Testing::Expect(replaced.size() == 200 + 13 && replaced.find_first_not_of(U"ab\xFFFD") == std::u32string::npos);
+	Testing::Expect(UTF::CalcReqSize<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32>(strict.data(), strict.size(), requiredSize, Impl, UTF::EErrorPolicy::Replace) == UTF::EError::Success);
+	Testing::Expect(requiredSize == replaced.size() * 4);
+	Testing::Expect(UTF::Hash(std::u8string_view { strict }, Impl) == UTF::Hash(std::u32string_view { replaced }, Impl));
+	Testing::Expect(UTF::Equal(std::u8string_view { strict }, std::u32string_view { replaced }, Impl));
+	Testing::Expect(std::ranges::equal(UTF::Codepoints(std::u8string_view { strict }, Impl), replaced));
+}
+
+template <class C1, class C2, UTF::EImpl Impl>
+static void PrefixTest(std::initializer_list<std::tuple<std::basic_string_view<C2>, std::basic_string_view<C1>, size_t>> cases)
+{
+	// Each case is tried on its own and after ASCII that puts the error across a block boundary or behind a full kernel call
+	for (auto [input, expected, offset] : cases)
+	{
+		for (std::size_t padding : { 0, 62, 2000 })
+		{
+			std::basic_string<C2> paddedInput(padding, C2 { 'a' });
+			std::basic_string<C1> paddedExpected(padding, C1 { 'a' });
+			paddedInput.append(input);
+			paddedExpected.append(expected);
+			for (auto policy : { UTF::EConvertPolicy::Auto, UTF::EConvertPolicy::TwoPass, UTF::EConvertPolicy::SinglePass })
+			{
+				std::basic_string<C1> output;
+				auto                  result = UTF::ConvertPrefix<C1, C2>(paddedInput, output, Impl, policy);
+				Testing::Expect(result.Error != UTF::EError::Success && result.Consumed == padding + offset);
+				Testing::Expect(result.Written == paddedExpected.size() && output == paddedExpected);
+
+				// The same error is reported without anything being appended
+				output.clear();
+				auto into = UTF::ConvertInto<C1, C2>(paddedInput, output, Impl, policy);
+				Testing::Expect(into.Error == result.Error && into.Consumed == result.Consumed && output.empty());
+			}
+		}
+	}
+}
+
+template <UTF::EImpl Impl>
+static void PrefixImplTest()
+{
+	PrefixTest<char16_t, char8_t, Impl>({ { u8"ab\xE2\x82" "c", u"ab", 2 }, { u8"\xC3\xA9\x80", u"\xE9", 2 }, { u8"a\xF8", u"a", 1 }, { u8"\xE2\x82\xAC\xF0\x9F\x98", u"\x20AC", 3 } });
+	PrefixTest<char32_t, char8_t, Impl>({ { u8"\xF0\x9F\x98\x80\x80", U"\x1F600", 4 } });
+	PrefixTest<char8_t, char16_t, Impl>({ { u"ab\xDC00", u8"ab", 2 }, { u"\xD800" "a", u8"", 0 } });
+	PrefixTest<char8_t, char32_t, Impl>({ { U"a\x110000", u8"a", 1 } });
+	PrefixTest<char16_t, char8_t, Impl>({ { u8"a\xED\xA0\x80", u"a", 1 }, { u8"\xC3\xA9\xC0\x80", u"\xE9", 2 }, { u8"\xE0\x9F\xBF", u"", 0 } });
+	PrefixTest<char8_t, char32_t, Impl>({ { U"ab\xDBFF", u8"ab", 2 } });
+}
+
+template <UTF::EEncoding From, UTF::EEncoding To, UTF::EImpl Impl>
+static void LengthTest(const void* testString, size_t testStringSize, size_t expectedLength, const void* invalid, size_t invalidSize)
+{
+	Testing::Expect(UTF::Length<From, To>(testString, testStringSize, Impl) == expectedLength);
+
+	// Invalid input counts the same on every impl, the sizes cover the vector loops, their tails and the sums of the byte counters
+	const char* bytes = static_cast<const char*>(invalid);
+	for (size_t size : { size_t { 0 }, size_t { 31 }, size_t { 32 }, size_t { 33 }, size_t { 8191 }, invalidSize - 1, invalidSize })
+	{
+		Testing::Expect(UTF::Length<From, To>(bytes, size, Impl) == UTF::Length<From, To>(bytes, size, UTF::EImpl::Generic));
+		if (size > 4)
+			Testing::Expect(UTF::Length<From, To>(bytes + 4, size - 4, Impl) == UTF::Length<From, To>(bytes + 4, size - 4, UTF::EImpl::Generic));
+	}
+}
+
+template <UTF::EImpl Impl>
+static void LengthImplTest()
+{
+	std::u8string  invalid8;
+	std::u16string invalid16;
+	std::u32string invalid32;
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		invalid8.append(u8"a\u00E9\u4E2D\U0001F600\xFF\x80\xF8");
+		invalid16.append(u"a\u00E9\u4E2D\U0001F600\xDC00\xD800");
+		invalid32.append(U"a\u00E9\u4E2D\U0001F600\xD800");
+		invalid32.push_back(static_cast<char32_t>(0x11'0000 + i * 0x10'0001));
+	}
+
+	LengthTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, Impl>(c_U8Str, sizeof(c_U8Str) - 1, 72, invalid8.data(), invalid8.size());
+	LengthTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, Impl>(c_U8Str, sizeof(c_U8Str) - 1, 59, invalid8.data(), invalid8.size());
+	LengthTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8, Impl>(c_U16Str, sizeof(c_U16Str) - 2, 145, invalid16.data(), invalid16.size() * 2);
+	LengthTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32, Impl>(c_U16Str, sizeof(c_U16Str) - 2, 59, invalid16.data(), invalid16.size() * 2);
+	LengthTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8, Impl>(c_U32Str, sizeof(c_U32Str) - 4, 145, invalid32.data(), invalid32.size() * 4);
+	LengthTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, Impl>(c_U32Str, sizeof(c_U32Str) - 4, 72, invalid32.data(), invalid32.size() * 4);
+
+	Testing::Expect(UTF::CountCodepoints(std::u8string_view { u8"a\u00E9\u4E2D\U0001F600" }, Impl) == 4);
+	Testing::Expect(UTF::CountCodepoints(std::u16string_view { u"a\u00E9\u4E2D\U0001F600" }, Impl) == 4);
+	Testing::Expect(UTF::CountCodepoints(std::u32string_view { U"a\u00E9\u4E2D\U0001F600" }, Impl) == 4);
+	Testing::Expect(UTF::Length<char16_t>(std::u8string_view { u8"a\u00E9\u4E2D\U0001F600" }, Impl) == 5);
+	Testing::Expect(UTF::Length<char8_t>(std::u16string_view { u"a\u00E9\u4E2D\U0001F600" }, Impl) == 10);
+
+	// Every four byte sequence Convert accepts takes two UTF-16 units like Length counts it, the overlong ones are rejected
+	for (size_t padding : { 0, 200 })
+	{
+		std::u8string valid(padding, u8'a');
+		std::u8string overlong(padding, u8'a');
+		valid.append(u8"A\U00010000B");
+		overlong.append(u8"A\xF0\x80\x80\x80" u8"B");
+		std::u16string output;
+		size_t         requiredSize = 0;
+		Testing::Expect(UTF::Length<char16_t>(std::u8string_view { valid }, Impl) == UTF::Convert<char16_t, char8_t>(valid, Impl).size());
+		Testing::Expect(UTF::CalcReqSize<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(valid.data(), valid.size(), requiredSize, Impl) == UTF::EError::Success);
+		Testing::Expect(requiredSize == (padding + 4) * 2);
+		Testing::Expect(UTF::CalcReqSize<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(overlong.data(), overlong.size(), requiredSize, Impl) == UTF::EError::InvalidContinuation);
+		Testing::Expect(UTF::ConvertPrefix<char16_t, char8_t>(overlong, output, Impl).Consumed == padding + 1);
+	}
+}
+
+template <class C, UTF::EImpl Impl>
+static void RangeTest(std::basic_string_view<C> input)
+{
+	// Each view has to give what converting the whole input with EErrorPolicy::Replace gives. Converting UTF-32 to itself copies it
+	// as it is, so that goes through UTF-8, the view replaces codepoints past U+10FFFF like any other conversion does.
+	std::u32string expected;
+	if constexpr (std::same_as<C, char32_t>)
+		expected = UTF::Convert<char32_t, char8_t>(UTF::Convert<char8_t, C>(input, Impl, UTF::EConvertPolicy::Auto, UTF::EErrorPolicy::Replace), Impl);
+	else
+		expected = UTF::Convert<char32_t, C>(input, Impl, UTF::EConvertPolicy::Auto, UTF::EErrorPolicy::Replace);
+	std::u32string codepoints;
+	for (char32_t codepoint : UTF::Codepoints(input, Impl))
+		codepoints.push_back(codepoint);
+	Testing::Expect(codepoints == expected);
+
+	std::u8string  utf8;
+	std::u16string utf16;
+	for (char8_t unit : UTF::Encode<UTF::EEncoding::UTF8>(UTF::Codepoints(input, Impl), Impl))
+		utf8.push_back(unit);
+	for (char16_t unit : UTF::Encode<UTF::EEncoding::UTF16>(codepoints, Impl))
+		utf16.push_back(unit);
+	Testing::Expect(utf8 == UTF::Convert<char8_t, char32_t>(expected, Impl));
+	Testing::Expect(utf16 == UTF::Convert<char16_t, char32_t>(expected, Impl));
+}
+
+template <UTF::EImpl Impl>
+static void RangeImplTest()
+{
+	std::u8string  invalid8 = u8"\x80\x80";
+	std::u16string invalid16;
+	std::u32string invalid32;
+	for (size_t i = 0; i < 300; ++i)
+	{
+		invalid8.append(u8"a\u00E9\u4E2D\U0001F600\xFF\x80\xF8\xED\xA0\x80\xC0\x80");
+		invalid8.append(i % 7, u8'b');
+		invalid16.append(u"a\u00E9\u4E2D\U0001F600\xDC00\xD800");
+		invalid16.append(i % 7, u'b');
+		invalid32.append(U"a\u00E9\u4E2D\U0001F600\xDFFF");
+		invalid32.push_back(static_cast<char32_t>(0x11'0000 + i * 0x10'0001));
+	}
+
+	RangeTest<char8_t, Impl>(std::u8string_view {});
+	RangeTest<char8_t, Impl>(std::u8string_view { reinterpret_cast<const char8_t*>(c_U8Str), sizeof(c_U8Str) - 1 });
+	RangeTest<char16_t, Impl>(std::u16string_view { reinterpret_cast<const char16_t*>(c_U16Str), sizeof(c_U16Str) / 2 - 1 });
+	RangeTest<char32_t, Impl>(std::u32string_view { reinterpret_cast<const char32_t*>(c_U32Str), sizeof(c_U32Str) / 4 - 1 });
+	RangeTest<char8_t, Impl>(invalid8);
+	RangeTest<char16_t, Impl>(invalid16);
+	RangeTest<char32_t, Impl>(invalid32);
+
+	// The views work on strings and on anything else that holds codepoints
+	std::vector<char32_t> codepoints { U'a', U'\u00E9', U'\U0001F600' };
+	Testing::Expect(std::ranges::equal(UTF::Codepoints(std::u8string { u8"a\u00E9\U0001F600" }, Impl), codepoints));
+	Testing::Expect(std::ranges::equal(UTF::Encode<UTF::EEncoding::UTF8>(codepoints, Impl), std::u8string_view { u8"a\u00E9\U0001F600" }));
+	Testing::Expect(std::ranges::equal(UTF::Encode<UTF::EEncoding::UTF16>(std::u32string_view { U"a\xD800\xDFFF" }, Impl), std::u16string_view { u"a\xFFFD\xFFFD" }));
+}
+
+template <UTF::EImpl Impl>
+static void HashImplTest()
+{
+	// Long enough to be decoded in several chunks, the substrings move the chunk boundaries and leave partial stripes
+	std::u32string text32;
+	for (size_t i = 0; i < 3000; ++i)
+		text32.append(U"a\u00E9\u4E2D\U0001F600 ");
+	std::u8string  text8  = UTF::Convert<char8_t, char32_t>(text32);
+	std::u16string text16 = UTF::Convert<char16_t, char32_t>(text32);
+	for (size_t size : { size_t { 0 }, size_t { 1 }, size_t { 15 }, size_t { 16 }, size_t { 17 }, size_t { 1000 }, size_t { 4099 }, text32.size() })
+	{
+		std::u32string_view codepoints = std::u32string_view { text32 }.substr(0, size);
+		std::u8string       utf8       = UTF::Convert<char8_t, char32_t>(codepoints);
+		std::uint64_t       hash       = UTF::Hash(codepoints, Impl);
+		Testing::Expect(UTF::Hash(std::u8string_view { utf8 }, Impl) == hash);
+		Testing::Expect(UTF::Hash(std::u8string_view { utf8 }, UTF::EImpl::Generic) == hash);
+		Testing::Expect(UTF::Hash(std::u16string_view { UTF::Convert<char16_t, char32_t>(codepoints) }, Impl) == hash);
+	}
+	Testing::Expect(UTF::Hash<UTF::EEncoding::UTF8>(text8.data(), text8.size(), Impl) == UTF::Hash<UTF::EEncoding::UTF16>(text16.data(), text16.size() * 2, Impl));
+	Testing::Expect(UTF::Hash(std::u32string_view { U"abcdefgh\U0001F600" }, Impl) == UTF::Hash(std::u8string_view { u8"abcdefgh\U0001F600" }, Impl));
+
+	// Zeros, order and length all change the hash
+	Testing::Expect(UTF::Hash(std::u8string_view { u8"a" }, Impl) != UTF::Hash(std::u8string_view { u8"a\0", 2 }, Impl));
+	Testing::Expect(UTF::Hash(std::u8string_view { u8"ab" }, Impl) != UTF::Hash(std::u8string_view { u8"ba" }, Impl));
+	std::u8string swapped = text8.substr(100, 100) + text8.substr(0, 100);
+	Testing::Expect(UTF::Hash(std::u8string_view { text8 }.substr(0, 200), Impl) != UTF::Hash(std::u8string_view { swapped }, Impl));
+
+	// Invalid sequences hash as their replacements, runs of continuation bytes longer than a chunk included
+	std::u8string invalid8(10000, u8'\x80');
+	invalid8.append(u8"a\xF0\x9F\x98\xE2\x82\xAC\xFF");
+	Testing::Expect(UTF::Hash(std::u8string_view { invalid8 }, Impl) == UTF::Hash(std::u32string_view { UTF::Convert<char32_t, char8_t>(invalid8, Impl, UTF::EConvertPolicy::Auto, UTF::EErrorPolicy::Replace) }, Impl));
+	Testing::Expect(UTF::Hash(std::u16string_view { u"a\xD800" }, Impl) == UTF::Hash(std::u8string_view { u8"a\uFFFD" }, Impl));
+	Testing::Expect(UTF::Hash(std::u32string_view { U"a\x110000" }, Impl) == UTF::Hash(std::u8string_view { u8"a\uFFFD" }, Impl));
+}
+
+// Expects lhs and rhs to order the same in every pair of encodings, text has to be valid to convert the same in all of them
+template <UTF::EImpl Impl>
+static void CompareCheck(std::u32string_view lhs, std::u32string_view rhs, std::strong_ordering order)
+{
+	std::u8string  lhs8  = UTF::Convert<char8_t, char32_t>(lhs);
+	std::u16string lhs16 = UTF::Convert<char16_t, char32_t>(lhs);
+	std::u8string  rhs8  = UTF::Convert<char8_t, char32_t>(rhs);
+	std::u16string rhs16 = UTF::Convert<char16_t, char32_t>(rhs);
+	auto           check = [&](auto lhsView, auto rhsView) {
+		Testing::Expect(UTF::Compare(lhsView, rhsView, Impl) == order);
+		Testing::Expect(UTF::Equal(lhsView, rhsView, Impl) == (order == std::strong_ordering::equal));
+	};
+	check(std::u8string_view { lhs8 }, std::u8string_view { rhs8 });
+	check(std::u8string_view { lhs8 }, std::u16string_view { rhs16 });
+	check(std::u8string_view { lhs8 }, rhs);
+	check(std::u16string_view { lhs16 }, std::u8string_view { rhs8 });
+	check(std::u16string_view { lhs16 }, std::u16string_view { rhs16 });
+	check(std::u16string_view { lhs16 }, rhs);
+	check(lhs, std::u8string_view { rhs8 });
+	check(lhs, std::u16string_view { rhs16 });
+	check(lhs, rhs);
+}
+
+template <UTF::EImpl Impl>
+static void CompareImplTest()
+{
+	// Long enough to be decoded in several chunks, the differences sit in the ASCII run, past it and in the last chunk
+	std::u32string text;
+	for (size_t i = 0; i < 3000; ++i)
+		text.append(U"a\u00E9\u4E2D\U0001F600 ");
+	std::u32string ascii(5000, U'x');
+	for (std::u32string_view base : { std::u32string_view { text }, std::u32string_view { ascii } })
+	{
+		for (size_t size : { size_t { 0 }, size_t { 1 }, size_t { 20 }, size_t { 100 }, size_t { 4099 }, base.size() })
+		{
+			std::u32string_view prefix = base.substr(0, size);
+			CompareCheck<Impl>(prefix, prefix, std::strong_ordering::equal);
+			if (size == 0)
+				continue;
+			std::u32string changed { prefix };
+			changed.back() = U'\U0001F601';
+			CompareCheck<Impl>(prefix, changed, std::strong_ordering::less);
+			CompareCheck<Impl>(changed, prefix, std::strong_ordering::greater);
+			CompareCheck<Impl>(prefix.substr(0, size - 1), prefix, std::strong_ordering::less);
+		}
+	}
+	std::u32string early = ascii;
+	early[1000]          = U'w';
+	CompareCheck<Impl>(early, ascii, std::strong_ordering::less);
+
+	// Codepoints order past the surrogates, where UTF-16 units order the other way around
+	CompareCheck<Impl>(U"a\uFFFF", U"a\U00010000", std::strong_ordering::less);
+	CompareCheck<Impl>(U"\uE000", U"\U0010FFFF", std::strong_ordering::less);
+
+	// Invalid sequences compare as their replacements, runs of continuation bytes longer than a chunk included
+	std::u8string invalid8(10000, u8'\x80');
+	invalid8.append(u8"a\xF0\x9F\x98\xE2\x82\xAC\xFF");
+	std::u32string replaced = UTF::Convert<char32_t, char8_t>(invalid8, Impl, UTF::EConvertPolicy::Auto, UTF::EErrorPolicy::Replace);
+	Testing::Expect(UTF::Equal(std::u8string_view { invalid8 }, std::u32string_view { replaced }, Impl));
+	Testing::Expect(UTF::Equal(std::u8string_view { invalid8 }, std::u16string_view { UTF::Convert<char16_t, char32_t>(replaced) }, Impl));
+	Testing::Expect(UTF::Equal(std::u8string_view { u8"a\x80z" }, std::u8string_view { u8"a\xFFz" }, Impl));
+	Testing::Expect(UTF::Equal(std::u16string_view { u"a\xD800" }, std::u8string_view { u8"a\uFFFD" }, Impl));
+	Testing::Expect(UTF::Equal(std::u32string_view { U"a\x110000" }, std::u16string_view { u"a\uFFFD" }, Impl));
+	Testing::Expect(UTF::Compare(std::u8string_view { u8"\xE2\x82" }, std::u8string_view { u8"\xE2\x82\xAC" }, Impl) == std::strong_ordering::greater);
+	Testing::Expect(UTF::Compare<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(invalid8.data(), invalid8.size(), u"\uFFFE", 2, Impl) == std::strong_ordering::less);
+}
+
+// Latin-1 or ASCII units with the values of the codepoints in text
+template <class C>
+static std::basic_string<C> Units(std::u32string_view text)
+{
+	std::basic_string<C> units;
+	for (char32_t codepoint : text)
+		units.push_back(static_cast<C>(codepoint));
+	return units;
+}
+
+// Converts text both ways between from and every encoding it fits in, text has to be valid for the round trips
+template <UTF::EEncoding Encoding, UTF::EImpl Impl>
+static void SingleByteCheck(std::u32string_view text)
+{
+	using C = UTF::Details::CharTypeT<Encoding>;
+
+	std::basic_string<C> units  = Units<C>(text);
+	std::u8string        text8  = UTF::Convert<char8_t, char32_t>(text);
+	std::u16string       text16 = UTF::Convert<char16_t, char32_t>(text);
+	auto                 check  = [&]<UTF::EEncoding Other>(const auto& other) {
+		using O = UTF::Details::CharTypeT<Other>;
+		ConvTest<Encoding, Other, Impl>(units.data(), units.size(), other.data(), other.size() * sizeof(O));
+		ConvTest<Other, Encoding, Impl>(other.data(), other.size() * sizeof(O), units.data(), units.size());
+		RequiredSizeTest<Encoding, Other, Impl>(units.data(), units.size(), other.size() * sizeof(O));
+		RequiredSizeTest<Other, Encoding, Impl>(other.data(), other.size() * sizeof(O), units.size());
+		Testing::Expect(UTF::Length<Encoding, Other>(units.data(), units.size(), Impl) == other.size());
+		Testing::Expect(UTF::Length<Other, Encoding>(other.data(), other.size() * sizeof(O), Impl) == units.size());
+		Testing::Expect(UTF::Equal(std::basic_string_view<C> { units }, std::basic_string_view<O> { other }, Impl));
+		Testing::Expect(UTF::Hash(std::basic_string_view<C> { units }, Impl) == UTF::Hash(std::basic_string_view<O> { other }, Impl));
+	};
+	check.template operator()<UTF::EEncoding::UTF8>(text8);
+	check.template operator()<UTF::EEncoding::UTF16>(text16);
+	check.template operator()<UTF::EEncoding::UTF32>(text);
+	Testing::Expect(UTF::Validate<Encoding>(units.data(), units.size(), Impl).Valid);
+	if (!text.empty())
+	{
+		std::u32string changed { text };
+		changed.back() = U'\U0001F600';
+		Testing::Expect(UTF::Compare(std::basic_string_view<C> { units }, std::u8string_view { UTF::Convert<char8_t, char32_t>(changed) }, Impl) == std::strong_ordering::less);
+	}
+}
+
+template <UTF::EImpl Impl>
+static void SingleByteImplTest()
+{
+	// Long enough for several blocks, the runs past ASCII cross the block boundaries at every offset
+	std::u32string text;
+	for (size_t i = 0; i < 300; ++i)
+		text.append(U"ab\u00E9\u00FF xyz\u0080");
+	std::u32string ascii(2000, U'q');
+	for (size_t size : { size_t { 0 }, size_t { 1 }, size_t { 7 }, size_t { 33 }, size_t { 100 }, size_t { 2000 } })
+	{
+		SingleByteCheck<UTF::EEncoding::Latin1, Impl>(std::u32string_view { text }.substr(0, size));
+		SingleByteCheck<UTF::EEncoding::ASCII, Impl>(std::u32string_view { ascii }.substr(0, size));
+	}
+	std::basic_string<UTF::Latin1Unit> latin1     = Units<UTF::Latin1Unit>(U"a\u00E9\x7F");
+	std::basic_string<UTF::AsciiUnit>  asciiUnits = Units<UTF::AsciiUnit>(U"ab\x7F");
+	ConvTest<UTF::EEncoding::Latin1, UTF::EEncoding::ASCII, Impl>(asciiUnits.data(), 3, asciiUnits.data(), 3);
+	ConvTest<UTF::EEncoding::ASCII, UTF::EEncoding::Latin1, Impl>(asciiUnits.data(), 3, asciiUnits.data(), 3);
+	// The unit strings use the library's char traits, units order by their value
+	Testing::Expect(latin1.find(UTF::Latin1Unit { 0xE9 }) == 1 && latin1 > Units<UTF::Latin1Unit>(U"a\x7F"));
+
+	// Codepoints the target can't hold and ASCII units past 0x7F stop the conversion where they start, wherever the block boundaries are
+	for (size_t padding : { 0, 62, 2000 })
+	{
+		std::u8string                      text8(padding, u8'a');
+		std::basic_string<UTF::Latin1Unit> padded(padding, UTF::Latin1Unit { 'a' });
+		std::basic_string<UTF::AsciiUnit>  paddedAscii(padding, UTF::AsciiUnit { 'a' });
+		text8.append(u8"\u00E9\u4E2Db");
+		padded.append(latin1);
+		paddedAscii.push_back(UTF::AsciiUnit { 0x80 });
+
+		std::basic_string<UTF::Latin1Unit> output;
+		auto                               result = UTF::ConvertInto<UTF::Latin1Unit, char8_t>(text8, output, Impl);
+		Testing::Expect(result.Error == UTF::EError::OOB && result.Consumed == padding + 2 && output.empty());
+		std::basic_string<UTF::AsciiUnit> asciiOutput;
+		result = UTF::ConvertInto<UTF::AsciiUnit, UTF::Latin1Unit>(padded, asciiOutput, Impl);
+		Testing::Expect(result.Error == UTF::EError::OOB && result.Consumed == padding + 1);
+		std::u16string text16;
+		result = UTF::ConvertInto<char16_t, UTF::AsciiUnit>(paddedAscii, text16, Impl);
+		Testing::Expect(result.Error == UTF::EError::InvalidLeading && result.Consumed == padding);
+		auto validated = UTF::Validate<UTF::EEncoding::ASCII>(paddedAscii.data(), paddedAscii.size(), Impl);
+		Testing::Expect(!validated.Valid && validated.ErrorOffset == padding);
+
+		// Replace converts what the target can't hold to '?' and invalid ASCII to U+FFFD
+		std::basic_string<UTF::Latin1Unit> replaced(padding, UTF::Latin1Unit { 'a' });
+		replaced.append(Units<UTF::Latin1Unit>(U"\u00E9?b"));
+		Testing::Expect(UTF::Convert<UTF::Latin1Unit, char8_t>(text8, Impl, UTF::EConvertPolicy::Auto, UTF::EErrorPolicy::Replace) == replaced);
+		std::u8string replaced8(padding, u8'a');
+		replaced8.append(u8"\uFFFD");
+		Testing::Expect(UTF::Convert<char8_t, UTF::AsciiUnit>(paddedAscii, Impl, UTF::EConvertPolicy::Auto, UTF::EErrorPolicy::Replace) == replaced8);
+		Testing::Expect(UTF::Equal(std::basic_string_view<UTF::AsciiUnit> { paddedAscii }, std::u8string_view { replaced8 }, Impl));
+	}
+
+	// A lone low surrogate right after a block belongs to neither block, it has to stop the conversion wherever the buffer starts
+	std::u16string surrogate(32 + 128, u'a');
+	surrogate.push_back(0xDFA4);
+	surrogate.append(300, u'b');
+	for (size_t align = 0; align < 32; ++align)
+	{
+		std::u16string_view text16 = std::u16string_view { surrogate }.substr(align, 429);
+		for (auto policy : { UTF::EConvertPolicy::Auto, UTF::EConvertPolicy::TwoPass })
+		{
+			std::basic_string<UTF::Latin1Unit> output;
+			auto                               result = UTF::ConvertPrefix<UTF::Latin1Unit, char16_t>(text16, output, Impl, policy);
+			Testing::Expect(result.Error == UTF::EError::InvalidLeading && result.Consumed == 160 - align);
+			std::basic_string<UTF::AsciiUnit> asciiOutput;
+			result = UTF::ConvertPrefix<UTF::AsciiUnit, char16_t>(text16, asciiOutput, Impl, policy);
+			Testing::Expect(result.Error == UTF::EError::InvalidLeading && result.Consumed == 160 - align);
+		}
+		std::basic_string<UTF::Latin1Unit> replaced = UTF::Convert<UTF::Latin1Unit, char16_t>(text16, Impl, UTF::EConvertPolicy::Auto, UTF::EErrorPolicy::Replace);
+		Testing::Expect(replaced.size() == 429 && replaced[160 - align] == UTF::Latin1Unit { '?' });
+	}
+}
+
+// Compares every translation against counting the whole prefix, text has to be valid for the UTF-16 and codepoint offsets to be exact
+static void OffsetIndexCheck(const UTF::OffsetIndex& index, std::u8string_view text)
+{
+	Testing::Expect(index.Size(UTF::EEncoding::UTF8) == text.size());
+	Testing::Expect(index.Size(UTF::EEncoding::UTF16) == UTF::Length<char16_t>(text));
+	Testing::Expect(index.Size(UTF::EEncoding::UTF32) == UTF::CountCodepoints(text));
+	Testing::Expect(index.Size(UTF::EEncoding::Latin1) == index.Size(UTF::EEncoding::UTF32));
+	for (size_t offset = 0; offset <= text.size() + 1; offset += 31)
+	{
+		size_t start = std::min(offset, text.size());
+		while (start > 0 && start < text.size() && (text[start] & 0xC0) == 0x80)
+			--start;
+		size_t units      = UTF::Length<char16_t>(text.substr(0, start));
+		size_t codepoints = UTF::CountCodepoints(text.substr(0, start));
+		Testing::Expect(index.Translate(text, offset, UTF::EEncoding::UTF8, UTF::EEncoding::UTF16) == units);
+		Testing::Expect(index.Translate(text, offset, UTF::EEncoding::UTF8, UTF::EEncoding::UTF32) == codepoints);
+		Testing::Expect(index.Translate(text, units, UTF::EEncoding::UTF16, UTF::EEncoding::UTF8) == start);
+		Testing::Expect(index.Translate(text, codepoints, UTF::EEncoding::UTF32, UTF::EEncoding::UTF8) == start);
+		Testing::Expect(index.Translate(text, codepoints, UTF::EEncoding::UTF32, UTF::EEncoding::UTF16) == units);
+		Testing::Expect(index.Translate(text, offset, UTF::EEncoding::UTF8, UTF::EEncoding::ASCII) == codepoints);
+		Testing::Expect(index.Translate(text, codepoints, UTF::EEncoding::Latin1, UTF::EEncoding::UTF8) == start);
+	}
+}
+
+template <UTF::EImpl Impl>
+static void OffsetIndexTest()
+{
+	// Every repetition is 10 bytes, 5 UTF-16 units and 4 codepoints
+	std::u8string text;
+	for (size_t i = 0; i < 3000; ++i)
+		text.append(u8"a\u00E9\u4E2D\U0001F600");
+
+	for (size_t sampleSize : { size_t { 64 }, UTF::c_OffsetSampleSize })
+	{
+		std::u8string    edited = text;
+		UTF::OffsetIndex index(sampleSize, Impl);
+		OffsetIndexCheck(index, std::u8string_view {});
+		index.Build(edited);
+		OffsetIndexCheck(index, edited);
+
+		// An offset in the middle of a surrogate pair moves back to its start
+		Testing::Expect(index.Translate(edited, 4, UTF::EEncoding::UTF16, UTF::EEncoding::UTF8) == 6);
+		Testing::Expect(index.Translate(edited, 4, UTF::EEncoding::UTF16, UTF::EEncoding::UTF16) == 3);
+
+		// Edits inside a sample, across many of them and at both ends, moved back to sequence boundaries to keep the text valid
+		std::tuple<size_t, size_t, std::u8string_view> edits[] = {
+			{ 1234, 40, u8"\U0001F600\U0001F600xyz" },
+			{ 3001, 0, u8"\u4E2D" },
+			{ 100, 15000, u8"" },
+			{ 0, 10, u8"\u00E9" },
+			{ 5000, 0, std::u8string_view { text }.substr(0, 20000) },
+			{ 17, 3, u8"a" }
+		};
+		for (auto [offset, removed, inserted] : edits)
+		{
+			size_t end = offset + removed;
+			while ((edited[offset] & 0xC0) == 0x80)
+				--offset;
+			while ((edited[end] & 0xC0) == 0x80)
+				--end;
+			removed = end - offset;
+			edited.replace(offset, removed, inserted);
+			index.Update(edited, offset, removed, inserted.size());
+			OffsetIndexCheck(index, edited);
+		}
+		index.Update(edited, edited.size(), 0, 0);
+		OffsetIndexCheck(index, edited);
+		size_t size = edited.size();
+		edited.clear();
+		index.Update(edited, 0, size, 0);
+		OffsetIndexCheck(index, edited);
+	}
 }
 
 static void RequiredSizeTests()
@@ -64,9 +880,10 @@ static void RequiredSizeTests()
 	Testing::Test("32-16")
 		.OnTest([]() { RequiredSizeTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::Generic>(c_U32Str, sizeof(c_U32Str) - 4, 144); })
 		.Time();
+	Testing::Test("Truncated").OnTest(TruncatedSizeTest<UTF::EImpl::Generic>).Time();
 	Testing::PopGroup();
 
-	if constexpr (UTF::SIMD::c_Supported)
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
 	{
 		Testing::PushGroup("SIMD");
 		Testing::Test("8-16")
@@ -90,6 +907,39 @@ static void RequiredSizeTests()
 		Testing::PopGroup();
 	}
 
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::PushGroup("AVX512");
+		Testing::Test("8-16")
+			.OnTest([]() { RequiredSizeTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U8Str, sizeof(c_U8Str) - 1, 144); })
+			.Time();
+		Testing::Test("8-32")
+			.OnTest([]() { RequiredSizeTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U8Str, sizeof(c_U8Str) - 1, 236); })
+			.Time();
+		Testing::Test("16-8")
+			.OnTest([]() { RequiredSizeTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U16Str, sizeof(c_U16Str) - 2, 145); })
+			.Time();
+		Testing::Test("16-32")
+			.OnTest([]() { RequiredSizeTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U16Str, sizeof(c_U16Str) - 2, 236); })
+			.Time();
+		Testing::Test("32-8")
+			.OnTest([]() { RequiredSizeTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U32Str, sizeof(c_U32Str) - 4, 145); })
+			.Time();
+		Testing::Test("32-16")
+			.OnTest([]() { RequiredSizeTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U32Str, sizeof(c_U32Str) - 4, 144); })
+			.Time();
+		Testing::PopGroup();
+	}
+
+	Testing::PushGroup("DFA");
+	Testing::Test("8-16")
+		.OnTest([]() { RequiredSizeTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::DFA>(c_U8Str, sizeof(c_U8Str) - 1, 144); })
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { RequiredSizeTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::DFA>(c_U8Str, sizeof(c_U8Str) - 1, 236); })
+		.Time();
+	Testing::PopGroup();
+
 	Testing::PopGroup();
 }
 
@@ -118,9 +968,10 @@ static void ConvBlockTests()
 	Testing::Test("32-16")
 		.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::Generic>(c_U32Str, 64, 64, c_U16Str, 32); })
 		.Time();
+	Testing::Test("Max Codepoint").OnTest(MaxCodepointBlockTest<UTF::EImpl::Generic>).Time();
 	Testing::PopGroup();
 
-	if constexpr (UTF::SIMD::c_Supported)
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
 	{
 		Testing::PushGroup("SIMD");
 		Testing::Test("8-16")
@@ -141,8 +992,44 @@ static void ConvBlockTests()
 		Testing::Test("32-16")
 			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::SIMD>(c_U32Str, 64, 64, c_U16Str, 32); })
 			.Time();
+		Testing::Test("Max Codepoint").OnTest(MaxCodepointBlockTest<UTF::EImpl::SIMD>).Time();
+		Testing::PopGroup();
+	}
+
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::PushGroup("AVX512");
+		Testing::Test("8-16")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U8Str, 67, 64, c_U16Str, 74); })
+			.Time();
+		Testing::Test("8-32")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U8Str, 67, 64, c_U32Str, 148); })
+			.Time();
+		Testing::Test("16-8")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U16Str, 66, 64, c_U8Str, 51); })
+			.Time();
+		Testing::Test("16-32")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U16Str, 66, 64, c_U32Str, 128); })
+			.Time();
+		Testing::Test("32-8")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U32Str, 64, 64, c_U8Str, 17); })
+			.Time();
+		Testing::Test("32-16")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U32Str, 64, 64, c_U16Str, 32); })
+			.Time();
+		Testing::Test("Max Codepoint").OnTest(MaxCodepointBlockTest<UTF::EImpl::AVX512>).Time();
 		Testing::PopGroup();
 	}
+
+	Testing::PushGroup("DFA");
+	Testing::Test("8-16")
+		.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::DFA>(c_U8Str, 67, 64, c_U16Str, 74); })
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::DFA>(c_U8Str, 67, 64, c_U32Str, 148); })
+		.Time();
+	Testing::Test("Max Codepoint").OnTest(MaxCodepointBlockTest<UTF::EImpl::DFA>).Time();
+	Testing::PopGroup();
 	Testing::PopGroup();
 
 	Testing::PushGroup("Partial");
@@ -168,7 +1055,7 @@ static void ConvBlockTests()
 		.Time();
 	Testing::PopGroup();
 
-	if constexpr (UTF::SIMD::c_Supported)
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
 	{
 		Testing::PushGroup("SIMD");
 		Testing::Test("8-16")
@@ -191,13 +1078,46 @@ static void ConvBlockTests()
 			.Time();
 		Testing::PopGroup();
 	}
-	Testing::PopGroup();
-
-	Testing::PopGroup();
-}
 
-static void ConvTests()
-{
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::PushGroup("AVX512");
+		Testing::Test("8-16")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U8Str, 13, 10, c_U16Str, 20); })
+			.Time();
+		Testing::Test("8-32")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U8Str, 13, 10, c_U32Str, 40); })
+			.Time();
+		Testing::Test("16-8")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U16Str, 12, 10, c_U8Str, 5); })
+			.Time();
+		Testing::Test("16-32")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U16Str, 12, 10, c_U32Str, 20); })
+			.Time();
+		Testing::Test("32-8")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U32Str, 10, 10, c_U8Str, 3); })
+			.Time();
+		Testing::Test("32-16")
+			.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U32Str, 10, 10, c_U16Str, 6); })
+			.Time();
+		Testing::PopGroup();
+	}
+
+	Testing::PushGroup("DFA");
+	Testing::Test("8-16")
+		.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::DFA>(c_U8Str, 13, 10, c_U16Str, 20); })
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { ConvBlockTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::DFA>(c_U8Str, 13, 10, c_U32Str, 40); })
+		.Time();
+	Testing::PopGroup();
+	Testing::PopGroup();
+
+	Testing::PopGroup();
+}
+
+static void ConvTests()
+{
 	Testing::PushGroup("Convert");
 
 	Testing::PushGroup("Generic");
@@ -227,7 +1147,7 @@ static void ConvTests()
 		.Time();
 	Testing::PopGroup();
 
-	if constexpr (UTF::SIMD::c_Supported)
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
 	{
 		Testing::PushGroup("SIMD");
 		Testing::Test("8-16")
@@ -256,24 +1176,556 @@ static void ConvTests()
 			.Time();
 		Testing::PopGroup();
 	}
+
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::PushGroup("AVX512");
+		Testing::Test("8-16")
+			.OnTest([]() { ConvTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+			.Dependencies("UTF.Convert Block.Full.AVX512.8-16", "UTF.Convert Block.Partial.AVX512.8-16")
+			.Time();
+		Testing::Test("8-32")
+			.OnTest([]() { ConvTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+			.Dependencies("UTF.Convert Block.Full.AVX512.8-32", "UTF.Convert Block.Partial.AVX512.8-32")
+			.Time();
+		Testing::Test("16-8")
+			.OnTest([]() { ConvTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U16Str, sizeof(c_U16Str), c_U8Str, sizeof(c_U8Str)); })
+			.Dependencies("UTF.Convert Block.Full.AVX512.16-8", "UTF.Convert Block.Partial.AVX512.16-8")
+			.Time();
+		Testing::Test("16-32")
+			.OnTest([]() { ConvTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U16Str, sizeof(c_U16Str), c_U32Str, sizeof(c_U32Str)); })
+			.Dependencies("UTF.Convert Block.Full.AVX512.16-32", "UTF.Convert Block.Partial.AVX512.16-32")
+			.Time();
+		Testing::Test("32-8")
+			.OnTest([]() { ConvTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U32Str, sizeof(c_U32Str), c_U8Str, sizeof(c_U8Str)); })
+			.Dependencies("UTF.Convert Block.Full.AVX512.32-8", "UTF.Convert Block.Partial.AVX512.32-8")
+			.Time();
+		Testing::Test("32-16")
+			.OnTest([]() { ConvTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U32Str, sizeof(c_U32Str), c_U16Str, sizeof(c_U16Str)); })
+			.Dependencies("UTF.Convert Block.Full.AVX512.32-16", "UTF.Convert Block.Partial.AVX512.32-16")
+			.Time();
+		Testing::PopGroup();
+	}
+
+	Testing::PushGroup("DFA");
+	Testing::Test("8-16")
+		.OnTest([]() { ConvTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::DFA>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert Block.Full.DFA.8-16", "UTF.Convert Block.Partial.DFA.8-16")
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { ConvTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::DFA>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert Block.Full.DFA.8-32", "UTF.Convert Block.Partial.DFA.8-32")
+		.Time();
+	Testing::Test("Strict")
+		.OnTest([]() {
+			StrictTest<char16_t>({ u8"\xC0\x80", u8"\xC1\xBF", u8"\xE0\x80\x80", u8"\xED\xA0\x80", u8"\xF0\x80\x80\x80", u8"\xF4\x90\x80\x80", u8"\xF5\x80\x80\x80" });
+			StrictTest<char32_t>({ u8"abc\xC0\x80", u8"abc\xED\xBF\xBF", u8"abc\xF4\x90\x80\x80" });
+		})
+		.Dependencies("UTF.Convert.DFA.8-16", "UTF.Convert.DFA.8-32");
+	Testing::PopGroup();
+
+	Testing::PushGroup("Parallel");
+	Testing::Test("8-16")
+		.OnTest([]() { ParallelConvTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert.Generic.8-16")
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { ParallelConvTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert.Generic.8-32")
+		.Time();
+	Testing::Test("16-8")
+		.OnTest([]() { ParallelConvTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8>(c_U16Str, sizeof(c_U16Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert.Generic.16-8")
+		.Time();
+	Testing::Test("16-32")
+		.OnTest([]() { ParallelConvTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32>(c_U16Str, sizeof(c_U16Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert.Generic.16-32")
+		.Time();
+	Testing::Test("32-8")
+		.OnTest([]() { ParallelConvTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8>(c_U32Str, sizeof(c_U32Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert.Generic.32-8")
+		.Time();
+	Testing::Test("32-16")
+		.OnTest([]() { ParallelConvTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16>(c_U32Str, sizeof(c_U32Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert.Generic.32-16")
+		.Time();
+	Testing::PopGroup();
+	Testing::Test("Scratch").OnTest(ScratchTest);
 	Testing::PopGroup();
 }
 
-void UTFTests()
+static void SmallTests()
 {
-	Testing::PushGroup("UTF");
+	Testing::PushGroup("Small");
+	Testing::Test("8-16")
+		.OnTest([]() { SmallConvTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert.Generic.8-16");
+	Testing::Test("8-32")
+		.OnTest([]() { SmallConvTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32>(c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert.Generic.8-32");
+	Testing::Test("16-8")
+		.OnTest([]() { SmallConvTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8>(c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert.Generic.16-8");
+	Testing::Test("16-32")
+		.OnTest([]() { SmallConvTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32>(c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert.Generic.16-32");
+	Testing::Test("32-8")
+		.OnTest([]() { SmallConvTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8>(c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert.Generic.32-8");
+	Testing::Test("32-16")
+		.OnTest([]() { SmallConvTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16>(c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert.Generic.32-16");
+	Testing::Test("Invalid")
+		.OnTest([]() {
+			SmallInvalidTest<char16_t, char8_t>({ u8"\x80", u8"a\xC3", u8"\xC3" "a", u8"abcdefgh\xE2\x82", u8"\xF8\x80\x80\x80", u8"abcdefgh\xBF" });
+			SmallInvalidTest<char8_t, char16_t>({ u"\xDC00", u"a\xD800", u"\xD800" "a", u"abcdefgh\xDFFF" });
+			SmallInvalidTest<char16_t, char32_t>({ U"\x110000", U"abc\xFFFFFFFF" });
+		});
+	Testing::PopGroup();
+}
 
-	RequiredSizeTests();
-	ConvBlockTests();
-	ConvTests();
+static void ConvIntoTests()
+{
+	Testing::PushGroup("Convert Into");
 
+	Testing::PushGroup("Generic");
+	Testing::Test("8-16")
+		.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::Generic>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert.Generic.8-16")
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::Generic>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert.Generic.8-32")
+		.Time();
+	Testing::Test("16-8")
+		.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8, UTF::EImpl::Generic>(c_U16Str, sizeof(c_U16Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert.Generic.16-8")
+		.Time();
+	Testing::Test("16-32")
+		.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32, UTF::EImpl::Generic>(c_U16Str, sizeof(c_U16Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert.Generic.16-32")
+		.Time();
+	Testing::Test("32-8")
+		.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8, UTF::EImpl::Generic>(c_U32Str, sizeof(c_U32Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert.Generic.32-8")
+		.Time();
+	Testing::Test("32-16")
+		.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::Generic>(c_U32Str, sizeof(c_U32Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert.Generic.32-16")
+		.Time();
+	Testing::PopGroup();
+
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::PushGroup("SIMD");
+		Testing::Test("8-16")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::SIMD>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+			.Dependencies("UTF.Convert.SIMD.8-16")
+			.Time();
+		Testing::Test("8-32")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::SIMD>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+			.Dependencies("UTF.Convert.SIMD.8-32")
+			.Time();
+		Testing::Test("16-8")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8, UTF::EImpl::SIMD>(c_U16Str, sizeof(c_U16Str), c_U8Str, sizeof(c_U8Str)); })
+			.Dependencies("UTF.Convert.SIMD.16-8")
+			.Time();
+		Testing::Test("16-32")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32, UTF::EImpl::SIMD>(c_U16Str, sizeof(c_U16Str), c_U32Str, sizeof(c_U32Str)); })
+			.Dependencies("UTF.Convert.SIMD.16-32")
+			.Time();
+		Testing::Test("32-8")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8, UTF::EImpl::SIMD>(c_U32Str, sizeof(c_U32Str), c_U8Str, sizeof(c_U8Str)); })
+			.Dependencies("UTF.Convert.SIMD.32-8")
+			.Time();
+		Testing::Test("32-16")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::SIMD>(c_U32Str, sizeof(c_U32Str), c_U16Str, sizeof(c_U16Str)); })
+			.Dependencies("UTF.Convert.SIMD.32-16")
+			.Time();
+		Testing::PopGroup();
+	}
+
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::PushGroup("AVX512");
+		Testing::Test("8-16")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+			.Dependencies("UTF.Convert.AVX512.8-16")
+			.Time();
+		Testing::Test("8-32")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+			.Dependencies("UTF.Convert.AVX512.8-32")
+			.Time();
+		Testing::Test("16-8")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U16Str, sizeof(c_U16Str), c_U8Str, sizeof(c_U8Str)); })
+			.Dependencies("UTF.Convert.AVX512.16-8")
+			.Time();
+		Testing::Test("16-32")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32, UTF::EImpl::AVX512>(c_U16Str, sizeof(c_U16Str), c_U32Str, sizeof(c_U32Str)); })
+			.Dependencies("UTF.Convert.AVX512.16-32")
+			.Time();
+		Testing::Test("32-8")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8, UTF::EImpl::AVX512>(c_U32Str, sizeof(c_U32Str), c_U8Str, sizeof(c_U8Str)); })
+			.Dependencies("UTF.Convert.AVX512.32-8")
+			.Time();
+		Testing::Test("32-16")
+			.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16, UTF::EImpl::AVX512>(c_U32Str, sizeof(c_U32Str), c_U16Str, sizeof(c_U16Str)); })
+			.Dependencies("UTF.Convert.AVX512.32-16")
+			.Time();
+		Testing::PopGroup();
+	}
+
+	Testing::PushGroup("DFA");
+	Testing::Test("8-16")
+		.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16, UTF::EImpl::DFA>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert.DFA.8-16")
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { ConvIntoTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32, UTF::EImpl::DFA>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert.DFA.8-32")
+		.Time();
+	Testing::PopGroup();
 	Testing::PopGroup();
 }
 
-#else
+static void TranscoderTests()
+{
+	Testing::PushGroup("Transcoder");
+	Testing::Test("8-16")
+		.OnTest([]() { TranscoderTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert Into.Generic.8-16")
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { TranscoderTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert Into.Generic.8-32")
+		.Time();
+	Testing::Test("16-8")
+		.OnTest([]() { TranscoderTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8>(c_U16Str, sizeof(c_U16Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert Into.Generic.16-8")
+		.Time();
+	Testing::Test("16-32")
+		.OnTest([]() { TranscoderTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32>(c_U16Str, sizeof(c_U16Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert Into.Generic.16-32")
+		.Time();
+	Testing::Test("32-8")
+		.OnTest([]() { TranscoderTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8>(c_U32Str, sizeof(c_U32Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert Into.Generic.32-8")
+		.Time();
+	Testing::Test("32-16")
+		.OnTest([]() { TranscoderTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16>(c_U32Str, sizeof(c_U32Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert Into.Generic.32-16")
+		.Time();
+	Testing::PopGroup();
+}
 
-void UTFTests()
+static void BatchTests()
 {
+	Testing::PushGroup("Batch");
+	Testing::Test("8-16")
+		.OnTest([]() { BatchTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert.Generic.8-16")
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { BatchTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert.Generic.8-32")
+		.Time();
+	Testing::Test("16-8")
+		.OnTest([]() { BatchTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8>(c_U16Str, sizeof(c_U16Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert.Generic.16-8")
+		.Time();
+	Testing::Test("16-32")
+		.OnTest([]() { BatchTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32>(c_U16Str, sizeof(c_U16Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert.Generic.16-32")
+		.Time();
+	Testing::Test("32-8")
+		.OnTest([]() { BatchTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8>(c_U32Str, sizeof(c_U32Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert.Generic.32-8")
+		.Time();
+	Testing::Test("32-16")
+		.OnTest([]() { BatchTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16>(c_U32Str, sizeof(c_U32Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert.Generic.32-16")
+		.Time();
+	Testing::Test("Invalid")
+		.OnTest(BatchInvalidTest)
+		.Dependencies("UTF.Batch.8-16");
+	Testing::PopGroup();
+}
+
+static void ConvFileTests()
+{
+#if BUILD_IS_SYSTEM_WINDOWS || BUILD_IS_SYSTEM_UNIX
+	Testing::PushGroup("Convert File");
+	Testing::Test("8-16")
+		.OnTest([]() { ConvFileTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF16>(c_U8Str, sizeof(c_U8Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert Into.Generic.8-16")
+		.Time();
+	Testing::Test("8-32")
+		.OnTest([]() { ConvFileTest<UTF::EEncoding::UTF8, UTF::EEncoding::UTF32>(c_U8Str, sizeof(c_U8Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert Into.Generic.8-32")
+		.Time();
+	Testing::Test("16-8")
+		.OnTest([]() { ConvFileTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF8>(c_U16Str, sizeof(c_U16Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert Into.Generic.16-8")
+		.Time();
+	Testing::Test("16-32")
+		.OnTest([]() { ConvFileTest<UTF::EEncoding::UTF16, UTF::EEncoding::UTF32>(c_U16Str, sizeof(c_U16Str), c_U32Str, sizeof(c_U32Str)); })
+		.Dependencies("UTF.Convert Into.Generic.16-32")
+		.Time();
+	Testing::Test("32-8")
+		.OnTest([]() { ConvFileTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF8>(c_U32Str, sizeof(c_U32Str), c_U8Str, sizeof(c_U8Str)); })
+		.Dependencies("UTF.Convert Into.Generic.32-8")
+		.Time();
+	Testing::Test("32-16")
+		.OnTest([]() { ConvFileTest<UTF::EEncoding::UTF32, UTF::EEncoding::UTF16>(c_U32Str, sizeof(c_U32Str), c_U16Str, sizeof(c_U16Str)); })
+		.Dependencies("UTF.Convert Into.Generic.32-16")
+		.Time();
+	Testing::Test("Latin1-8")
+		.OnTest([]() { ConvFileTest<UTF::EEncoding::Latin1, UTF::EEncoding::UTF8>("\x7F\xE9\xFF\x80", 4, "\x7F\xC3\xA9\xC3\xBF\xC2\x80", 7); })
+		.Dependencies("UTF.Single Byte.Generic")
+		.Time();
+	Testing::Test("8-Latin1")
+		.OnTest([]() { ConvFileTest<UTF::EEncoding::UTF8, UTF::EEncoding::Latin1>("\x7F\xC3\xA9\xC3\xBF\xC2\x80", 7, "\x7F\xE9\xFF\x80", 4); })
+		.Dependencies("UTF.Single Byte.Generic")
+		.Time();
+	Testing::Test("Errors").OnTest(ConvFileErrorTest);
+	Testing::PopGroup();
+#endif
+}
+
+static void ValidateTests()
+{
+	Testing::PushGroup("Validate");
+	Testing::Test("Generic")
+		.OnTest(ValidateImplTest<UTF::EImpl::Generic>)
+		.Time();
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::Test("SIMD")
+			.OnTest(ValidateImplTest<UTF::EImpl::SIMD>)
+			.Time();
+	}
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::Test("AVX512")
+			.OnTest(ValidateImplTest<UTF::EImpl::AVX512>)
+			.Time();
+	}
+	Testing::Test("DFA")
+		.OnTest(ValidateImplTest<UTF::EImpl::DFA>)
+		.Time();
+	Testing::PopGroup();
 }
 
-#endif
\ No newline at end of file
+static void ReplaceTests()
+{
+	Testing::PushGroup("Replace");
+	Testing::Test("Generic")
+		.OnTest(ReplaceImplTest<UTF::EImpl::Generic>)
+		.Time();
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::Test("SIMD")
+			.OnTest(ReplaceImplTest<UTF::EImpl::SIMD>)
+			.Time();
+	}
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::Test("AVX512")
+			.OnTest(ReplaceImplTest<UTF::EImpl::AVX512>)
+			.Time();
+	}
+	Testing::Test("DFA")
+		.OnTest(ReplaceImplTest<UTF::EImpl::DFA>)
+		.Time();
+	Testing::PopGroup();
+}
+
+static void PrefixTests()
+{
+	Testing::PushGroup("Prefix");
+	Testing::Test("Generic")
+		.OnTest(PrefixImplTest<UTF::EImpl::Generic>)
+		.Time();
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::Test("SIMD")
+			.OnTest(PrefixImplTest<UTF::EImpl::SIMD>)
+			.Time();
+	}
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::Test("AVX512")
+			.OnTest(PrefixImplTest<UTF::EImpl::AVX512>)
+			.Time();
+	}
+	Testing::Test("DFA")
+		.OnTest(PrefixImplTest<UTF::EImpl::DFA>)
+		.Time();
+	Testing::PopGroup();
+}
+
+static void LengthTests()
+{
+	Testing::PushGroup("Length");
+	Testing::Test("Generic")
+		.OnTest(LengthImplTest<UTF::EImpl::Generic>)
+		.Time();
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::Test("SIMD")
+			.OnTest(LengthImplTest<UTF::EImpl::SIMD>)
+			.Time();
+	}
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::Test("AVX512")
+			.OnTest(LengthImplTest<UTF::EImpl::AVX512>)
+			.Time();
+	}
+	Testing::Test("DFA")
+		.OnTest(LengthImplTest<UTF::EImpl::DFA>)
+		.Time();
+	Testing::PopGroup();
+}
+
+static void OffsetIndexTests()
+{
+	Testing::PushGroup("Offset Index");
+	Testing::Test("Generic")
+		.OnTest(OffsetIndexTest<UTF::EImpl::Generic>)
+		.Time();
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::Test("SIMD")
+			.OnTest(OffsetIndexTest<UTF::EImpl::SIMD>)
+			.Time();
+	}
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::Test("AVX512")
+			.OnTest(OffsetIndexTest<UTF::EImpl::AVX512>)
+			.Time();
+	}
+	Testing::PopGroup();
+}
+
+static void RangeTests()
+{
+	Testing::PushGroup("Range");
+	Testing::Test("Generic")
+		.OnTest(RangeImplTest<UTF::EImpl::Generic>)
+		.Time();
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::Test("SIMD")
+			.OnTest(RangeImplTest<UTF::EImpl::SIMD>)
+			.Time();
+	}
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::Test("AVX512")
+			.OnTest(RangeImplTest<UTF::EImpl::AVX512>)
+			.Time();
+	}
+	Testing::Test("DFA")
+		.OnTest(RangeImplTest<UTF::EImpl::DFA>)
+		.Time();
+	Testing::PopGroup();
+}
+
+static void HashTests()
+{
+	Testing::PushGroup("Hash");
+	Testing::Test("Generic")
+		.OnTest(HashImplTest<UTF::EImpl::Generic>)
+		.Time();
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::Test("SIMD")
+			.OnTest(HashImplTest<UTF::EImpl::SIMD>)
+			.Time();
+	}
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::Test("AVX512")
+			.OnTest(HashImplTest<UTF::EImpl::AVX512>)
+			.Time();
+	}
+	Testing::Test("DFA")
+		.OnTest(HashImplTest<UTF::EImpl::DFA>)
+		.Time();
+	Testing::PopGroup();
+}
+
+static void CompareTests()
+{
+	Testing::PushGroup("Compare");
+	Testing::Test("Generic")
+		.OnTest(CompareImplTest<UTF::EImpl::Generic>)
+		.Time();
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::Test("SIMD")
+			.OnTest(CompareImplTest<UTF::EImpl::SIMD>)
+			.Time();
+	}
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::Test("AVX512")
+			.OnTest(CompareImplTest<UTF::EImpl::AVX512>)
+			.Time();
+	}
+	Testing::Test("DFA")
+		.OnTest(CompareImplTest<UTF::EImpl::DFA>)
+		.Time();
+	Testing::PopGroup();
+}
+
+static void SingleByteTests()
+{
+	Testing::PushGroup("Single Byte");
+	Testing::Test("Generic")
+		.OnTest(SingleByteImplTest<UTF::EImpl::Generic>)
+		.Time();
+	if (ImplDetected(UTF::EImpl::SIMD, "SIMD"))
+	{
+		Testing::Test("SIMD")
+			.OnTest(SingleByteImplTest<UTF::EImpl::SIMD>)
+			.Time();
+	}
+	if (ImplDetected(UTF::EImpl::AVX512, "AVX512"))
+	{
+		Testing::Test("AVX512")
+			.OnTest(SingleByteImplTest<UTF::EImpl::AVX512>)
+			.Time();
+	}
+	Testing::Test("DFA")
+		.OnTest(SingleByteImplTest<UTF::EImpl::DFA>)
+		.Time();
+	Testing::PopGroup();
+}
+
+void UTFTests()
+{
+	Testing::PushGroup("UTF");
+
+	RequiredSizeTests();
+	ConvBlockTests();
+	ConvTests();
+	SmallTests();
+	ConvIntoTests();
+	TranscoderTests();
+	BatchTests();
+	ConvFileTests();
+	ValidateTests();
+	ReplaceTests();
+	PrefixTests();
+	LengthTests();
+	OffsetIndexTests();
+	RangeTests();
+	HashTests();
+	CompareTests();
+	SingleByteTests();
+
+	Testing::PopGroup();
+}
\ No newline at end of file